@@ -0,0 +1,269 @@
+#pragma once
+
+/*
+    Name: atomic.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+#include <type_traits>
+
+#ifdef CML_HOST
+#include <atomic>
+#endif // CML_HOST
+
+//cml
+#include <cml/Non_copyable.hpp>
+
+namespace cml {
+
+enum class Memory_order
+{
+    relaxed,
+    acquire,
+    release,
+    acq_rel,
+    seq_cst
+};
+
+//
+// Integer or pointer shared between interrupts and thread context (up to the word size).
+// Cortex-M4: read-modify-write operations are LDREX/STREX loops (GCC __atomic builtins), no interrupt is held off.
+// Cortex-M0+: no exclusive access instructions - load and store follow the requested order (GCC __atomic builtins,
+// DMB for acquire / release / seq_cst), read-modify-write runs in a few instructions long PRIMASK section whatever
+// the requested order. The section is a compiler barrier only, no DMB: on the in-order core it is sequentially
+// consistent against interrupts, but gives no ordering against other bus masters (DMA) - add __DMB() for those.
+// Host: std::atomic.
+//
+template<typename Type_t>
+class atomic : private Non_copyable
+{
+public:
+
+    static_assert(true == std::is_integral<Type_t>::value || true == std::is_pointer<Type_t>::value);
+    static_assert(sizeof(Type_t) <= sizeof(uintptr_t));
+
+public:
+
+    constexpr atomic()
+        : value(Type_t())
+    {}
+
+    constexpr explicit atomic(Type_t a_value)
+        : value(a_value)
+    {}
+
+    ~atomic() = default;
+
+    Type_t load(Memory_order a_order = Memory_order::seq_cst) const
+    {
+#ifdef CML_HOST
+        return this->value.load(to_std(a_order));
+#else
+        return __atomic_load_n(&(this->value), to_gcc(a_order));
+#endif // CML_HOST
+    }
+
+    void store(Type_t a_value, Memory_order a_order = Memory_order::seq_cst)
+    {
+#ifdef CML_HOST
+        this->value.store(a_value, to_std(a_order));
+#else
+        __atomic_store_n(&(this->value), a_value, to_gcc(a_order));
+#endif // CML_HOST
+    }
+
+    Type_t exchange(Type_t a_value, Memory_order a_order = Memory_order::seq_cst)
+    {
+#if defined(CML_HOST)
+        return this->value.exchange(a_value, to_std(a_order));
+#elif defined(STM32L011xx)
+        (void)a_order;
+
+        Primask_section section;
+
+        const Type_t ret = this->value;
+        this->value      = a_value;
+
+        return ret;
+#else
+        return __atomic_exchange_n(&(this->value), a_value, to_gcc(a_order));
+#endif
+    }
+
+    //
+    // Stores 'a_desired' when the value equals '*a_p_expected', otherwise loads the value to '*a_p_expected'.
+    // Never fails spuriously.
+    //
+    bool compare_exchange(Type_t* a_p_expected, Type_t a_desired, Memory_order a_order = Memory_order::seq_cst)
+    {
+#if defined(CML_HOST)
+        return this->value.compare_exchange_strong(*a_p_expected, a_desired, to_std(a_order));
+#elif defined(STM32L011xx)
+        (void)a_order;
+
+        Primask_section section;
+
+        if (*a_p_expected == this->value)
+        {
+            this->value = a_desired;
+            return true;
+        }
+
+        *a_p_expected = this->value;
+        return false;
+#else
+        return __atomic_compare_exchange_n(&(this->value),
+                                           a_p_expected,
+                                           a_desired,
+                                           false,
+                                           to_gcc(a_order),
+                                           to_gcc_failure(a_order));
+#endif
+    }
+
+    Type_t fetch_add(Type_t a_value, Memory_order a_order = Memory_order::seq_cst)
+    {
+        static_assert(true == std::is_integral<Type_t>::value);
+
+#if defined(CML_HOST)
+        return this->value.fetch_add(a_value, to_std(a_order));
+#elif defined(STM32L011xx)
+        (void)a_order;
+
+        Primask_section section;
+
+        const Type_t ret = this->value;
+        this->value      = ret + a_value;
+
+        return ret;
+#else
+        return __atomic_fetch_add(&(this->value), a_value, to_gcc(a_order));
+#endif
+    }
+
+    Type_t fetch_sub(Type_t a_value, Memory_order a_order = Memory_order::seq_cst)
+    {
+        static_assert(true == std::is_integral<Type_t>::value);
+
+#if defined(CML_HOST)
+        return this->value.fetch_sub(a_value, to_std(a_order));
+#elif defined(STM32L011xx)
+        (void)a_order;
+
+        Primask_section section;
+
+        const Type_t ret = this->value;
+        this->value      = ret - a_value;
+
+        return ret;
+#else
+        return __atomic_fetch_sub(&(this->value), a_value, to_gcc(a_order));
+#endif
+    }
+
+    Type_t fetch_or(Type_t a_value, Memory_order a_order = Memory_order::seq_cst)
+    {
+        static_assert(true == std::is_integral<Type_t>::value);
+
+#if defined(CML_HOST)
+        return this->value.fetch_or(a_value, to_std(a_order));
+#elif defined(STM32L011xx)
+        (void)a_order;
+
+        Primask_section section;
+
+        const Type_t ret = this->value;
+        this->value      = ret | a_value;
+
+        return ret;
+#else
+        return __atomic_fetch_or(&(this->value), a_value, to_gcc(a_order));
+#endif
+    }
+
+    Type_t fetch_and(Type_t a_value, Memory_order a_order = Memory_order::seq_cst)
+    {
+        static_assert(true == std::is_integral<Type_t>::value);
+
+#if defined(CML_HOST)
+        return this->value.fetch_and(a_value, to_std(a_order));
+#elif defined(STM32L011xx)
+        (void)a_order;
+
+        Primask_section section;
+
+        const Type_t ret = this->value;
+        this->value      = ret & a_value;
+
+        return ret;
+#else
+        return __atomic_fetch_and(&(this->value), a_value, to_gcc(a_order));
+#endif
+    }
+
+private:
+
+#ifdef STM32L011xx
+    //
+    // Inline on purpose - Interrupt_guard is a call away and this is on every read-modify-write.
+    //
+    struct Primask_section
+    {
+        Primask_section()
+        {
+            __asm__ __volatile__("mrs %0, primask \n"
+                                 "cpsid i         \n"
+                                 : "=r" (this->primask) : : "memory");
+        }
+
+        ~Primask_section()
+        {
+            __asm__ __volatile__("msr primask, %0" : : "r" (this->primask) : "memory");
+        }
+
+        uint32_t primask;
+    };
+#endif // STM32L011xx
+
+#ifdef CML_HOST
+    static constexpr std::memory_order to_std(Memory_order a_order)
+    {
+        return Memory_order::relaxed == a_order ? std::memory_order_relaxed :
+               Memory_order::acquire == a_order ? std::memory_order_acquire :
+               Memory_order::release == a_order ? std::memory_order_release :
+               Memory_order::acq_rel == a_order ? std::memory_order_acq_rel :
+                                                  std::memory_order_seq_cst;
+    }
+#else
+    static constexpr int to_gcc(Memory_order a_order)
+    {
+        return Memory_order::relaxed == a_order ? __ATOMIC_RELAXED :
+               Memory_order::acquire == a_order ? __ATOMIC_ACQUIRE :
+               Memory_order::release == a_order ? __ATOMIC_RELEASE :
+               Memory_order::acq_rel == a_order ? __ATOMIC_ACQ_REL :
+                                                  __ATOMIC_SEQ_CST;
+    }
+
+    // a failed compare-exchange is only a load - it cannot have release semantics
+    static constexpr int to_gcc_failure(Memory_order a_order)
+    {
+        return Memory_order::release == a_order ? __ATOMIC_RELAXED :
+               Memory_order::acq_rel == a_order ? __ATOMIC_ACQUIRE :
+                                                  to_gcc(a_order);
+    }
+#endif // CML_HOST
+
+private:
+
+#ifdef CML_HOST
+    std::atomic<Type_t> value;
+#else
+    volatile Type_t value;
+#endif // CML_HOST
+};
+
+} // namespace cml
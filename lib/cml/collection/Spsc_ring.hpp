@@ -0,0 +1,170 @@
+#pragma once
+
+/*
+    Name: Spsc_ring.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace cml {
+namespace collection {
+
+//
+// Single-producer / single-consumer ring, safe to share between an interrupt and thread context without
+// any interrupt guard. 'head' is written only by the producer (push), 'tail' only by the consumer (pop).
+// Both indices run freely and are masked on access, so capacity has to be a power of two and the whole
+// buffer is usable.
+//
+template<typename Type_t>
+class Spsc_ring
+{
+public:
+
+    Spsc_ring(Type_t* a_p_buffer, uint32_t a_capacity)
+        : p_buffer(a_p_buffer)
+        , capacity(a_capacity)
+        , mask(a_capacity - 1u)
+        , head(0)
+        , tail(0)
+    {
+        assert(nullptr != a_p_buffer);
+        assert(0 != a_capacity);
+        assert(0 == (a_capacity & (a_capacity - 1u)));
+    }
+
+    Spsc_ring()                 = delete;
+    Spsc_ring(Spsc_ring&&)      = delete;
+    Spsc_ring(const Spsc_ring&) = delete;
+    ~Spsc_ring()                = default;
+
+    Spsc_ring& operator = (Spsc_ring&&)      = delete;
+    Spsc_ring& operator = (const Spsc_ring&) = delete;
+
+    bool push(const Type_t& a_data)
+    {
+        const uint32_t head = this->head;
+        bool add_new = head - load_acquire(&(this->tail)) < this->capacity;
+
+        if (true == add_new)
+        {
+            this->p_buffer[head & this->mask] = a_data;
+            store_release(&(this->head), head + 1u);
+        }
+
+        return add_new;
+    }
+
+    uint32_t push(const Type_t* a_p_data, uint32_t a_count)
+    {
+        assert(nullptr != a_p_data);
+
+        const uint32_t head = this->head;
+        const uint32_t space = this->capacity - (head - load_acquire(&(this->tail)));
+        const uint32_t count = a_count < space ? a_count : space;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            this->p_buffer[(head + i) & this->mask] = a_p_data[i];
+        }
+
+        store_release(&(this->head), head + count);
+
+        return count;
+    }
+
+    bool pop(Type_t* a_p_out)
+    {
+        assert(nullptr != a_p_out);
+
+        const uint32_t tail = this->tail;
+        bool available = load_acquire(&(this->head)) != tail;
+
+        if (true == available)
+        {
+            (*a_p_out) = this->p_buffer[tail & this->mask];
+            store_release(&(this->tail), tail + 1u);
+        }
+
+        return available;
+    }
+
+    uint32_t pop(Type_t* a_p_out, uint32_t a_count)
+    {
+        assert(nullptr != a_p_out);
+
+        const uint32_t tail   = this->tail;
+        const uint32_t length = load_acquire(&(this->head)) - tail;
+        const uint32_t count  = a_count < length ? a_count : length;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            a_p_out[i] = this->p_buffer[(tail + i) & this->mask];
+        }
+
+        store_release(&(this->tail), tail + count);
+
+        return count;
+    }
+
+    void clear()
+    {
+        store_release(&(this->tail), load_acquire(&(this->head)));
+    }
+
+    bool is_empty() const
+    {
+        return 0 == this->get_length();
+    }
+
+    bool is_full() const
+    {
+        return this->capacity == this->get_length();
+    }
+
+    uint32_t get_length() const
+    {
+        return load_acquire(&(this->head)) - load_acquire(&(this->tail));
+    }
+
+    uint32_t get_free_space() const
+    {
+        return this->capacity - this->get_length();
+    }
+
+    uint32_t get_capacity() const
+    {
+        return this->capacity;
+    }
+
+private:
+
+    static uint32_t load_acquire(const volatile uint32_t* a_p_index)
+    {
+        return __atomic_load_n(a_p_index, __ATOMIC_ACQUIRE);
+    }
+
+    static void store_release(volatile uint32_t* a_p_index, uint32_t a_value)
+    {
+        __atomic_store_n(a_p_index, a_value, __ATOMIC_RELEASE);
+    }
+
+private:
+
+    Type_t* p_buffer;
+
+    const uint32_t capacity;
+    const uint32_t mask;
+
+    volatile uint32_t head;
+    volatile uint32_t tail;
+};
+
+} // namespace collection
+} // namespace cml
@@ -53,50 +53,156 @@ uint32_t cstring::join(char* a_p_destination,
     return i;
 }
 
-uint32_t cstring::format_raw(Buffer* a_p_destinaition_buffer,
-                             Buffer* a_p_number_buffer,
-                             const char* a_p_format,
-                             const Argument* a_p_argv,
-                             uint32_t a_argc)
+uint32_t cstring::from_float(float a_value, char* a_p_buffer, uint32_t a_buffer_capacity, uint32_t a_precision)
 {
+    assert(nullptr != a_p_buffer);
+    assert(a_buffer_capacity > 4);
+
+    uint32_t bits = 0;
+    memory::copy(&bits, sizeof(bits), &a_value, sizeof(a_value));
+
+    const bool negative    = 0 != (bits >> 31u);
+    const uint32_t exponent = (bits >> 23u) & 0xFFu;
+    uint32_t mantissa       = bits & 0x7FFFFFu;
+
+    if (0xFFu == exponent)
+    {
+        const char* p_text = 0 != mantissa ? "nan" : (true == negative ? "-inf" : "inf");
+        return join(a_p_buffer, a_buffer_capacity, p_text, length(p_text, 4));
+    }
+
+    // value = mantissa * 2^(exponent - 150), denormals have no implicit bit and the exponent of 1
+    if (0 != exponent)
+    {
+        mantissa |= 0x800000u;
+    }
+
+    const int32_t e = static_cast<int32_t>(0 != exponent ? exponent : 1u) - 150;
+
+    if (e >= 0)
+    {
+        if (e > 40)
+        {
+            const char* p_text = true == negative ? "-ovf" : "ovf";
+            return join(a_p_buffer, a_buffer_capacity, p_text, length(p_text, 4));
+        }
+
+        return from_fraction(negative,
+                             static_cast<uint64_t>(mantissa) << static_cast<uint32_t>(e),
+                             0u,
+                             0u,
+                             a_p_buffer,
+                             a_buffer_capacity,
+                             a_precision);
+    }
+
+    const uint32_t fraction_bits = static_cast<uint32_t>(-e);
+
+    return from_fraction(negative,
+                         fraction_bits < 32u ? mantissa >> fraction_bits : 0u,
+                         fraction_bits < 32u ? mantissa & ((0x1u << fraction_bits) - 1u) : mantissa,
+                         fraction_bits,
+                         a_p_buffer,
+                         a_buffer_capacity,
+                         a_precision);
+}
+
+uint32_t cstring::from_fixed_point(int32_t a_value,
+                                   uint32_t a_fraction_bits,
+                                   char* a_p_buffer,
+                                   uint32_t a_buffer_capacity,
+                                   uint32_t a_precision)
+{
+    assert(a_fraction_bits > 0 && a_fraction_bits < 32);
+
+    const bool negative      = a_value < 0;
+    const uint32_t magnitude = true == negative ? 0u - static_cast<uint32_t>(a_value) : static_cast<uint32_t>(a_value);
+
+    return from_fraction(negative,
+                         magnitude >> a_fraction_bits,
+                         magnitude & ((0x1u << a_fraction_bits) - 1u),
+                         a_fraction_bits,
+                         a_p_buffer,
+                         a_buffer_capacity,
+                         a_precision);
+}
+
+uint32_t cstring::format_raw(const Sink& a_sink, const char* a_p_format, const Argument* a_p_argv, uint32_t a_argc)
+{
+    char number_buffer[format_number_buffer_capacity];
+
     bool argument           = false;
     uint32_t argument_index = 0;
     uint32_t length         = 0;
+    uint32_t precision      = format_default_precision;
 
-    while (*a_p_format != '\0' && length + 1 < a_p_destinaition_buffer->capacity)
+    while (*a_p_format != '\0')
     {
         if (true == argument && argument_index < a_argc)
         {
+            uint32_t number_length = 0;
+
             switch (*a_p_format)
             {
                 case 'd':
                 case 'i':
                 {
-                    uint32_t number_length = cstring::from_signed_integer(a_p_argv[argument_index++].get_int32(),
-                                                                          a_p_number_buffer->p_data,
-                                                                          a_p_number_buffer->capacity,
-                                                                          cstring::Radix::dec);
+                    number_length = cstring::from_signed_integer(a_p_argv[argument_index++].get_int32(),
+                                                                 number_buffer,
+                                                                 sizeof(number_buffer),
+                                                                 cstring::Radix::dec);
+                    argument = false;
+                }
+                break;
 
-                    length += cstring::join(a_p_destinaition_buffer->p_data + length,
-                                            a_p_destinaition_buffer->capacity - length,
-                                            a_p_number_buffer->p_data,
-                                            number_length);
+                case 'u':
+                case 'x':
+                {
+                    number_length = cstring::from_unsigned_integer(a_p_argv[argument_index++].get_uint32(),
+                                                                   number_buffer,
+                                                                   sizeof(number_buffer),
+                                                                   'u' == *a_p_format ? cstring::Radix::dec :
+                                                                                        cstring::Radix::hex);
+                    argument = false;
+                }
+                break;
+
+                case '.':
+                {
+                    precision = 0;
+
+                    while (a_p_format[1] >= '0' && a_p_format[1] <= '9')
+                    {
+                        precision = precision * 10u + (*(++a_p_format) - '0');
+                    }
+                }
+                break;
+
+                case 'f':
+                {
+                    number_length = cstring::from_float(a_p_argv[argument_index++].get_float(),
+                                                        number_buffer,
+                                                        sizeof(number_buffer),
+                                                        precision);
 
                     argument = false;
                 }
                 break;
 
-                case 'u':
+                case 'q':
                 {
-                    uint32_t number_length = cstring::from_unsigned_integer(a_p_argv[argument_index++].get_uint32(),
-                                                                            a_p_number_buffer->p_data,
-                                                                            a_p_number_buffer->capacity,
-                                                                            cstring::Radix::dec);
+                    uint32_t fraction_bits = 0;
 
-                    length += cstring::join(a_p_destinaition_buffer->p_data + length,
-                                            a_p_destinaition_buffer->capacity - length,
-                                            a_p_number_buffer->p_data,
-                                            number_length);
+                    while (a_p_format[1] >= '0' && a_p_format[1] <= '9')
+                    {
+                        fraction_bits = fraction_bits * 10u + (*(++a_p_format) - '0');
+                    }
+
+                    number_length = cstring::from_fixed_point(a_p_argv[argument_index++].get_int32(),
+                                                              0 != fraction_bits ? fraction_bits : 31u,
+                                                              number_buffer,
+                                                              sizeof(number_buffer),
+                                                              precision);
 
                     argument = false;
                 }
@@ -104,7 +210,8 @@ uint32_t cstring::format_raw(Buffer* a_p_destinaition_buffer,
 
                 case 'c':
                 {
-                    a_p_destinaition_buffer->p_data[length++] = a_p_argv[argument_index++].get_char();
+                    const char character = a_p_argv[argument_index++].get_char();
+                    length += a_sink.function(&character, 1, a_sink.p_user_data);
 
                     argument = false;
                 }
@@ -112,39 +219,133 @@ uint32_t cstring::format_raw(Buffer* a_p_destinaition_buffer,
 
                 case 's':
                 {
-                    length += cstring::join(a_p_destinaition_buffer->p_data + length,
-                                            a_p_destinaition_buffer->capacity - length,
-                                            a_p_argv[argument_index].get_cstring(),
-                                            cstring::length(a_p_argv[argument_index].get_cstring(),
-                                            a_p_destinaition_buffer->capacity - length));
+                    const char* p_string = a_p_argv[argument_index++].get_cstring();
+                    const uint32_t string_length = cstring::length(p_string);
+
+                    if (string_length > 0)
+                    {
+                        length += a_sink.function(p_string, string_length, a_sink.p_user_data);
+                    }
 
-                    argument_index++;
                     argument = false;
                 }
                 break;
 
                 case '%':
                 {
-                    a_p_destinaition_buffer->p_data[length++] = '%';
+                    length += a_sink.function("%", 1, a_sink.p_user_data);
                     argument = false;
                 }
                 break;
             }
+
+            if (number_length > 0)
+            {
+                length += a_sink.function(number_buffer, number_length, a_sink.p_user_data);
+            }
+
+            a_p_format++;
+        }
+        else if ('%' == *a_p_format)
+        {
+            // a precision belongs to its own conversion only, whatever the type
+            argument  = true;
+            precision = format_default_precision;
+            a_p_format++;
         }
         else
         {
-            argument = *a_p_format == '%';
+            // literal text goes out as one chunk up to the next conversion
+            const char* p_begin = a_p_format;
 
-            if (false == argument)
+            while ('\0' != *a_p_format && '%' != *a_p_format)
             {
-                a_p_destinaition_buffer->p_data[length++] = *a_p_format;
+                a_p_format++;
             }
+
+            length += a_sink.function(p_begin, static_cast<uint32_t>(a_p_format - p_begin), a_sink.p_user_data);
+            argument = false;
         }
+    }
+
+    return length;
+}
+
+uint32_t cstring::from_fraction(bool a_negative,
+                                uint64_t a_integer,
+                                uint64_t a_fraction,
+                                uint32_t a_fraction_bits,
+                                char* a_p_buffer,
+                                uint32_t a_buffer_capacity,
+                                uint32_t a_precision)
+{
+    static constexpr uint32_t powers_of_10[format_max_precision + 1] = { 1u,      10u,      100u,      1000u,
+                                                                         10000u,  100000u,  1000000u,  10000000u,
+                                                                         100000000u, 1000000000u };
+
+    assert(nullptr != a_p_buffer);
+
+    const uint32_t precision = a_precision < format_max_precision ? a_precision : format_max_precision;
+
+    // a_fraction < 2^24 (float) or < 2^31 (fixed-point), so the product fits in 64 bits
+    const uint64_t product = a_fraction * powers_of_10[precision];
+    uint32_t scaled        = 0;
+
+    if (a_fraction_bits > 0 && a_fraction_bits < 64)
+    {
+        const uint64_t remainder = product & ((static_cast<uint64_t>(1u) << a_fraction_bits) - 1u);
+        const uint64_t half      = static_cast<uint64_t>(1u) << (a_fraction_bits - 1u);
+
+        scaled = static_cast<uint32_t>(product >> a_fraction_bits);
+
+        // round half to even, the last printed digit is in the integer part for precision 0
+        const bool odd = 0 != ((0 == precision ? static_cast<uint32_t>(a_integer) : scaled) & 0x1u);
 
-        a_p_format++;
+        if (remainder > half || (remainder == half && true == odd))
+        {
+            scaled++;
+        }
+
+        if (scaled >= powers_of_10[precision])
+        {
+            scaled -= powers_of_10[precision];
+            a_integer++;
+        }
     }
 
-    a_p_destinaition_buffer->p_data[length] = 0;
+    uint32_t length = 0;
+
+    if (true == a_negative)
+    {
+        a_p_buffer[length++] = '-';
+    }
+
+    if (a_integer <= 0xFFFFFFFFu)
+    {
+        length += from_unsigned_integer_dec(static_cast<uint32_t>(a_integer),
+                                            a_p_buffer + length,
+                                            a_buffer_capacity - length);
+    }
+    else
+    {
+        length += from_unsigned_integer_dec(a_integer, a_p_buffer + length, a_buffer_capacity - length);
+    }
+
+    if (precision > 0)
+    {
+        assert(length + precision + 1 < a_buffer_capacity);
+
+        a_p_buffer[length++] = '.';
+
+        for (uint32_t i = precision; i > 0; i--)
+        {
+            a_p_buffer[length + i - 1] = static_cast<char>('0' + scaled % 10u);
+            scaled /= 10u;
+        }
+
+        length += precision;
+        a_p_buffer[length] = 0;
+    }
 
     return length;
 }
@@ -20,7 +20,9 @@ namespace common {
 
 struct cstring
 {
-    static constexpr uint32_t format_number_buffer_capacity = 12;
+    static constexpr uint32_t format_number_buffer_capacity = 32;
+    static constexpr uint32_t format_max_precision          = 9;
+    static constexpr uint32_t format_default_precision      = 6;
 
     enum class Radix
     {
@@ -30,6 +32,189 @@ struct cstring
         hex = 16
     };
 
+    //
+    // Destination of 'format_to': gets the output chunk by chunk (literal runs, converted numbers, strings),
+    // chunks are not null-terminated. Has the signature of the Console / Logger write string handlers.
+    //
+    struct Sink
+    {
+        using Function = uint32_t(*)(const char* a_p_data, uint32_t a_length, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    //
+    // Format string known during compilation, created with CML_FORMAT("..."). 'format' parses it at compile time,
+    // checks number and types of the arguments and emits them directly, without 'Argument' boxing.
+    //
+    template<typename String_t>
+    struct Format
+    {
+        static constexpr const char* get()
+        {
+            return String_t::get();
+        }
+
+        constexpr operator const char* () const
+        {
+            return String_t::get();
+        }
+    };
+
+    //
+    // One machine word per argument: 32-bit integers, characters, float bits or a string pointer.
+    //
+    class Argument
+    {
+    public:
+
+        enum class Type
+        {
+            unsigned_int,
+            signed_int,
+            character,
+            cstring,
+            floating,
+            unknown,
+        };
+
+        using Word = uintptr_t;
+
+    public:
+
+        Argument()  = default;
+        ~Argument() = default;
+
+        Argument(Argument&&)      = default;
+        Argument(const Argument&) = default;
+
+        Argument& operator = (Argument&&)      = default;
+        Argument& operator = (const Argument&) = default;
+
+        static_assert(sizeof(unsigned int) == sizeof(uint32_t));
+        explicit Argument(unsigned int a_value)
+            : data(a_value)
+            , type(Type::unsigned_int)
+        {}
+
+        static_assert(sizeof(signed int) == sizeof(int32_t));
+        explicit Argument(signed int a_value)
+            : data(static_cast<uint32_t>(a_value))
+            , type(Type::signed_int)
+        {}
+
+        // 'long' is 32-bit on target, on a 64-bit host it is formatted as 32-bit as well
+        explicit Argument(unsigned long int a_value)
+            : Argument(static_cast<unsigned int>(a_value))
+        {}
+
+        explicit Argument(signed long int a_value)
+            : Argument(static_cast<signed int>(a_value))
+        {}
+
+        explicit Argument(unsigned short int a_value)
+            : Argument(static_cast<unsigned int>(a_value))
+        {}
+
+        explicit Argument(signed short int a_value)
+            : Argument(static_cast<signed int>(a_value))
+        {}
+
+        explicit Argument(unsigned char a_value)
+            : Argument(static_cast<unsigned int>(a_value))
+        {}
+
+        explicit Argument(signed char a_value)
+            : data(static_cast<uint8_t>(a_value))
+            , type(Argument::Type::character)
+        {}
+
+        explicit Argument(char a_value)
+            : data(static_cast<uint8_t>(a_value))
+            , type(Argument::Type::character)
+        {}
+
+        explicit Argument(const char* a_p_value)
+            : data(reinterpret_cast<Word>(a_p_value))
+            , type(Type::cstring)
+        {}
+
+        static_assert(sizeof(float) == sizeof(uint32_t));
+        explicit Argument(float a_value)
+            : Argument(Type::floating, get_float_bits(a_value))
+        {}
+
+        explicit Argument(double a_value)
+            : Argument(static_cast<float>(a_value))
+        {}
+
+        Argument(Type a_type, Word a_raw)
+            : data(a_raw)
+            , type(a_type)
+        {}
+
+        uint32_t get_uint32() const
+        {
+            assert(this->type == Type::unsigned_int);
+            return static_cast<uint32_t>(this->data);
+        }
+
+        int32_t get_int32() const
+        {
+            assert(this->type == Type::signed_int);
+            return static_cast<int32_t>(static_cast<uint32_t>(this->data));
+        }
+
+        char get_char() const
+        {
+            assert(this->type == Type::character);
+            return static_cast<char>(this->data);
+        }
+
+        const char* get_cstring() const
+        {
+            assert(this->type == Type::cstring);
+            return reinterpret_cast<const char*>(this->data);
+        }
+
+        float get_float() const
+        {
+            assert(this->type == Type::floating);
+
+            float ret = 0.0f;
+            const uint32_t raw = static_cast<uint32_t>(this->data);
+            memory::copy(&ret, sizeof(ret), &raw, sizeof(raw));
+
+            return ret;
+        }
+
+        Word get_raw() const
+        {
+            return this->data;
+        }
+
+        Type get_type() const
+        {
+            return this->type;
+        }
+
+    private:
+
+        static uint32_t get_float_bits(float a_value)
+        {
+            uint32_t ret = 0;
+            memory::copy(&ret, sizeof(ret), &a_value, sizeof(a_value));
+
+            return ret;
+        }
+
+    private:
+
+        Word data = 0;
+        Type type = Type::unknown;
+    };
+
     static uint32_t length(const char* a_p_string, uint32_t a_max_length = numeric_traits<uint32_t>::get_max());
     static bool equals(const char* a_p_string_1, const char* a_p_string_2, uint32_t a_max_length);
 
@@ -87,29 +272,31 @@ struct cstring
     static uint32_t from_unsigned_integer(Type_t a_value, char* a_p_buffer, uint32_t a_buffer_capacity, Radix a_base)
     {
         static_assert(true == numeric_traits<Type_t>::is_unsigned);
-        assert(a_buffer_capacity > 1);
 
-        uint32_t ret = 0;
-
-        if (0 == a_value)
-        {
-            a_p_buffer[0] = '0';
-            a_p_buffer[1] = 0;
-
-            return 1;
-        }
-
-        while (0 != a_value)
+        switch (a_base)
         {
-            Type_t remainder = a_value % static_cast<Type_t>(a_base);
-            a_p_buffer[ret++] = (remainder > 9) ? (remainder - 10) + 'a' : remainder + '0';
-            a_value /= static_cast<Type_t>(a_base);
+            case Radix::dec:
+            {
+                return from_unsigned_integer_dec(a_value, a_p_buffer, a_buffer_capacity);
+            }
+
+            case Radix::hex:
+            {
+                return from_unsigned_integer_power_of_2(a_value, a_p_buffer, a_buffer_capacity, 4u);
+            }
+
+            case Radix::oct:
+            {
+                return from_unsigned_integer_power_of_2(a_value, a_p_buffer, a_buffer_capacity, 3u);
+            }
+
+            case Radix::bin:
+            {
+                return from_unsigned_integer_power_of_2(a_value, a_p_buffer, a_buffer_capacity, 1u);
+            }
         }
 
-        a_p_buffer[ret] = 0;
-        reverse(a_p_buffer, ret);
-
-        return ret;
+        return 0;
     }
 
     template<typename Type_t>
@@ -118,45 +305,166 @@ struct cstring
         static_assert(true == numeric_traits<Type_t>::is_signed);
         assert(a_buffer_capacity > 1);
 
-        uint32_t ret  = 0;
-        bool negative = a_value < 0;
+        using Unsigned_t = decltype(get_unsigned<sizeof(Type_t)>());
 
-        if (0 == a_value)
+        if (a_value >= 0)
         {
-            a_p_buffer[0] = '0';
-            a_p_buffer[1] = 0;
+            return from_unsigned_integer(static_cast<Unsigned_t>(a_value), a_p_buffer, a_buffer_capacity, a_base);
+        }
+
+        a_p_buffer[0] = '-';
+
+        return 1 + from_unsigned_integer(static_cast<Unsigned_t>(0u - static_cast<Unsigned_t>(a_value)),
+                                         a_p_buffer + 1,
+                                         a_buffer_capacity - 1,
+                                         a_base);
+    }
 
-            return 1;
+    //
+    // Decimal: digits are written right-to-left, two per step from 'decimal_digit_pairs', so there is one
+    // division per two digits and no reverse pass (on Cortex-M0+ every division is a library call).
+    //
+    template<typename Type_t>
+    static uint32_t from_unsigned_integer_dec(Type_t a_value, char* a_p_buffer, uint32_t a_buffer_capacity)
+    {
+        static_assert(true == numeric_traits<Type_t>::is_unsigned);
+        assert(nullptr != a_p_buffer);
+
+        constexpr uint32_t max_length = get_decimal_length(static_cast<Type_t>(~static_cast<Type_t>(0u)));
+
+        uint32_t length  = 1;
+        Type_t threshold = 10u;
+
+        while (length < max_length && a_value >= threshold)
+        {
+            length++;
+            threshold *= 10u;
         }
 
-        while (0 != a_value)
+        assert(length < a_buffer_capacity);
+
+        char* p_end = a_p_buffer + length;
+        (*p_end)    = 0;
+
+        while (a_value >= 100u)
         {
-            Type_t remainder = a_value % static_cast<Type_t>(a_base);
-            a_p_buffer[ret++] = (remainder > 9) ? (remainder - 10) + 'a' : remainder + '0';
-            a_value /= static_cast<Type_t>(a_base);
+            const Type_t quotient = a_value / 100u;
+            const uint32_t pair   = static_cast<uint32_t>(a_value - quotient * 100u) * 2u;
+
+            *(--p_end) = decimal_digit_pairs[pair + 1];
+            *(--p_end) = decimal_digit_pairs[pair];
+
+            a_value = quotient;
         }
 
-        if (true == negative)
+        if (a_value >= 10u)
         {
-            a_p_buffer[ret++] = '-';
+            const uint32_t pair = static_cast<uint32_t>(a_value) * 2u;
+
+            *(--p_end) = decimal_digit_pairs[pair + 1];
+            *(--p_end) = decimal_digit_pairs[pair];
         }
+        else
+        {
+            *(--p_end) = static_cast<char>('0' + a_value);
+        }
+
+        return length;
+    }
 
-        a_p_buffer[ret] = 0;
-        reverse(a_p_buffer, ret);
+    template<typename Type_t>
+    static uint32_t from_unsigned_integer_hex(Type_t a_value, char* a_p_buffer, uint32_t a_buffer_capacity)
+    {
+        return from_unsigned_integer_power_of_2(a_value, a_p_buffer, a_buffer_capacity, 4u);
+    }
 
-        return ret;
+    template<typename Type_t>
+    static uint32_t from_unsigned_integer_bin(Type_t a_value, char* a_p_buffer, uint32_t a_buffer_capacity)
+    {
+        return from_unsigned_integer_power_of_2(a_value, a_p_buffer, a_buffer_capacity, 1u);
     }
 
+    //
+    // Integer arithmetic only (no FPU / soft-float calls), 'a_precision' is clamped to 'format_max_precision'
+    // and rounding is half-to-even, as printf does. Values with magnitude of 2^64 or more are printed as "ovf".
+    //
+    static uint32_t from_float(float a_value, char* a_p_buffer, uint32_t a_buffer_capacity, uint32_t a_precision);
+
+    //
+    // Signed fixed-point with 'a_fraction_bits' fractional bits (15 for q15_t, 31 for q31_t).
+    //
+    static uint32_t from_fixed_point(int32_t a_value,
+                                     uint32_t a_fraction_bits,
+                                     char* a_p_buffer,
+                                     uint32_t a_buffer_capacity,
+                                     uint32_t a_precision);
+
     template<typename ... Types_t>
     static uint32_t format(char* a_p_buffer, uint32_t a_buffer_capacity, const char* a_p_format, Types_t ... a_params)
     {
         const Argument args[] = { Argument{a_params}... };
-        char number_buffer_data[format_number_buffer_capacity];
+        return format_arguments(a_p_buffer, a_buffer_capacity, a_p_format, args, sizeof...(a_params));
+    }
+
+    static uint32_t format_arguments(char* a_p_buffer,
+                                     uint32_t a_buffer_capacity,
+                                     const char* a_p_format,
+                                     const Argument* a_p_argv,
+                                     uint32_t a_argc)
+    {
+        assert(nullptr != a_p_buffer);
+        assert(a_buffer_capacity > 0);
+
+        Buffer_writer writer{ a_p_buffer, a_buffer_capacity, 0 };
+        format_raw({ Buffer_writer::write, &writer }, a_p_format, a_p_argv, a_argc);
 
-        Buffer destination_buffer{ a_p_buffer, a_buffer_capacity };
-        Buffer number_buffer{ number_buffer_data, sizeof(number_buffer_data) };
+        a_p_buffer[writer.length] = 0;
 
-        return format_raw(&destination_buffer, &number_buffer, a_p_format, args, sizeof...(a_params));
+        return writer.length;
+    }
+
+    //
+    // Unbounded output without staging: returns the sum of what 'a_sink' reported as written.
+    //
+    template<typename ... Types_t>
+    static uint32_t format_to(const Sink& a_sink, const char* a_p_format, Types_t ... a_params)
+    {
+        const Argument args[] = { Argument{a_params}... };
+        return format_arguments_to(a_sink, a_p_format, args, sizeof...(a_params));
+    }
+
+    static uint32_t format_arguments_to(const Sink& a_sink,
+                                        const char* a_p_format,
+                                        const Argument* a_p_argv,
+                                        uint32_t a_argc)
+    {
+        assert(nullptr != a_sink.function);
+        return format_raw(a_sink, a_p_format, a_p_argv, a_argc);
+    }
+
+    template<typename String_t, typename ... Types_t>
+    static uint32_t format(char* a_p_buffer, uint32_t a_buffer_capacity, Format<String_t>, Types_t ... a_params)
+    {
+        assert(nullptr != a_p_buffer);
+        assert(a_buffer_capacity > 0);
+
+        Buffer_writer writer{ a_p_buffer, a_buffer_capacity, 0 };
+        format_static<String_t, 0>(&writer, a_params...);
+
+        a_p_buffer[writer.length] = 0;
+
+        return writer.length;
+    }
+
+    template<typename String_t, typename ... Types_t>
+    static uint32_t format_to(const Sink& a_sink, Format<String_t>, Types_t ... a_params)
+    {
+        assert(nullptr != a_sink.function);
+
+        Sink_writer writer{ a_sink, 0 };
+        format_static<String_t, 0>(&writer, a_params...);
+
+        return writer.length;
     }
 
     cstring()               = delete;
@@ -169,152 +477,337 @@ struct cstring
 
 private:
 
-    struct Buffer
+    static constexpr char decimal_digit_pairs[] = "00010203040506070809"
+                                                  "10111213141516171819"
+                                                  "20212223242526272829"
+                                                  "30313233343536373839"
+                                                  "40414243444546474849"
+                                                  "50515253545556575859"
+                                                  "60616263646566676869"
+                                                  "70717273747576777879"
+                                                  "80818283848586878889"
+                                                  "90919293949596979899";
+
+    static constexpr char digits[] = "0123456789abcdef";
+
+    template<typename Type_t>
+    static constexpr uint32_t get_decimal_length(Type_t a_value)
     {
-        char* p_data            = nullptr;
-        const uint32_t capacity = 0;
-    };
+        uint32_t ret = 1;
 
-    class Argument
+        while (a_value >= 10u)
+        {
+            a_value /= 10u;
+            ret++;
+        }
+
+        return ret;
+    }
+
+    template<uint32_t size>
+    static constexpr auto get_unsigned()
     {
-    public:
+        if constexpr (size <= sizeof(uint32_t))
+        {
+            return uint32_t(0);
+        }
+        else
+        {
+            return uint64_t(0);
+        }
+    }
 
-        Argument()  = default;
-        ~Argument() = default;
+    template<typename Type_t>
+    static uint32_t from_unsigned_integer_power_of_2(Type_t a_value,
+                                                     char* a_p_buffer,
+                                                     uint32_t a_buffer_capacity,
+                                                     uint32_t a_digit_bits)
+    {
+        static_assert(true == numeric_traits<Type_t>::is_unsigned);
+        assert(nullptr != a_p_buffer);
 
-        Argument& operator = (Argument&&)      = delete;
-        Argument& operator = (const Argument&) = delete;
+        const uint32_t mask       = (0x1u << a_digit_bits) - 1u;
+        const uint32_t max_length = (sizeof(Type_t) * 8u + a_digit_bits - 1u) / a_digit_bits;
+        uint32_t length           = 1;
 
-        Argument(Argument&& a_other)
-            : type(a_other.type)
+        for (Type_t value = a_value >> a_digit_bits; 0u != value && length < max_length; value >>= a_digit_bits)
         {
-            memory::copy(this->data, sizeof(this->data), a_other.data, sizeof(a_other.data));
+            length++;
         }
 
-        Argument(const Argument& a_other)
-            : type(a_other.type)
+        assert(length < a_buffer_capacity);
+
+        a_p_buffer[length] = 0;
+
+        for (uint32_t i = length; i > 0; i--)
         {
-            memory::copy(this->data, sizeof(this->data), a_other.data, sizeof(a_other.data));
+            a_p_buffer[i - 1] = digits[static_cast<uint32_t>(a_value) & mask];
+            a_value >>= a_digit_bits;
         }
 
-        static_assert(sizeof(unsigned int) == sizeof(uint32_t));
-        explicit Argument(unsigned int a_value)
-            : data { static_cast<uint8_t>((a_value >> 24u) & 0xFF),
-                     static_cast<uint8_t>((a_value >> 16u) & 0xFF),
-                     static_cast<uint8_t>((a_value >> 8u)  & 0xFF),
-                     static_cast<uint8_t>((a_value >> 0u)  & 0xFF) }
-            , type(Type::unsigned_int)
-        {}
+        return length;
+    }
 
-        static_assert(sizeof(signed int) == sizeof(int32_t));
-        explicit Argument(signed int a_value)
-            : data{ static_cast<uint8_t>((a_value >> 24u) & 0xFF),
-                    static_cast<uint8_t>((a_value >> 16u) & 0xFF),
-                    static_cast<uint8_t>((a_value >> 8u)  & 0xFF),
-                    static_cast<uint8_t>((a_value >> 0u)  & 0xFF) }
-            , type(Type::signed_int)
-        {}
+    struct Buffer_writer
+    {
+        char* p_data      = nullptr;
+        uint32_t capacity = 0;
+        uint32_t length   = 0;
 
-        static_assert(sizeof(unsigned long int) == sizeof(uint32_t));
-        explicit Argument(unsigned long int a_value)
-            : Argument(static_cast<unsigned int>(a_value))
-        {}
+        void write(const char* a_p_data, uint32_t a_length)
+        {
+            for (uint32_t i = 0; i < a_length && this->length + 1 < this->capacity; i++)
+            {
+                this->p_data[this->length++] = a_p_data[i];
+            }
+        }
 
-        static_assert(sizeof(signed long int) == sizeof(int32_t));
-        explicit Argument(signed long int a_value)
-            : Argument(static_cast<signed int>(a_value))
-        {}
+        void write(char a_character)
+        {
+            if (this->length + 1 < this->capacity)
+            {
+                this->p_data[this->length++] = a_character;
+            }
+        }
 
-        static_assert(sizeof(unsigned short int) == sizeof(uint16_t));
-        explicit Argument(unsigned short int a_value)
-            : data{ 0u,
-                    0u,
-                    static_cast<uint8_t>((a_value >> 8u) & 0xFF),
-                    static_cast<uint8_t>((a_value >> 0u) & 0xFF) }
-            , type(Type::unsigned_int)
-        {}
+        static uint32_t write(const char* a_p_data, uint32_t a_length, void* a_p_user_data)
+        {
+            Buffer_writer* p_this = static_cast<Buffer_writer*>(a_p_user_data);
+            const uint32_t length = p_this->length;
 
-        static_assert(sizeof(signed short int) == sizeof(int16_t));
-        explicit Argument(signed short int a_value)
-            : data{ 0u,
-                    0u,
-                    static_cast<uint8_t>((a_value >> 8u) & 0xFF),
-                    static_cast<uint8_t>((a_value >> 0u) & 0xFF) }
-            , type(Type::signed_int)
-        {}
+            p_this->write(a_p_data, a_length);
 
-        static_assert(sizeof(unsigned char) == sizeof(uint8_t));
-        explicit Argument(unsigned char a_value)
-            : data{ 0u, 0u, 0u, a_value }
-            , type(Argument::Type::unsigned_int)
-        {}
+            return p_this->length - length;
+        }
+    };
 
-        static_assert(sizeof(signed char) == sizeof(int8_t));
-        explicit Argument(signed char a_value)
-            : data{ 0u, 0u, 0u, static_cast<uint8_t>(a_value) }
-            , type(Argument::Type::character)
-        {}
+    struct Sink_writer
+    {
+        const Sink& sink;
+        uint32_t length = 0;
 
-        explicit Argument(const char* a_p_value)
-            : data{ static_cast<uint8_t>((reinterpret_cast<uint32_t>(a_p_value) >> 24u) & 0xFF),
-                    static_cast<uint8_t>((reinterpret_cast<uint32_t>(a_p_value) >> 16u) & 0xFF),
-                    static_cast<uint8_t>((reinterpret_cast<uint32_t>(a_p_value) >> 8u)  & 0xFF),
-                    static_cast<uint8_t>((reinterpret_cast<uint32_t>(a_p_value) >> 0u)  & 0xFF) }
-            , type(Type::cstring)
-        {}
+        void write(const char* a_p_data, uint32_t a_length)
+        {
+            if (a_length > 0)
+            {
+                this->length += this->sink.function(a_p_data, a_length, this->sink.p_user_data);
+            }
+        }
 
-        uint32_t get_uint32() const
+        void write(char a_character)
         {
-            assert(this->type == Type::unsigned_int);
-            return (this->data[0] << 24u) | (this->data[1] << 16u) | (this->data[2] << 8u) | (this->data[3] << 0u);
+            this->length += this->sink.function(&a_character, 1, this->sink.p_user_data);
         }
+    };
 
-        int32_t get_int32() const
+    enum class Format_argument : uint32_t
+    {
+        unsigned_integer,
+        signed_integer,
+        character,
+        cstring,
+        floating,
+        unknown
+    };
+
+    struct Conversion
+    {
+        char type              = 0;
+        uint32_t precision     = format_default_precision;
+        uint32_t fraction_bits = 31;
+        uint32_t end           = 0;
+    };
+
+private:
+
+    static constexpr Format_argument get_format_argument(const unsigned int*)       { return Format_argument::unsigned_integer; }
+    static constexpr Format_argument get_format_argument(const unsigned long int*)  { return Format_argument::unsigned_integer; }
+    static constexpr Format_argument get_format_argument(const unsigned short int*) { return Format_argument::unsigned_integer; }
+    static constexpr Format_argument get_format_argument(const unsigned char*)      { return Format_argument::unsigned_integer; }
+    static constexpr Format_argument get_format_argument(const signed int*)         { return Format_argument::signed_integer; }
+    static constexpr Format_argument get_format_argument(const signed long int*)    { return Format_argument::signed_integer; }
+    static constexpr Format_argument get_format_argument(const signed short int*)   { return Format_argument::signed_integer; }
+    static constexpr Format_argument get_format_argument(const char*)               { return Format_argument::character; }
+    static constexpr Format_argument get_format_argument(const signed char*)        { return Format_argument::character; }
+    static constexpr Format_argument get_format_argument(const char* const*)        { return Format_argument::cstring; }
+    static constexpr Format_argument get_format_argument(char* const*)              { return Format_argument::cstring; }
+    static constexpr Format_argument get_format_argument(const float*)              { return Format_argument::floating; }
+    static constexpr Format_argument get_format_argument(const double*)             { return Format_argument::floating; }
+    static constexpr Format_argument get_format_argument(const void*)               { return Format_argument::unknown; }
+
+    static constexpr bool is_format_argument(char a_conversion, Format_argument a_argument)
+    {
+        return ('u' == a_conversion && Format_argument::unsigned_integer == a_argument) ||
+               ('x' == a_conversion && Format_argument::unsigned_integer == a_argument) ||
+               ('d' == a_conversion && Format_argument::signed_integer == a_argument)   ||
+               ('i' == a_conversion && Format_argument::signed_integer == a_argument)   ||
+               ('c' == a_conversion && Format_argument::character == a_argument)        ||
+               ('s' == a_conversion && Format_argument::cstring == a_argument)          ||
+               ('f' == a_conversion && Format_argument::floating == a_argument)         ||
+               ('q' == a_conversion && Format_argument::signed_integer == a_argument);
+    }
+
+    static constexpr bool is_digit(char a_character)
+    {
+        return a_character >= '0' && a_character <= '9';
+    }
+
+    // 'a_index' points at '%': [.precision]type[fraction bits for 'q']
+    static constexpr Conversion parse_conversion(const char* a_p_format, uint32_t a_index)
+    {
+        Conversion ret;
+        a_index++;
+
+        if ('.' == a_p_format[a_index])
         {
-            assert(this->type == Type::signed_int);
-            return (this->data[0] << 24u) | (this->data[1] << 16u) | (this->data[2] << 8u) | (this->data[3] << 0u);
+            ret.precision = 0;
+
+            while (true == is_digit(a_p_format[++a_index]))
+            {
+                ret.precision = ret.precision * 10u + (a_p_format[a_index] - '0');
+            }
         }
 
-        char get_char() const
+        ret.type = a_p_format[a_index++];
+
+        if ('q' == ret.type && true == is_digit(a_p_format[a_index]))
         {
-            assert(this->type == Type::character);
-            return static_cast<char>(this->data[0]);
+            ret.fraction_bits = 0;
+
+            while (true == is_digit(a_p_format[a_index]))
+            {
+                ret.fraction_bits = ret.fraction_bits * 10u + (a_p_format[a_index++] - '0');
+            }
         }
 
-        const char* get_cstring() const
+        ret.end = a_index;
+
+        return ret;
+    }
+
+    static constexpr uint32_t find_conversion(const char* a_p_format, uint32_t a_index)
+    {
+        while ('\0' != a_p_format[a_index] && '%' != a_p_format[a_index])
         {
-            assert(this->type == Type::cstring);
-            return reinterpret_cast<const char*>((this->data[0] << 24u) |
-                                                 (this->data[1] << 16u) |
-                                                 (this->data[2] << 8u)  |
-                                                 (this->data[3] << 0));
+            a_index++;
         }
 
-    private:
+        return a_index;
+    }
 
-        enum class Type
+    template<char conversion, uint32_t precision, uint32_t fraction_bits, typename Writer_t, typename Type_t>
+    static void format_argument(Writer_t* a_p_writer, Type_t a_value)
+    {
+        constexpr Format_argument argument = get_format_argument(static_cast<const Type_t*>(nullptr));
+
+        if constexpr ('f' == conversion)
         {
-            unsigned_int,
-            signed_int,
-            character,
-            cstring,
-            unknown,
-        };
+            char buffer[format_number_buffer_capacity];
+            a_p_writer->write(buffer, from_float(static_cast<float>(a_value), buffer, sizeof(buffer), precision));
+        }
+        else if constexpr ('q' == conversion)
+        {
+            char buffer[format_number_buffer_capacity];
+            a_p_writer->write(buffer,
+                              from_fixed_point(static_cast<int32_t>(a_value), fraction_bits, buffer, sizeof(buffer), precision));
+        }
+        else if constexpr ('x' == conversion)
+        {
+            char buffer[format_number_buffer_capacity];
+            a_p_writer->write(buffer, from_unsigned_integer_hex(static_cast<uint32_t>(a_value), buffer, sizeof(buffer)));
+        }
+        else if constexpr (Format_argument::unsigned_integer == argument)
+        {
+            char buffer[format_number_buffer_capacity];
+            a_p_writer->write(buffer, from_unsigned_integer_dec(static_cast<uint32_t>(a_value), buffer, sizeof(buffer)));
+        }
+        else if constexpr (Format_argument::signed_integer == argument)
+        {
+            char buffer[format_number_buffer_capacity];
+            a_p_writer->write(buffer, from_signed_integer(static_cast<int32_t>(a_value), buffer, sizeof(buffer), Radix::dec));
+        }
+        else if constexpr (Format_argument::character == argument)
+        {
+            a_p_writer->write(static_cast<char>(a_value));
+        }
+        else if constexpr (Format_argument::cstring == argument)
+        {
+            a_p_writer->write(a_value, length(a_value));
+        }
+    }
 
-    private:
+    template<typename String_t, uint32_t index, typename Writer_t>
+    static void format_static(Writer_t* a_p_writer)
+    {
+        constexpr const char* p_format = String_t::get();
+        constexpr uint32_t conversion  = find_conversion(p_format, index);
 
-        uint8_t data[sizeof(uint32_t)] = { 0 };
-        Type type = Type::unknown;
-    };
+        a_p_writer->write(p_format + index, conversion - index);
+
+        if constexpr ('\0' != p_format[conversion])
+        {
+            static_assert('%' == p_format[conversion + 1], "cstring::format: not enough arguments for the format string");
+
+            a_p_writer->write('%');
+            format_static<String_t, conversion + 2>(a_p_writer);
+        }
+    }
+
+    template<typename String_t, uint32_t index, typename Writer_t, typename Type_t, typename ... Types_t>
+    static void format_static(Writer_t* a_p_writer, Type_t a_value, Types_t ... a_values)
+    {
+        constexpr const char* p_format = String_t::get();
+        constexpr uint32_t conversion  = find_conversion(p_format, index);
+
+        static_assert('\0' != p_format[conversion], "cstring::format: too many arguments for the format string");
+
+        a_p_writer->write(p_format + index, conversion - index);
+
+        if constexpr ('\0' == p_format[conversion])
+        {
+            return;
+        }
+        else if constexpr ('%' == p_format[conversion + 1])
+        {
+            a_p_writer->write('%');
+            format_static<String_t, conversion + 2>(a_p_writer, a_value, a_values...);
+        }
+        else
+        {
+            constexpr Conversion spec = parse_conversion(p_format, conversion);
+
+            static_assert(true == is_format_argument(spec.type, get_format_argument(static_cast<const Type_t*>(nullptr))),
+                          "cstring::format: argument type does not match the conversion");
+            static_assert(spec.fraction_bits > 0 && spec.fraction_bits < 32,
+                          "cstring::format: fixed-point fraction bits out of range");
+
+            format_argument<spec.type, spec.precision, spec.fraction_bits>(a_p_writer, a_value);
+            format_static<String_t, spec.end>(a_p_writer, a_values...);
+        }
+    }
 
 private:
 
-    static uint32_t format_raw(Buffer* a_p_destinaition_buffer,
-                               Buffer* a_p_number_buffer,
+    static uint32_t format_raw(const Sink& a_sink,
                                const char* a_p_format,
                                const Argument* a_p_argv,
                                uint32_t a_argc);
+
+    // value = integer + fraction / 2^fraction_bits
+    static uint32_t from_fraction(bool a_negative,
+                                  uint64_t a_integer,
+                                  uint64_t a_fraction,
+                                  uint32_t a_fraction_bits,
+                                  char* a_p_buffer,
+                                  uint32_t a_buffer_capacity,
+                                  uint32_t a_precision);
 };
 
 } // namespace common
-} // namespace cml
\ No newline at end of file
+} // namespace cml
+
+#define CML_FORMAT(string)                                                       \
+    [] {                                                                         \
+        struct String { static constexpr const char* get() { return string; } }; \
+        return cml::common::cstring::Format<String>{};                           \
+    }()
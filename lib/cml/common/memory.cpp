@@ -9,6 +9,241 @@
 #include <cml/common/memory.hpp>
 #include <cml/debug/assert.hpp>
 
+namespace {
+
+constexpr uint32_t word_size_in_bytes  = sizeof(uint32_t);
+constexpr uint32_t word_mask           = word_size_in_bytes - 1u;
+constexpr uint32_t burst_size_in_words = 4u;
+constexpr uint32_t burst_size_in_bytes = burst_size_in_words * word_size_in_bytes;
+
+bool is_word_aligned(const void* a_p_address)
+{
+    return 0 == (reinterpret_cast<uintptr_t>(a_p_address) & word_mask);
+}
+
+bool is_word_aligned(const void* a_p_first, const void* a_p_second)
+{
+    return 0 == ((reinterpret_cast<uintptr_t>(a_p_first) ^ reinterpret_cast<uintptr_t>(a_p_second)) & word_mask);
+}
+
+//
+// Burst helpers move 'a_count' blocks of 'burst_size_in_bytes' and advance both pointers.
+// On the Cortex-M4 they are hand written LDM/STM loops (four registers per transfer), on other cores the
+// compiler is left with a plain unrolled word loop.
+//
+
+void copy_bursts_forward(uint32_t** a_pp_destination, const uint32_t** a_pp_source, uint32_t a_count)
+{
+#ifdef STM32L452xx
+    uint32_t* p_destination  = *a_pp_destination;
+    const uint32_t* p_source = *a_pp_source;
+
+    __asm__ __volatile__("1: ldmia %[src]!, {r3, r4, r5, r6} \n"
+                         "   stmia %[dst]!, {r3, r4, r5, r6} \n"
+                         "   subs  %[cnt], %[cnt], #1        \n"
+                         "   bne   1b                        \n"
+                         : [dst] "+r" (p_destination), [src] "+r" (p_source), [cnt] "+r" (a_count)
+                         :
+                         : "r3", "r4", "r5", "r6", "cc", "memory");
+
+    (*a_pp_destination) = p_destination;
+    (*a_pp_source)      = p_source;
+#else
+    uint32_t* p_destination  = *a_pp_destination;
+    const uint32_t* p_source = *a_pp_source;
+
+    while (0 != (a_count--))
+    {
+        p_destination[0] = p_source[0];
+        p_destination[1] = p_source[1];
+        p_destination[2] = p_source[2];
+        p_destination[3] = p_source[3];
+
+        p_destination += burst_size_in_words;
+        p_source      += burst_size_in_words;
+    }
+
+    (*a_pp_destination) = p_destination;
+    (*a_pp_source)      = p_source;
+#endif // STM32L452xx
+}
+
+void copy_bursts_backward(uint32_t** a_pp_destination_end, const uint32_t** a_pp_source_end, uint32_t a_count)
+{
+#ifdef STM32L452xx
+    uint32_t* p_destination  = *a_pp_destination_end;
+    const uint32_t* p_source = *a_pp_source_end;
+
+    __asm__ __volatile__("1: ldmdb %[src]!, {r3, r4, r5, r6} \n"
+                         "   stmdb %[dst]!, {r3, r4, r5, r6} \n"
+                         "   subs  %[cnt], %[cnt], #1        \n"
+                         "   bne   1b                        \n"
+                         : [dst] "+r" (p_destination), [src] "+r" (p_source), [cnt] "+r" (a_count)
+                         :
+                         : "r3", "r4", "r5", "r6", "cc", "memory");
+
+    (*a_pp_destination_end) = p_destination;
+    (*a_pp_source_end)      = p_source;
+#else
+    uint32_t* p_destination  = *a_pp_destination_end;
+    const uint32_t* p_source = *a_pp_source_end;
+
+    while (0 != (a_count--))
+    {
+        p_destination -= burst_size_in_words;
+        p_source      -= burst_size_in_words;
+
+        p_destination[3] = p_source[3];
+        p_destination[2] = p_source[2];
+        p_destination[1] = p_source[1];
+        p_destination[0] = p_source[0];
+    }
+
+    (*a_pp_destination_end) = p_destination;
+    (*a_pp_source_end)      = p_source;
+#endif // STM32L452xx
+}
+
+void set_bursts(uint32_t** a_pp_destination, uint32_t a_pattern, uint32_t a_count)
+{
+#ifdef STM32L452xx
+    uint32_t* p_destination = *a_pp_destination;
+
+    __asm__ __volatile__("   mov   r3, %[pat]                \n"
+                         "   mov   r4, %[pat]                \n"
+                         "   mov   r5, %[pat]                \n"
+                         "   mov   r6, %[pat]                \n"
+                         "1: stmia %[dst]!, {r3, r4, r5, r6} \n"
+                         "   subs  %[cnt], %[cnt], #1        \n"
+                         "   bne   1b                        \n"
+                         : [dst] "+r" (p_destination), [cnt] "+r" (a_count)
+                         : [pat] "r" (a_pattern)
+                         : "r3", "r4", "r5", "r6", "cc", "memory");
+
+    (*a_pp_destination) = p_destination;
+#else
+    uint32_t* p_destination = *a_pp_destination;
+
+    while (0 != (a_count--))
+    {
+        p_destination[0] = a_pattern;
+        p_destination[1] = a_pattern;
+        p_destination[2] = a_pattern;
+        p_destination[3] = a_pattern;
+
+        p_destination += burst_size_in_words;
+    }
+
+    (*a_pp_destination) = p_destination;
+#endif // STM32L452xx
+}
+
+void copy_forward(uint8_t* a_p_destination, const uint8_t* a_p_source, uint32_t a_size_in_bytes)
+{
+    if (a_size_in_bytes >= word_size_in_bytes && true == is_word_aligned(a_p_destination, a_p_source))
+    {
+        while (false == is_word_aligned(a_p_destination))
+        {
+            *(a_p_destination++) = *(a_p_source++);
+            a_size_in_bytes--;
+        }
+
+        uint32_t* p_destination  = reinterpret_cast<uint32_t*>(a_p_destination);
+        const uint32_t* p_source = reinterpret_cast<const uint32_t*>(a_p_source);
+
+        if (a_size_in_bytes >= burst_size_in_bytes)
+        {
+            copy_bursts_forward(&p_destination, &p_source, a_size_in_bytes / burst_size_in_bytes);
+            a_size_in_bytes %= burst_size_in_bytes;
+        }
+
+        for (; a_size_in_bytes >= word_size_in_bytes; a_size_in_bytes -= word_size_in_bytes)
+        {
+            *(p_destination++) = *(p_source++);
+        }
+
+        a_p_destination = reinterpret_cast<uint8_t*>(p_destination);
+        a_p_source      = reinterpret_cast<const uint8_t*>(p_source);
+    }
+
+    while (0 != (a_size_in_bytes--))
+    {
+        *(a_p_destination++) = *(a_p_source++);
+    }
+}
+
+void copy_backward(uint8_t* a_p_destination, const uint8_t* a_p_source, uint32_t a_size_in_bytes)
+{
+    uint8_t* p_destination_end  = a_p_destination + a_size_in_bytes;
+    const uint8_t* p_source_end = a_p_source + a_size_in_bytes;
+
+    if (a_size_in_bytes >= word_size_in_bytes && true == is_word_aligned(p_destination_end, p_source_end))
+    {
+        while (false == is_word_aligned(p_destination_end))
+        {
+            *(--p_destination_end) = *(--p_source_end);
+            a_size_in_bytes--;
+        }
+
+        uint32_t* p_destination  = reinterpret_cast<uint32_t*>(p_destination_end);
+        const uint32_t* p_source = reinterpret_cast<const uint32_t*>(p_source_end);
+
+        if (a_size_in_bytes >= burst_size_in_bytes)
+        {
+            copy_bursts_backward(&p_destination, &p_source, a_size_in_bytes / burst_size_in_bytes);
+            a_size_in_bytes %= burst_size_in_bytes;
+        }
+
+        for (; a_size_in_bytes >= word_size_in_bytes; a_size_in_bytes -= word_size_in_bytes)
+        {
+            *(--p_destination) = *(--p_source);
+        }
+
+        p_destination_end = reinterpret_cast<uint8_t*>(p_destination);
+        p_source_end      = reinterpret_cast<const uint8_t*>(p_source);
+    }
+
+    while (0 != (a_size_in_bytes--))
+    {
+        *(--p_destination_end) = *(--p_source_end);
+    }
+}
+
+void fill(uint8_t* a_p_destination, uint8_t a_data, uint32_t a_size_in_bytes)
+{
+    if (a_size_in_bytes >= word_size_in_bytes)
+    {
+        while (false == is_word_aligned(a_p_destination))
+        {
+            *(a_p_destination++) = a_data;
+            a_size_in_bytes--;
+        }
+
+        const uint32_t pattern  = static_cast<uint32_t>(a_data) * 0x01010101u;
+        uint32_t* p_destination = reinterpret_cast<uint32_t*>(a_p_destination);
+
+        if (a_size_in_bytes >= burst_size_in_bytes)
+        {
+            set_bursts(&p_destination, pattern, a_size_in_bytes / burst_size_in_bytes);
+            a_size_in_bytes %= burst_size_in_bytes;
+        }
+
+        for (; a_size_in_bytes >= word_size_in_bytes; a_size_in_bytes -= word_size_in_bytes)
+        {
+            *(p_destination++) = pattern;
+        }
+
+        a_p_destination = reinterpret_cast<uint8_t*>(p_destination);
+    }
+
+    while (0 != (a_size_in_bytes--))
+    {
+        *(a_p_destination++) = a_data;
+    }
+}
+
+} // namespace ::
+
 namespace cml {
 namespace common {
 
@@ -24,16 +259,10 @@ uint32_t memory::copy(void* a_p_destination,
     assert(nullptr != a_p_source);
     assert(a_source_size_in_bytes > 0);
 
-    uint8_t* p_destination  = static_cast<uint8_t*>(a_p_destination);
-    const uint8_t* p_source = static_cast<const uint8_t*>(a_p_source);
-
     uint32_t length = a_destination_capacity_in_bytes > a_source_size_in_bytes ?
                       a_source_size_in_bytes : a_destination_capacity_in_bytes;
 
-    for (uint32_t i = 0; i < length; i++)
-    {
-        p_destination[i] = p_source[i];
-    }
+    copy_forward(static_cast<uint8_t*>(a_p_destination), static_cast<const uint8_t*>(a_p_source), length);
 
     return length;
 }
@@ -49,22 +278,11 @@ void memory::move(void* a_p_destination, const void* a_p_source, uint32_t a_size
 
     if (p_source < p_destination)
     {
-        uint32_t size_in_bytes = a_size_in_bytes;
-
-        p_destination += size_in_bytes;
-        p_source      += size_in_bytes;
-
-        while (0 != (size_in_bytes--))
-        {
-            *(--p_destination) = *(--p_source);
-        }
+        copy_backward(p_destination, p_source, a_size_in_bytes);
     }
     else
     {
-        for (decltype(a_size_in_bytes) i = 0; i < a_size_in_bytes; i++)
-        {
-            p_destination[i] = p_source[i];
-        }
+        copy_forward(p_destination, p_source, a_size_in_bytes);
     }
 }
 
@@ -73,12 +291,7 @@ void memory::set(void* a_p_destination, uint8_t a_data, uint32_t a_size_in_bytes
     assert(a_size_in_bytes > 0);
     assert(nullptr != a_p_destination);
 
-    uint8_t* p_destination = static_cast<uint8_t*>(a_p_destination);
-
-    for (decltype(a_size_in_bytes) i = 0; i < a_size_in_bytes; i++)
-    {
-        p_destination[i] = a_data;
-    }
+    fill(static_cast<uint8_t*>(a_p_destination), a_data, a_size_in_bytes);
 }
 
 void memory::clear(void* a_p_destination, uint32_t a_size_in_bytes)
@@ -86,12 +299,7 @@ void memory::clear(void* a_p_destination, uint32_t a_size_in_bytes)
     assert(a_size_in_bytes > 0);
     assert(nullptr != a_p_destination);
 
-    uint8_t* p_destination = static_cast<uint8_t*>(a_p_destination);
-
-    for (decltype(a_size_in_bytes) i = 0; i < a_size_in_bytes; i++)
-    {
-        p_destination[i] = 0x0u;
-    }
+    fill(static_cast<uint8_t*>(a_p_destination), 0x0u, a_size_in_bytes);
 }
 
 bool memory::equals(const void* a_p_first, const void* a_p_second, uint32_t a_size_in_bytes)
@@ -105,6 +313,26 @@ bool memory::equals(const void* a_p_first, const void* a_p_second, uint32_t a_si
     const uint8_t* p_1 = static_cast<const uint8_t*>(a_p_first);
     const uint8_t* p_2 = static_cast<const uint8_t*>(a_p_second);
 
+    if (a_size_in_bytes >= word_size_in_bytes && true == is_word_aligned(p_1, p_2))
+    {
+        while (false == is_word_aligned(p_1) && true == retval)
+        {
+            retval = *(p_1++) == *(p_2++);
+            a_size_in_bytes--;
+        }
+
+        const uint32_t* p_1_word = reinterpret_cast<const uint32_t*>(p_1);
+        const uint32_t* p_2_word = reinterpret_cast<const uint32_t*>(p_2);
+
+        for (; a_size_in_bytes >= word_size_in_bytes && true == retval; a_size_in_bytes -= word_size_in_bytes)
+        {
+            retval = *(p_1_word++) == *(p_2_word++);
+        }
+
+        p_1 = reinterpret_cast<const uint8_t*>(p_1_word);
+        p_2 = reinterpret_cast<const uint8_t*>(p_2_word);
+    }
+
     for (decltype(a_size_in_bytes) i = 0; i < a_size_in_bytes && true == retval; i++)
     {
         retval = p_1[i] == p_2[i];
@@ -114,4 +342,4 @@ bool memory::equals(const void* a_p_first, const void* a_p_second, uint32_t a_si
 }
 
 } // namespace common
-} // namespace cml
\ No newline at end of file
+} // namespace cml
@@ -0,0 +1,60 @@
+/*
+    Name: latency.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/debug/latency.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace {
+
+uint32_t get_percentile(const uint32_t* a_p_sorted, uint32_t a_count, uint32_t a_percent)
+{
+    const uint32_t rank = (a_count * a_percent + 99u) / 100u;
+    return a_p_sorted[rank > 0 ? rank - 1u : 0];
+}
+
+} // namespace ::
+
+namespace cml {
+namespace debug {
+
+latency::Summary latency::summarize(uint32_t* a_p_samples, uint32_t a_count)
+{
+    assert(nullptr != a_p_samples);
+    assert(a_count > 0);
+
+    // insertion sort - a few hundred samples, no heap
+    for (uint32_t i = 1; i < a_count; i++)
+    {
+        const uint32_t sample = a_p_samples[i];
+        uint32_t j            = i;
+
+        for (; j > 0 && a_p_samples[j - 1] > sample; j--)
+        {
+            a_p_samples[j] = a_p_samples[j - 1];
+        }
+
+        a_p_samples[j] = sample;
+    }
+
+    Summary ret;
+
+    ret.samples = a_count;
+    ret.min     = a_p_samples[0];
+    ret.p50     = get_percentile(a_p_samples, a_count, 50u);
+    ret.p90     = get_percentile(a_p_samples, a_count, 90u);
+    ret.p99     = get_percentile(a_p_samples, a_count, 99u);
+    ret.max     = a_p_samples[a_count - 1];
+    ret.jitter  = ret.max - ret.min;
+
+    return ret;
+}
+
+} // namespace debug
+} // namespace cml
@@ -0,0 +1,108 @@
+#pragma once
+
+/*
+    Name: latency.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/hal/core.hpp>
+
+namespace cml {
+namespace debug {
+
+//
+// Interrupt latency tracing. Each stage of an interrupt dispatch path stamps the cycle counter:
+// 'trigger' - the code that causes the interrupt (e.g. right before toggling a pin looped back to an EXTI line),
+// 'vector' - the first instruction of the interrupt handler,
+// 'dispatch' - the driver found the handle / callback for the interrupt,
+// 'callback' - the first instruction of the user callback.
+// Drivers stamp 'vector' and 'dispatch' only when built with CML_TRACE_LATENCY, so other builds pay nothing.
+//
+class latency
+{
+public:
+
+    enum class Path : uint32_t
+    {
+        exti,
+        usart_rx,
+    };
+
+    enum class Stage : uint32_t
+    {
+        trigger,
+        vector,
+        dispatch,
+        callback,
+    };
+
+    static constexpr uint32_t paths  = 2u;
+    static constexpr uint32_t stages = 4u;
+
+    struct Summary
+    {
+        uint32_t samples = 0;
+
+        uint32_t min = 0;
+        uint32_t p50 = 0;
+        uint32_t p90 = 0;
+        uint32_t p99 = 0;
+        uint32_t max = 0;
+
+        // peak to peak
+        uint32_t jitter = 0;
+    };
+
+public:
+
+    static void mark(Path a_path, Stage a_stage)
+    {
+        stamps[static_cast<uint32_t>(a_path)][static_cast<uint32_t>(a_stage)] = hal::core::get_cycle_counter();
+    }
+
+    //
+    // Stamp taken earlier, for a stage known to belong to the path only later - e.g. 'vector' of an interrupt
+    // shared by several causes.
+    //
+    static void mark(Path a_path, Stage a_stage, uint32_t a_cycles)
+    {
+        stamps[static_cast<uint32_t>(a_path)][static_cast<uint32_t>(a_stage)] = a_cycles;
+    }
+
+    //
+    // Cycles between the last stamps of two stages of the path.
+    //
+    static uint32_t get_cycles(Path a_path, Stage a_from, Stage a_to)
+    {
+        return stamps[static_cast<uint32_t>(a_path)][static_cast<uint32_t>(a_to)] -
+               stamps[static_cast<uint32_t>(a_path)][static_cast<uint32_t>(a_from)];
+    }
+
+    //
+    // Sorts 'a_p_samples' in place. Percentiles are nearest-rank.
+    //
+    static Summary summarize(uint32_t* a_p_samples, uint32_t a_count);
+
+private:
+
+    latency()               = delete;
+    latency(latency&&)      = delete;
+    latency(const latency&) = delete;
+    ~latency()              = default;
+
+    latency& operator = (latency&&)      = delete;
+    latency& operator = (const latency&) = delete;
+
+private:
+
+    inline static volatile uint32_t stamps[paths][stages] = { { 0 } };
+};
+
+} // namespace debug
+} // namespace cml
@@ -0,0 +1,146 @@
+/*
+    Name: profiler.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/debug/profiler.hpp>
+
+//cml
+#include <cml/common/cstring.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/hal/Interrupt_guard.hpp>
+#include <cml/utils/config.hpp>
+
+namespace {
+
+using namespace cml::debug;
+
+profiler::Zone* zones[cml::utils::config::profiler::zones_capacity];
+uint32_t zones_count = 0;
+
+uint32_t get_histogram_bin(uint32_t a_cycles)
+{
+    return 0 == a_cycles ? 0 : 31u - static_cast<uint32_t>(__builtin_clz(a_cycles));
+}
+
+} // namespace ::
+
+namespace cml {
+namespace debug {
+
+using namespace cml::collection;
+using namespace cml::common;
+using namespace cml::hal;
+using namespace cml::utils;
+
+void profiler::record(Zone* a_p_zone, uint32_t a_cycles)
+{
+    assert(nullptr != a_p_zone);
+
+    // the same zone may be measured from the main loop and from an interrupt
+    Interrupt_guard guard;
+
+    if (false == a_p_zone->registered && zones_count < config::profiler::zones_capacity)
+    {
+        zones[zones_count++] = a_p_zone;
+        a_p_zone->registered = true;
+    }
+
+    if (0 == a_p_zone->count || a_cycles < a_p_zone->min)
+    {
+        a_p_zone->min = a_cycles;
+    }
+
+    if (a_cycles > a_p_zone->max)
+    {
+        a_p_zone->max = a_cycles;
+    }
+
+    a_p_zone->count++;
+    a_p_zone->total += a_cycles;
+    a_p_zone->histogram[get_histogram_bin(a_cycles)]++;
+}
+
+void profiler::reset()
+{
+    Interrupt_guard guard;
+
+    for (uint32_t i = 0; i < zones_count; i++)
+    {
+        Zone* p_zone = zones[i];
+
+        p_zone->count = 0;
+        p_zone->min   = 0;
+        p_zone->max   = 0;
+        p_zone->total = 0;
+
+        for (uint32_t bin = 0; bin < histogram_bins; bin++)
+        {
+            p_zone->histogram[bin] = 0;
+        }
+    }
+}
+
+void profiler::dump(Console* a_p_console)
+{
+    assert(nullptr != a_p_console);
+
+    // printed while the zones keep counting - a line may mix samples from before and after an interrupt
+    for (uint32_t i = 0; i < zones_count; i++)
+    {
+        const Zone* p_zone = zones[i];
+
+        a_p_console->write_line("%s: %u samples, cycles min %u, max %u, mean %u",
+                                p_zone->p_name,
+                                p_zone->count,
+                                p_zone->min,
+                                p_zone->max,
+                                p_zone->get_mean());
+
+        for (uint32_t bin = 0; bin < histogram_bins; bin++)
+        {
+            if (p_zone->histogram[bin] > 0)
+            {
+                a_p_console->write_line("    2^%u: %u", bin, p_zone->histogram[bin]);
+            }
+        }
+    }
+}
+
+void profiler::command_line_callback(const Vector<Command_line::Callback::Parameter>& a_params, void* a_p_console)
+{
+    assert(nullptr != a_p_console);
+
+    Console* p_console = static_cast<Console*>(a_p_console);
+
+    p_console->write(config::new_line_character);
+
+    if (2 == a_params.get_length() &&
+        5 == a_params[1].length &&
+        true == cstring::equals(a_params[1].a_p_value, "reset", 5))
+    {
+        reset();
+    }
+    else
+    {
+        dump(p_console);
+    }
+}
+
+uint32_t profiler::get_zones_count()
+{
+    return zones_count;
+}
+
+const profiler::Zone* profiler::get_zone(uint32_t a_index)
+{
+    assert(a_index < zones_count);
+
+    return zones[a_index];
+}
+
+} // namespace debug
+} // namespace cml
@@ -0,0 +1,117 @@
+#pragma once
+
+/*
+    Name: profiler.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/collection/Vector.hpp>
+#include <cml/hal/core.hpp>
+#include <cml/utils/Command_line.hpp>
+#include <cml/utils/Console.hpp>
+
+namespace cml {
+namespace debug {
+
+//
+// Cycle counting profiler. A 'Scope' measures the core cycles from its construction to its destruction and
+// adds them to a named 'Zone': sample count, min, max, mean and a log2 histogram (bin N counts samples of
+// 2^N to 2^(N+1) - 1 cycles). Times are inclusive - interrupts preempting a scope are counted in it.
+// Zones register themselves in a static table on their first sample, 'dump' prints the table.
+//
+// Building with CML_PROFILE_IRQ adds zones to the USART, ADC, EXTI and systick interrupt handlers.
+//
+class profiler
+{
+public:
+
+    static constexpr uint32_t histogram_bins = 32u;
+
+    struct Zone : private Non_copyable
+    {
+        constexpr explicit Zone(const char* a_p_name)
+            : p_name(a_p_name)
+            , count(0)
+            , min(0)
+            , max(0)
+            , total(0)
+            , histogram{ 0 }
+            , registered(false)
+        {}
+
+        uint32_t get_mean() const
+        {
+            return 0 == this->count ? 0 : static_cast<uint32_t>(this->total / this->count);
+        }
+
+        const char* p_name;
+
+        uint32_t count;
+        uint32_t min;
+        uint32_t max;
+        uint64_t total;
+        uint32_t histogram[histogram_bins];
+
+        bool registered;
+    };
+
+    class Scope : private Non_copyable
+    {
+    public:
+
+        explicit Scope(Zone* a_p_zone)
+            : p_zone(a_p_zone)
+            , start(hal::core::get_cycle_counter())
+        {}
+
+        ~Scope()
+        {
+            profiler::record(this->p_zone, hal::core::get_cycle_counter() - this->start);
+        }
+
+    private:
+
+        Zone* p_zone;
+        uint32_t start;
+    };
+
+public:
+
+    static void record(Zone* a_p_zone, uint32_t a_cycles);
+
+    //
+    // Clears the samples of all registered zones.
+    //
+    static void reset();
+
+    static void dump(utils::Console* a_p_console);
+
+    //
+    // For Command_line::register_callback, with the Console as user data: "<name>" dumps, "<name> reset" resets.
+    //
+    static void command_line_callback(const collection::Vector<utils::Command_line::Callback::Parameter>& a_params,
+                                      void* a_p_console);
+
+    static uint32_t get_zones_count();
+    static const Zone* get_zone(uint32_t a_index);
+
+private:
+
+    profiler()                = delete;
+    profiler(profiler&&)      = delete;
+    profiler(const profiler&) = delete;
+    ~profiler()               = default;
+
+    profiler& operator = (profiler&&)      = delete;
+    profiler& operator = (const profiler&) = delete;
+};
+
+} // namespace debug
+} // namespace cml
@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+    Name: Edge_clock.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//soc
+#include <soc/Edge_clock.hpp>
+
+namespace cml {
+namespace hal {
+
+using Edge_clock = soc::Edge_clock;
+
+} // namespace hal
+} // namespace cml
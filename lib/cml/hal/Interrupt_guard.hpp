@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+    Name: Interrupt_guard.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//soc
+#include <soc/Interrupt_guard.hpp>
+
+namespace cml {
+namespace hal {
+
+using Interrupt_guard = soc::Interrupt_guard;
+
+} // namespace hal
+} // namespace cml
@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+    Name: Priority_guard.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//soc
+#include <soc/Priority_guard.hpp>
+
+namespace cml {
+namespace hal {
+
+using Priority_guard = soc::Priority_guard;
+
+} // namespace hal
+} // namespace cml
@@ -0,0 +1,361 @@
+#pragma once
+
+/*
+    Name: bit_bang.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/debug/assert.hpp>
+#include <cml/hal/Edge_clock.hpp>
+#include <cml/hal/Interrupt_guard.hpp>
+#include <cml/hal/peripherals/GPIO.hpp>
+
+namespace cml {
+namespace hal {
+namespace bit_bang {
+
+//
+// Protocol engines on plain GPIO pins, timed with Edge_clock. A pin is a type with static 'set_high', 'set_low'
+// and 'get_level' (peripherals::Out_pin_t), configured by the caller beforehand. Timings are in core cycles
+// (Edge_clock::ns_to_cycles). Interrupts are masked for one bit slot at a time, never for a whole transfer.
+//
+
+//
+// Stands in for a pin the transfer does not use, e.g. MISO of a write only Spi.
+//
+struct No_pin
+{
+    static void set_high() {}
+    static void set_low() {}
+
+    static peripherals::pin::Level get_level()
+    {
+        return peripherals::pin::Level::low;
+    }
+};
+
+//
+// Single wire NRZ LEDs (WS2812 and alike). Every bit is a high pulse - short for 0, long for 1 - MSB first.
+// Interrupts let in between two slots stretch the low part of the slot; the LEDs latch after a few
+// microseconds of low, so handlers running meanwhile have to be shorter than that.
+//
+template<typename Data_pin_t>
+class Nrz_led
+{
+public:
+
+    struct Timing
+    {
+        uint32_t t0h   = 0;
+        uint32_t t0l   = 0;
+        uint32_t t1h   = 0;
+        uint32_t t1l   = 0;
+        uint32_t reset = 0;
+    };
+
+    static constexpr Timing ws2812(uint32_t a_frequency_hz)
+    {
+        return { Edge_clock::ns_to_cycles(400u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(850u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(800u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(450u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(280000u, a_frequency_hz) };
+    }
+
+public:
+
+    Nrz_led(const Timing& a_timing)
+        : timing(a_timing)
+    {}
+
+    //
+    // Sends the bytes as they are (the color order is up to the caller), then holds the line low
+    // for Timing::reset, so the LEDs latch.
+    //
+    void write(const uint8_t* a_p_data, uint32_t a_size) const
+    {
+        assert(nullptr != a_p_data);
+
+        Edge_clock clock;
+
+        for (uint32_t i = 0; i < a_size; i++)
+        {
+            for (uint32_t bit = 0x80u; bit > 0; bit >>= 1u)
+            {
+                const bool one      = 0 != (a_p_data[i] & bit);
+                const uint32_t high = true == one ? this->timing.t1h : this->timing.t0h;
+                const uint32_t low  = true == one ? this->timing.t1l : this->timing.t0l;
+
+                Interrupt_guard guard;
+
+                clock.start();
+                Data_pin_t::set_high();
+                clock.wait(high);
+                Data_pin_t::set_low();
+                clock.wait(low);
+            }
+        }
+
+        clock.start();
+        clock.wait(this->timing.reset);
+    }
+
+private:
+
+    Timing timing;
+};
+
+//
+// 1-Wire master. 'Pin_t' is open drain with a pull-up: 'set_low' pulls the bus down, 'set_high' releases it.
+// Bytes go LSB first.
+//
+template<typename Pin_t>
+class One_wire
+{
+public:
+
+    struct Timing
+    {
+        uint32_t write_1_low     = 0;
+        uint32_t write_1_release = 0;
+        uint32_t write_0_low     = 0;
+        uint32_t write_0_release = 0;
+
+        uint32_t read_low     = 0;
+        uint32_t read_sample  = 0;
+        uint32_t read_release = 0;
+
+        uint32_t reset_low       = 0;
+        uint32_t presence_sample = 0;
+        uint32_t reset_release   = 0;
+    };
+
+    static constexpr Timing standard_speed(uint32_t a_frequency_hz)
+    {
+        return { Edge_clock::ns_to_cycles(6000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(64000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(60000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(10000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(6000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(9000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(55000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(480000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(70000u, a_frequency_hz),
+                 Edge_clock::ns_to_cycles(410000u, a_frequency_hz) };
+    }
+
+public:
+
+    One_wire(const Timing& a_timing)
+        : timing(a_timing)
+    {}
+
+    //
+    // Reset pulse, returns true when a device answered with a presence pulse.
+    //
+    bool reset() const
+    {
+        Edge_clock clock;
+
+        // a minimum - interrupts may stretch it
+        clock.start();
+        Pin_t::set_low();
+        clock.wait(this->timing.reset_low);
+
+        bool presence = false;
+
+        {
+            Interrupt_guard guard;
+
+            clock.start();
+            Pin_t::set_high();
+            clock.wait(this->timing.presence_sample);
+            presence = peripherals::pin::Level::low == Pin_t::get_level();
+        }
+
+        clock.start();
+        clock.wait(this->timing.reset_release);
+
+        return presence;
+    }
+
+    void write_bit(bool a_bit) const
+    {
+        const uint32_t low     = true == a_bit ? this->timing.write_1_low : this->timing.write_0_low;
+        const uint32_t release = true == a_bit ? this->timing.write_1_release : this->timing.write_0_release;
+
+        Interrupt_guard guard;
+        Edge_clock clock;
+
+        clock.start();
+        Pin_t::set_low();
+        clock.wait(low);
+        Pin_t::set_high();
+        clock.wait(release);
+    }
+
+    bool read_bit() const
+    {
+        Interrupt_guard guard;
+        Edge_clock clock;
+
+        clock.start();
+        Pin_t::set_low();
+        clock.wait(this->timing.read_low);
+        Pin_t::set_high();
+        clock.wait(this->timing.read_sample);
+
+        const bool ret = peripherals::pin::Level::high == Pin_t::get_level();
+
+        clock.wait(this->timing.read_release);
+
+        return ret;
+    }
+
+    void write(const uint8_t* a_p_data, uint32_t a_size) const
+    {
+        assert(nullptr != a_p_data);
+
+        for (uint32_t i = 0; i < a_size; i++)
+        {
+            for (uint32_t bit = 0; bit < 8u; bit++)
+            {
+                this->write_bit(0 != (a_p_data[i] & (0x1u << bit)));
+            }
+        }
+    }
+
+    void read(uint8_t* a_p_data, uint32_t a_size) const
+    {
+        assert(nullptr != a_p_data);
+
+        for (uint32_t i = 0; i < a_size; i++)
+        {
+            uint8_t byte = 0;
+
+            for (uint32_t bit = 0; bit < 8u; bit++)
+            {
+                if (true == this->read_bit())
+                {
+                    byte |= static_cast<uint8_t>(0x1u << bit);
+                }
+            }
+
+            a_p_data[i] = byte;
+        }
+    }
+
+private:
+
+    Timing timing;
+};
+
+//
+// SPI master, MSB first, chip select up to the caller. SCK clocks the data, so late edges only slow the
+// transfer down and nothing is masked; every bit is timed from its own start, so a late bit is not followed
+// by a burst of short ones.
+//
+template<typename Sck_pin_t, typename Mosi_pin_t, typename Miso_pin_t = No_pin>
+class Spi
+{
+public:
+
+    // CPOL in bit 1, CPHA in bit 0
+    enum class Mode : uint32_t
+    {
+        _0 = 0x0u,
+        _1 = 0x1u,
+        _2 = 0x2u,
+        _3 = 0x3u
+    };
+
+public:
+
+    Spi(Mode a_mode, uint32_t a_half_period)
+        : mode(a_mode)
+        , half_period(a_half_period)
+    {}
+
+    //
+    // Sends 0xFF when 'a_p_tx' is nullptr, drops the received bytes when 'a_p_rx' is nullptr.
+    //
+    void transfer(const uint8_t* a_p_tx, uint8_t* a_p_rx, uint32_t a_size) const
+    {
+        const bool cpol = 0 != (static_cast<uint32_t>(this->mode) & 0x2u);
+        const bool cpha = 0 != (static_cast<uint32_t>(this->mode) & 0x1u);
+
+        // first edge of a bit launches the data with CPHA = 1, samples it with CPHA = 0
+        const bool sample_level = true == cpha ? cpol : !cpol;
+
+        Edge_clock clock;
+
+        drive<Sck_pin_t>(cpol);
+
+        for (uint32_t i = 0; i < a_size; i++)
+        {
+            const uint8_t tx = nullptr != a_p_tx ? a_p_tx[i] : 0xFFu;
+            uint8_t rx       = 0;
+
+            for (uint32_t bit = 0x80u; bit > 0; bit >>= 1u)
+            {
+                clock.start();
+
+                if (true == cpha)
+                {
+                    drive<Sck_pin_t>(!cpol);
+                }
+
+                drive<Mosi_pin_t>(0 != (tx & bit));
+                clock.wait(this->half_period);
+
+                drive<Sck_pin_t>(sample_level);
+
+                if (peripherals::pin::Level::high == Miso_pin_t::get_level())
+                {
+                    rx |= static_cast<uint8_t>(bit);
+                }
+
+                clock.wait(this->half_period);
+
+                if (false == cpha)
+                {
+                    drive<Sck_pin_t>(cpol);
+                }
+            }
+
+            if (nullptr != a_p_rx)
+            {
+                a_p_rx[i] = rx;
+            }
+        }
+    }
+
+private:
+
+    template<typename Drive_pin_t> static void drive(bool a_high)
+    {
+        if (true == a_high)
+        {
+            Drive_pin_t::set_high();
+        }
+        else
+        {
+            Drive_pin_t::set_low();
+        }
+    }
+
+private:
+
+    Mode mode;
+    uint32_t half_period;
+};
+
+} // namespace bit_bang
+} // namespace hal
+} // namespace cml
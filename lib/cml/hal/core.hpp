@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+    Name: core.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//soc
+#include <soc/core.hpp>
+
+namespace cml {
+namespace hal {
+
+using core = soc::core;
+
+} // namespace hal
+} // namespace cml
\ No newline at end of file
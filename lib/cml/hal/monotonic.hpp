@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+    Name: monotonic.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#include <soc/monotonic.hpp>
+
+namespace cml {
+namespace hal {
+
+using monotonic = soc::monotonic;
+
+} // namespace hal
+} // namespace cml
\ No newline at end of file
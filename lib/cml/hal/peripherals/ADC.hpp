@@ -16,6 +16,10 @@
 #include <soc/stm32l011xx/peripherals/ADC.hpp>
 #endif // STM32L011xx
 
+#ifdef CML_HOST
+#include <soc/host/peripherals/ADC.hpp>
+#endif // CML_HOST
+
 namespace cml {
 namespace hal {
 namespace peripherals {
@@ -28,6 +32,10 @@ using ADC = soc::stm32l452xx::peripherals::ADC;
 using ADC = soc::stm32l011xx::peripherals::ADC;
 #endif // STM32L011xx
 
+#ifdef CML_HOST
+using ADC = soc::host::peripherals::ADC;
+#endif // CML_HOST
+
 } // namespace peripherals
 } // namespace hal
 } // namespace cml
\ No newline at end of file
@@ -15,6 +15,10 @@
 #include <soc/stm32l011xx/peripherals/GPIO.hpp>
 #endif // STM32L011xx
 
+#ifdef CML_HOST
+#include <soc/host/peripherals/GPIO.hpp>
+#endif // CML_HOST
+
 namespace cml {
 namespace hal {
 namespace peripherals {
@@ -22,13 +26,30 @@ namespace peripherals {
 #ifdef STM32L452xx
 using GPIO = soc::stm32l452xx::peripherals::GPIO;
 using pin  = soc::stm32l452xx::peripherals::pin;
+
+template<GPIO::Id id_t> using GPIO_t = soc::stm32l452xx::peripherals::GPIO_t<id_t>;
+template<GPIO::Id port_t, uint8_t id_t> using Out_pin_t = soc::stm32l452xx::peripherals::Out_pin_t<port_t, id_t>;
+template<GPIO::Id port_t, uint8_t... ids_t> using Out_pin_group_t = soc::stm32l452xx::peripherals::Out_pin_group_t<port_t, ids_t...>;
 #endif // STM32L452xx
 
 #ifdef STM32L011xx
 using GPIO = soc::stm32l011xx::peripherals::GPIO;
 using pin  = soc::stm32l011xx::peripherals::pin;
+
+template<GPIO::Id id_t> using GPIO_t = soc::stm32l011xx::peripherals::GPIO_t<id_t>;
+template<GPIO::Id port_t, uint8_t id_t> using Out_pin_t = soc::stm32l011xx::peripherals::Out_pin_t<port_t, id_t>;
+template<GPIO::Id port_t, uint8_t... ids_t> using Out_pin_group_t = soc::stm32l011xx::peripherals::Out_pin_group_t<port_t, ids_t...>;
 #endif // STM32L011xx
 
+#ifdef CML_HOST
+using GPIO = soc::host::peripherals::GPIO;
+using pin  = soc::host::peripherals::pin;
+
+template<GPIO::Id id_t> using GPIO_t = soc::host::peripherals::GPIO_t<id_t>;
+template<GPIO::Id port_t, uint8_t id_t> using Out_pin_t = soc::host::peripherals::Out_pin_t<port_t, id_t>;
+template<GPIO::Id port_t, uint8_t... ids_t> using Out_pin_group_t = soc::host::peripherals::Out_pin_group_t<port_t, ids_t...>;
+#endif // CML_HOST
+
 } // namespace peripherals
 } // namespace hal
 } // namespace cml
\ No newline at end of file
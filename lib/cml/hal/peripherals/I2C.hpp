@@ -8,6 +8,8 @@
 */
 
 //cml
+#include <soc/I2C_timing.hpp>
+
 #ifdef STM32L452xx
 #include <soc/stm32l452xx/peripherals/I2C.hpp>
 #endif // STM32L452xx
@@ -32,6 +34,9 @@ using I2C_master = soc::stm32l011xx::peripherals::I2C_master;
 using I2C_slave  = soc::stm32l011xx::peripherals::I2C_slave;
 #endif // STM32L011xx
 
+// no CML_HOST I2C model: only I2C_timing is available (and tested) on the host
+using I2C_timing = soc::I2C_timing;
+
 } // namespace peripherals
 } // namespace cml
 } // namespace hal
\ No newline at end of file
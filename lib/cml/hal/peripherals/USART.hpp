@@ -16,18 +16,29 @@
 #include <soc/stm32l011xx/peripherals/USART.hpp>
 #endif // STM32L011xx
 
+#ifdef CML_HOST
+#include <soc/host/peripherals/USART.hpp>
+#endif // CML_HOST
+
 namespace cml {
 namespace hal {
 namespace peripherals {
 
 #ifdef STM32L452xx
 using USART = soc::stm32l452xx::peripherals::USART;
+template<USART::Id id_t> using USART_t = soc::stm32l452xx::peripherals::USART_t<id_t>;
 #endif // STM32L452xx
 
 #ifdef STM32L011xx
 using USART = soc::stm32l011xx::peripherals::USART;
+template<USART::Id id_t> using USART_t = soc::stm32l011xx::peripherals::USART_t<id_t>;
 #endif // STM32L011xx
 
+#ifdef CML_HOST
+using USART = soc::host::peripherals::USART;
+template<USART::Id id_t> using USART_t = soc::host::peripherals::USART_t<id_t>;
+#endif // CML_HOST
+
 } // namespace peripherals
 } // namespace hal
 } // namespace cml
\ No newline at end of file
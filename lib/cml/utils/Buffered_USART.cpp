@@ -0,0 +1,137 @@
+/*
+    Name: Buffered_USART.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/Buffered_USART.hpp>
+
+#ifdef CML_HOST
+#include <soc/host/simulation.hpp>
+#endif // CML_HOST
+
+namespace cml {
+namespace utils {
+
+using namespace cml::hal::peripherals;
+
+void Buffered_USART::enable()
+{
+    this->rx_overflow      = false;
+    this->rx_dropped_bytes = 0;
+
+    this->p_usart->register_bus_status_callback({ bus_status_handler, this });
+    this->p_usart->register_receive_callback({ receive_handler, this });
+}
+
+void Buffered_USART::disable()
+{
+    if (true == this->p_usart->is_enabled())
+    {
+        this->p_usart->unregister_transmit_callback();
+        this->p_usart->unregister_receive_callback();
+        this->p_usart->unregister_bus_status_callback();
+    }
+
+    this->tx_ring.clear();
+    this->rx_ring.clear();
+}
+
+uint32_t Buffered_USART::write(const void* a_p_data, uint32_t a_size_in_bytes)
+{
+    assert(nullptr != a_p_data);
+    assert(a_size_in_bytes > 0);
+
+    uint32_t ret = this->tx_ring.push(static_cast<const uint8_t*>(a_p_data), a_size_in_bytes);
+
+    // the transmit interrupt unregisters itself once the ring runs dry, check it only after the new data is visible
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+    if (ret > 0 && false == this->p_usart->is_transmit_callback_registered())
+    {
+        this->p_usart->register_transmit_callback({ transmit_handler, this });
+    }
+
+    return ret;
+}
+
+uint32_t Buffered_USART::write_string_handler(const char* a_p_string, uint32_t a_length, void* a_p_user_data)
+{
+    assert(nullptr != a_p_user_data);
+
+    Buffered_USART* p_this = static_cast<Buffered_USART*>(a_p_user_data);
+    uint32_t written       = 0;
+
+    while (written < a_length)
+    {
+        written += p_this->write(a_p_string + written, a_length - written);
+
+#ifdef CML_HOST
+        // nothing drains the ring behind our back on the host
+        if (written < a_length)
+        {
+            soc::host::simulation::run_interrupts();
+        }
+#endif // CML_HOST
+    }
+
+    return written;
+}
+
+uint32_t Buffered_USART::read(void* a_p_data, uint32_t a_size_in_bytes)
+{
+    assert(nullptr != a_p_data);
+    assert(a_size_in_bytes > 0);
+
+    return this->rx_ring.pop(static_cast<uint8_t*>(a_p_data), a_size_in_bytes);
+}
+
+bool Buffered_USART::transmit_handler(volatile uint16_t* a_p_data, bool a_transfer_complete, void* a_p_user_data)
+{
+    Buffered_USART* p_this = static_cast<Buffered_USART*>(a_p_user_data);
+
+    if (true == a_transfer_complete)
+    {
+        return false == p_this->tx_ring.is_empty();
+    }
+
+    uint8_t data = 0;
+    bool ret     = p_this->tx_ring.pop(&data);
+
+    if (true == ret)
+    {
+        (*a_p_data) = data;
+    }
+
+    return ret;
+}
+
+bool Buffered_USART::receive_handler(uint32_t a_data, bool a_idle, void* a_p_user_data)
+{
+    Buffered_USART* p_this = static_cast<Buffered_USART*>(a_p_user_data);
+
+    if (false == a_idle && false == p_this->rx_ring.push(static_cast<uint8_t>(a_data)))
+    {
+        p_this->rx_overflow = true;
+        p_this->rx_dropped_bytes = p_this->rx_dropped_bytes + 1u;
+    }
+
+    return true;
+}
+
+bool Buffered_USART::bus_status_handler(USART::Bus_status_flag a_bus_status, void* a_p_user_data)
+{
+    Buffered_USART* p_this = static_cast<Buffered_USART*>(a_p_user_data);
+
+    if (USART::Bus_status_flag::overrun == (a_bus_status & USART::Bus_status_flag::overrun))
+    {
+        p_this->rx_overflow = true;
+    }
+
+    return true;
+}
+
+} // namespace utils
+} // namespace cml
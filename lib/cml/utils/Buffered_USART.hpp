@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+    Name: Buffered_USART.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/collection/Spsc_ring.hpp>
+#include <cml/debug/assert.hpp>
+#include <cml/hal/peripherals/USART.hpp>
+#include <cml/utils/config.hpp>
+
+namespace cml {
+namespace utils {
+
+//
+// Interrupt driven, non-blocking byte stream on top of an enabled USART. TDR is filled from the TXE
+// interrupt and RDR is drained in the RXNE interrupt, both through lock-free rings, so 'write' and 'read'
+// only copy to / from RAM. Takes over the transmit, receive and bus status callbacks of the USART.
+//
+class Buffered_USART : private Non_copyable
+{
+public:
+
+    Buffered_USART(hal::peripherals::USART* a_p_usart)
+        : p_usart(a_p_usart)
+        , tx_ring(this->tx_buffer, config::buffered_usart::tx_buffer_capacity)
+        , rx_ring(this->rx_buffer, config::buffered_usart::rx_buffer_capacity)
+        , rx_overflow(false)
+        , rx_dropped_bytes(0)
+    {
+        assert(nullptr != a_p_usart);
+    }
+
+    ~Buffered_USART()
+    {
+        this->disable();
+    }
+
+    void enable();
+    void disable();
+
+    uint32_t write(const void* a_p_data, uint32_t a_size_in_bytes);
+    uint32_t read(void* a_p_data, uint32_t a_size_in_bytes);
+
+    void clear_rx_overflow()
+    {
+        this->rx_overflow = false;
+    }
+
+    bool is_rx_overflow() const
+    {
+        return this->rx_overflow;
+    }
+
+    bool is_transmit_pending() const
+    {
+        return true == this->p_usart->is_transmit_callback_registered();
+    }
+
+    uint32_t get_rx_dropped_bytes() const
+    {
+        return this->rx_dropped_bytes;
+    }
+
+    uint32_t get_tx_free_space() const
+    {
+        return this->tx_ring.get_free_space();
+    }
+
+    uint32_t get_rx_length() const
+    {
+        return this->rx_ring.get_length();
+    }
+
+    hal::peripherals::USART* get_usart() const
+    {
+        return this->p_usart;
+    }
+
+    //
+    // Write string handler for Console / Logger and cstring::format_to sink ('a_p_user_data' is the
+    // Buffered_USART): waits for room in the TX ring, so output of any length goes through a small ring.
+    // Not for interrupts of equal or higher priority than the USART one - the ring would never drain.
+    //
+    static uint32_t write_string_handler(const char* a_p_string, uint32_t a_length, void* a_p_user_data);
+
+private:
+
+    static bool transmit_handler(volatile uint16_t* a_p_data, bool a_transfer_complete, void* a_p_user_data);
+    static bool receive_handler(uint32_t a_data, bool a_idle, void* a_p_user_data);
+    static bool bus_status_handler(hal::peripherals::USART::Bus_status_flag a_bus_status, void* a_p_user_data);
+
+private:
+
+    hal::peripherals::USART* p_usart;
+
+    uint8_t tx_buffer[config::buffered_usart::tx_buffer_capacity];
+    uint8_t rx_buffer[config::buffered_usart::rx_buffer_capacity];
+
+    collection::Spsc_ring<uint8_t> tx_ring;
+    collection::Spsc_ring<uint8_t> rx_ring;
+
+    volatile bool rx_overflow;
+    volatile uint32_t rx_dropped_bytes;
+};
+
+} // namespace utils
+} // namespace cml
@@ -73,24 +73,35 @@ public:
         return this->write_character.function(a_character, this->write_character.p_user_data);
     }
 
+    //
+    // Measured and handed to the write string handler a line buffer at a time, there is no length limit.
+    //
     uint32_t write(const char* a_p_string)
     {
         assert(nullptr != a_p_string);
 
-        return this->write_string.function(a_p_string,
-                                           common::cstring::length(a_p_string, config::console::line_buffer_capacity),
-                                           this->write_string.p_user_data);
+        uint32_t ret    = 0;
+        uint32_t length = common::cstring::length(a_p_string, config::console::line_buffer_capacity);
+
+        while (length > 0)
+        {
+            ret        += this->write_string.function(a_p_string, length, this->write_string.p_user_data);
+            a_p_string += length;
+            length      = common::cstring::length(a_p_string, config::console::line_buffer_capacity);
+        }
+
+        return ret;
     }
 
-    template<typename ... Params_t>
-    uint32_t write(const char* a_p_format, Params_t ... a_params)
+    //
+    // Formatted output is streamed to the write string handler chunk by chunk, there is no line length limit.
+    //
+    template<typename Format_t, typename ... Params_t>
+    uint32_t write(Format_t a_format, Params_t ... a_params)
     {
-        uint32_t length = common::cstring::format(this->line_buffer,
-                                                  config::console::line_buffer_capacity,
-                                                  a_p_format,
-                                                  a_params ...);
-
-        return this->write_string.function(this->line_buffer, length, this->write_string.p_user_data);
+        return common::cstring::format_to({ this->write_string.function, this->write_string.p_user_data },
+                                          a_format,
+                                          a_params ...);
     }
 
     uint32_t write_line(char a_character)
@@ -101,43 +112,13 @@ public:
 
     uint32_t write_line(const char* a_p_string)
     {
-        uint32_t length = common::memory::copy(this->line_buffer,
-                                               config::command_line::line_buffer_capacity,
-
-                                               a_p_string,
-                                               common::cstring::length(a_p_string,
-                                                                       config::command_line::line_buffer_capacity));
-
-        if (length < config::command_line::line_buffer_capacity)
-        {
-            this->line_buffer[length++] = config::new_line_character;
-        }
-        else
-        {
-            this->line_buffer[length - 1] = config::new_line_character;
-        }
-
-        return this->write_string.function(this->line_buffer, length, this->write_string.p_user_data);
+        return this->write(a_p_string) + this->write(config::new_line_character);
     }
 
-    template<typename ... Params_t>
-    uint32_t write_line(const char* a_p_format, Params_t ... a_params)
+    template<typename Format_t, typename ... Params_t>
+    uint32_t write_line(Format_t a_format, Params_t ... a_params)
     {
-        uint32_t length = common::cstring::format(this->line_buffer,
-                                                  config::console::line_buffer_capacity,
-                                                  a_p_format,
-                                                  a_params ...);
-
-        if (length < config::command_line::line_buffer_capacity)
-        {
-            this->line_buffer[length++] = config::new_line_character;
-        }
-        else
-        {
-            this->line_buffer[length - 1] = config::new_line_character;
-        }
-
-        return this->write_string.function(this->line_buffer, length, this->write_string.p_user_data);
+        return this->write(a_format, a_params ...) + this->write(config::new_line_character);
     }
 
     uint32_t read_key(char* a_p_character)
@@ -169,7 +150,6 @@ private:
     Write_string_handler    write_string;
     Read_character_handler  read_character;
 
-    char line_buffer[config::console::line_buffer_capacity];
     char input_buffer[config::console::input_buffer_capacity];
 };
 
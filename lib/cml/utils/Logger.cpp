@@ -0,0 +1,83 @@
+/*
+    Name: Logger.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/Logger.hpp>
+
+//cml
+#include <cml/hal/Interrupt_guard.hpp>
+
+namespace cml {
+namespace utils {
+
+using namespace cml::common;
+using namespace cml::hal;
+
+uint32_t Logger::flush()
+{
+    assert(nullptr != this->p_records);
+    assert(nullptr != this->write_string.function);
+
+    uint32_t ret = 0;
+    Record_word header[record_header_length];
+
+    while (record_header_length == this->p_records->pop(header, record_header_length))
+    {
+        const uint32_t type = static_cast<uint32_t>(header[2] & 0xFu);
+        const uint32_t argc = static_cast<uint32_t>((header[2] >> 4u) & 0xFu);
+
+        Record_word words[config::logger::deferred_max_arguments];
+        cstring::Argument argv[config::logger::deferred_max_arguments];
+
+        this->p_records->pop(words, argc);
+
+        for (uint32_t i = 0; i < argc; i++)
+        {
+            argv[i] = cstring::Argument(static_cast<cstring::Argument::Type>((header[2] >> (8u + 4u * i)) & 0xFu),
+                                        words[i]);
+        }
+
+        // "[tag] [timestamp] "
+        char prefix[6 + 1 + cstring::format_number_buffer_capacity + 2];
+
+        uint32_t length = memory::copy(prefix, sizeof(prefix), tags[type], 6);
+
+        prefix[length++] = '[';
+        length += cstring::from_unsigned_integer(static_cast<uint32_t>(header[1]), prefix + length, sizeof(prefix) - length, cstring::Radix::dec);
+        prefix[length++] = ']';
+        prefix[length++] = ' ';
+
+        this->write_string.function(prefix, length, this->write_string.p_user_data);
+        cstring::format_arguments_to({ this->write_string.function, this->write_string.p_user_data },
+                                     reinterpret_cast<const char*>(header[0]),
+                                     argv,
+                                     argc);
+        ret++;
+    }
+
+    return ret;
+}
+
+uint32_t Logger::push_record(const Record_word* a_p_record, uint32_t a_length)
+{
+    // producers may be both thread and interrupt context - the ring is single-producer and a record is several
+    // words that have to stay together, so the free space check and the push run under a short guard
+    Interrupt_guard guard;
+
+    if (this->p_records->get_free_space() < a_length)
+    {
+        this->dropped_records = this->dropped_records + 1u;
+        return 0;
+    }
+
+    this->p_records->push(a_p_record, a_length);
+
+    return 1;
+}
+
+} // namespace utils
+} // namespace cml
@@ -12,7 +12,9 @@
 
 //cml
 #include <cml/bit.hpp>
+#include <cml/collection/Spsc_ring.hpp>
 #include <cml/common/cstring.hpp>
+#include <cml/hal/counter.hpp>
 #include <cml/hal/peripherals/USART.hpp>
 #include <cml/utils/config.hpp>
 
@@ -39,15 +41,22 @@ public:
         void* p_user_data = nullptr;
     };
 
+    using Record_word = common::cstring::Argument::Word;
+    using Record_ring = collection::Spsc_ring<Record_word>;
+
 public:
 
     Logger()
         : verbosity(0)
+        , p_records(nullptr)
+        , dropped_records(0)
     {}
 
     Logger(const Write_string_handler& a_write_string_handler, bool a_inf, bool a_wrn, bool a_err, bool a_omg)
         : write_string(a_write_string_handler)
         , verbosity(0)
+        , p_records(nullptr)
+        , dropped_records(0)
     {
         assert(nullptr != a_write_string_handler.function);
 
@@ -81,6 +90,36 @@ public:
         set_flag(&(this->verbosity), static_cast<uint8_t>(0xFu));
     }
 
+    //
+    // In deferred mode inf/wrn/err/omg only store the format pointer, a counter timestamp and the raw argument
+    // words in 'a_p_records' (returning 1 when stored, 0 when dropped) - text is rendered later by 'flush'.
+    // Format and cstring arguments have to outlive the record, so use literals / static strings only.
+    //
+    void enable_deferred_mode(Record_ring* a_p_records)
+    {
+        assert(nullptr != a_p_records);
+
+        this->p_records       = a_p_records;
+        this->dropped_records = 0;
+    }
+
+    void disable_deferred_mode()
+    {
+        this->p_records = nullptr;
+    }
+
+    bool is_deferred_mode_enabled() const
+    {
+        return nullptr != this->p_records;
+    }
+
+    uint32_t get_dropped_records() const
+    {
+        return this->dropped_records;
+    }
+
+    uint32_t flush();
+
     uint32_t inf(const char* a_p_message)
     {
         return this->write(a_p_message, Stream_type::inf);
@@ -101,104 +140,103 @@ public:
         return this->write(a_p_message, Stream_type::omg);
     }
 
-    template<typename ... params>
-    uint32_t inf(const char* a_p_format, params ... a_params)
+    template<typename Format_t, typename ... params>
+    uint32_t inf(Format_t a_format, params ... a_params)
     {
-        if (true == this->is_stream_enabled(Stream_type::inf))
-        {
-            common::memory::copy(this->line_buffer, config::logger::line_buffer_capacity, tags[0], 6);
-
-            uint32_t length = common::cstring::format(this->line_buffer + 6,
-                                                      config::logger::line_buffer_capacity - 6,
-                                                      a_p_format,
-                                                      a_params...);
+        return this->write(Stream_type::inf, a_format, a_params...);
+    }
 
-            return this->write_string.function(this->line_buffer, length + 6, this->write_string.p_user_data);
-        }
+    template<typename Format_t, typename ... params>
+    uint32_t wrn(Format_t a_format, params ... a_params)
+    {
+        return this->write(Stream_type::wrn, a_format, a_params...);
+    }
 
-        return 0;
+    template<typename Format_t, typename ... params>
+    uint32_t err(Format_t a_format, params ... a_params)
+    {
+        return this->write(Stream_type::err, a_format, a_params...);
     }
 
-    template<typename ... params>
-    uint32_t wrn(const char* a_p_format, params ... a_params)
+    template<typename Format_t, typename ... params>
+    uint32_t omg(Format_t a_format, params ... a_params)
     {
-        if (true == this->is_stream_enabled(Stream_type::wrn))
-        {
-            common::memory::copy(this->line_buffer, config::logger::line_buffer_capacity, tags[1], 6);
+        return this->write(Stream_type::omg, a_format, a_params...);
+    }
 
-            uint32_t length = common::cstring::format(this->line_buffer + 6,
-                                                      config::logger::line_buffer_capacity - 6,
-                                                      a_p_format,
-                                                      a_params...);
+private:
 
-            return this->write_string.function(this->line_buffer, length + 6, this->write_string.p_user_data);
-        }
+    static constexpr const char* tags[] =
+    {
+        "[inf] ",
+        "[wrn] ",
+        "[err] ",
+        "[omg] "
+    };
 
-        return 0;
-    }
+private:
 
-    template<typename ... params>
-    uint32_t err(const char* a_p_format, params ... a_params)
+    template<typename Format_t, typename ... params>
+    uint32_t write(Stream_type a_type, Format_t a_format, params ... a_params)
     {
-        if (true == this->is_stream_enabled(Stream_type::err))
+        if (false == this->is_stream_enabled(a_type))
         {
-           common::memory::copy(this->line_buffer, config::logger::line_buffer_capacity, tags[2], 6);
-
-           uint32_t length = common::cstring::format(this->line_buffer + 6,
-                                                     config::logger::line_buffer_capacity - 6,
-                                                     a_p_format,
-                                                     a_params...);
+            return 0;
+        }
 
-           return this->write_string.function(this->line_buffer, length + 6, this->write_string.p_user_data);
+        if (nullptr != this->p_records)
+        {
+            return this->push_record(a_type, a_format, a_params...);
         }
 
-        return 0;
+        // streamed straight to the handler - no staging copy and no line length limit
+        return this->write_string.function(tags[static_cast<uint32_t>(a_type)], 6, this->write_string.p_user_data) +
+               common::cstring::format_to({ this->write_string.function, this->write_string.p_user_data },
+                                          a_format,
+                                          a_params...);
     }
 
-    template<typename ... params>
-    uint32_t omg(const char* a_p_format, params ... a_params)
+    //
+    // record: [format][timestamp][stream type | argc << 4 | argument types << 8 + 4 * i][argument words]
+    //
+    template<typename Format_t, typename ... params>
+    uint32_t push_record(Stream_type a_type, Format_t a_format, params ... a_params)
     {
-        if (true == this->is_stream_enabled(Stream_type::omg))
-        {
-            common::memory::copy(this->line_buffer, config::logger::line_buffer_capacity, tags[3], 6);
+        static_assert(sizeof...(params) <= config::logger::deferred_max_arguments);
+
+        const common::cstring::Argument args[] = { common::cstring::Argument{ a_params }... };
+        Record_word record[record_header_length + sizeof...(params)];
 
-            uint32_t length = common::cstring::format(this->line_buffer + 6,
-                                                      config::logger::line_buffer_capacity - 6,
-                                                      a_p_format,
-                                                      a_params...);
+        record[0] = reinterpret_cast<Record_word>(static_cast<const char*>(a_format));
+        record[1] = hal::counter::get();
+        record[2] = static_cast<uint32_t>(a_type) | (sizeof...(params) << 4u);
 
-            return this->write_string.function(this->line_buffer, length + 6, this->write_string.p_user_data);
+        for (uint32_t i = 0; i < sizeof...(params); i++)
+        {
+            record[2] |= static_cast<Record_word>(args[i].get_type()) << (8u + 4u * i);
+            record[record_header_length + i] = args[i].get_raw();
         }
 
-        return 0;
+        return this->push_record(record, record_header_length + sizeof...(params));
     }
 
-private:
-
-    static constexpr const char* tags[] =
-    {
-        "[inf] ",
-        "[wrn] ",
-        "[err] ",
-        "[omg] "
-    };
-
-private:
+    uint32_t push_record(const Record_word* a_p_record, uint32_t a_length);
 
     uint32_t write(const char* a_p_message, Stream_type a_type)
     {
-        common::memory::copy(this->line_buffer,
-                             config::logger::line_buffer_capacity,
-                             tags[static_cast<uint32_t>(a_type)],
-                             6);
+        if (nullptr != this->p_records)
+        {
+            const Record_word record[] = { reinterpret_cast<Record_word>(a_p_message),
+                                           hal::counter::get(),
+                                           static_cast<Record_word>(a_type) };
 
-        uint32_t length = common::memory::copy(this->line_buffer + 6,
-                                               config::logger::line_buffer_capacity - 6,
-                                               a_p_message,
-                                               common::cstring::length(a_p_message,
-                                                                       config::logger::line_buffer_capacity - 6));
+            return this->push_record(record, record_header_length);
+        }
 
-        return this->write_string.function(this->line_buffer, length + 6, this->write_string.p_user_data);
+        return this->write_string.function(tags[static_cast<uint32_t>(a_type)], 6, this->write_string.p_user_data) +
+               this->write_string.function(a_p_message,
+                                           common::cstring::length(a_p_message),
+                                           this->write_string.p_user_data);
     }
 
     uint8_t create_verbosity_mask(bool a_inf, bool a_wrn, bool a_err, bool a_omg)
@@ -209,13 +247,18 @@ private:
                (true == a_omg ? 0x8u : 0x0u);
     }
 
+private:
+
+    static constexpr uint32_t record_header_length = 3u;
+
 private:
 
     Write_string_handler write_string;
     uint8_t verbosity;
 
-    char line_buffer[config::logger::line_buffer_capacity];
+    Record_ring* p_records;
+    volatile uint32_t dropped_records;
 };
 
 } // namepace hal
-} // namepace cml
\ No newline at end of file
+} // namepace cml
@@ -0,0 +1,131 @@
+/*
+    Name: Scheduler.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/Scheduler.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+#include <cml/hal/core.hpp>
+#include <cml/hal/Interrupt_guard.hpp>
+#include <cml/hal/systick.hpp>
+
+namespace cml {
+namespace utils {
+
+using namespace cml::hal;
+
+bool Scheduler::post(const Task& a_task, uint32_t a_priority)
+{
+    assert(nullptr != a_task.function);
+    assert(a_priority < priorities);
+
+    Queue* p_queue = &(this->queues[a_priority]);
+    uint32_t index = p_queue->write_index.load(Memory_order::relaxed);
+
+    while (true)
+    {
+        Queue::Slot* p_slot    = &(p_queue->slots[index & (queue_capacity - 1u)]);
+        const int32_t distance = static_cast<int32_t>(p_slot->sequence.load(Memory_order::acquire) - index);
+
+        if (0 == distance)
+        {
+            // a failed exchange reloads 'index' - an interrupt posted in between
+            if (true == p_queue->write_index.compare_exchange(&index, index + 1u, Memory_order::relaxed))
+            {
+                p_slot->task = a_task;
+                p_slot->sequence.store(index + 1u, Memory_order::release);
+
+                return true;
+            }
+        }
+        else if (distance < 0)
+        {
+            // the task of the previous lap is still there
+            this->dropped_tasks.fetch_add(1u, Memory_order::relaxed);
+            return false;
+        }
+        else
+        {
+            index = p_queue->write_index.load(Memory_order::relaxed);
+        }
+    }
+}
+
+bool Scheduler::dispatch()
+{
+    for (uint32_t i = 0; i < priorities; i++)
+    {
+        Queue* p_queue = &(this->queues[i]);
+
+        if (false == p_queue->is_empty())
+        {
+            Queue::Slot* p_slot = &(p_queue->slots[p_queue->read_index & (queue_capacity - 1u)]);
+            const Task task     = p_slot->task;
+
+            // free for the write index one lap ahead
+            p_slot->sequence.store(p_queue->read_index + queue_capacity, Memory_order::release);
+            p_queue->read_index++;
+
+            task.function(task.p_user_data);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Scheduler::idle()
+{
+    // an interrupt posting between the check and the sleep still wakes the core up
+    Interrupt_guard guard;
+
+    if (false == this->is_pending())
+    {
+        core::wait_for_interrupt();
+    }
+}
+
+void Scheduler::idle(uint32_t a_max_ticks)
+{
+    assert(a_max_ticks > 0);
+
+    // as above - systick::sleep wakes on a masked interrupt as well
+    Interrupt_guard guard;
+
+    if (false == this->is_pending())
+    {
+        systick::sleep(a_max_ticks);
+    }
+}
+
+void Scheduler::run()
+{
+    while (true)
+    {
+        if (false == this->dispatch())
+        {
+            this->idle();
+        }
+    }
+}
+
+bool Scheduler::is_pending() const
+{
+    for (uint32_t i = 0; i < priorities; i++)
+    {
+        if (false == this->queues[i].is_empty())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace utils
+} // namespace cml
@@ -0,0 +1,129 @@
+#pragma once
+
+/*
+    Name: Scheduler.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/atomic.hpp>
+#include <cml/Non_copyable.hpp>
+#include <cml/utils/config.hpp>
+
+namespace cml {
+namespace utils {
+
+//
+// Run-to-completion task scheduler for the main loop. Interrupt handlers (or the main loop itself) 'post' tasks
+// into fixed size per-priority queues, 'run' executes them one at a time, highest priority (0) first, and
+// sleeps until the next interrupt when nothing is pending. Tasks are never preempted by other tasks, so they
+// need no locking between each other.
+//
+class Scheduler : private Non_copyable
+{
+public:
+
+    struct Task
+    {
+        using Function = void(*)(void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    static constexpr uint32_t priorities = config::scheduler::priorities;
+
+public:
+
+    Scheduler()
+        : dropped_tasks(0)
+    {}
+
+    ~Scheduler() = default;
+
+    //
+    // Safe from any interrupt priority. Lock-free: producers claim a slot with a compare-exchange of the write
+    // index, no interrupt is held off (Cortex-M0+ only: cml::atomic runs it in a few instructions of PRIMASK).
+    // Returns false (and counts the task as dropped) when the queue is full.
+    //
+    bool post(const Task& a_task, uint32_t a_priority);
+
+    //
+    // Runs the oldest task of the highest pending priority, returns false when there was none.
+    //
+    bool dispatch();
+
+    //
+    // Sleeps until the next interrupt if no task is pending - for loops that do more than 'run'.
+    //
+    void idle();
+
+    //
+    // Tickless 'idle': the systick interrupt is stopped for up to 'a_max_ticks' ticks (systick::sleep), the tick
+    // callback catches up on the ticks that passed when the core wakes up. Pass the ticks to the next deadline,
+    // e.g. Timer_service::get_ticks_to_next_expiry. systick has to be enabled.
+    //
+    void idle(uint32_t a_max_ticks);
+
+    [[noreturn]] void run();
+
+    bool is_pending() const;
+
+    uint32_t get_dropped_tasks() const
+    {
+        return this->dropped_tasks.load(Memory_order::relaxed);
+    }
+
+private:
+
+    static constexpr uint32_t queue_capacity = config::scheduler::queue_capacity;
+
+    //
+    // Bounded multi-producer / single-consumer queue. The sequence of a slot is the write index it takes the
+    // next task at while free, that index + 1 once the task is in, so the consumer never reads a claimed slot
+    // before it is written. An interrupt preempting a producer claims the slot after it.
+    //
+    struct Queue
+    {
+        struct Slot
+        {
+            Task task;
+            atomic<uint32_t> sequence;
+        };
+
+        Queue()
+            : read_index(0)
+        {
+            for (uint32_t i = 0; i < queue_capacity; i++)
+            {
+                this->slots[i].sequence.store(i, Memory_order::relaxed);
+            }
+        }
+
+        bool is_empty() const
+        {
+            const Slot& slot = this->slots[this->read_index & (queue_capacity - 1u)];
+            return this->read_index + 1u != slot.sequence.load(Memory_order::acquire);
+        }
+
+        Slot slots[queue_capacity];
+
+        atomic<uint32_t> write_index;
+
+        // the consumer (dispatch) only
+        uint32_t read_index;
+    };
+
+private:
+
+    Queue queues[priorities];
+    atomic<uint32_t> dropped_tasks;
+};
+
+} // namespace utils
+} // namespace cml
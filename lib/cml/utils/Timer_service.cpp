@@ -0,0 +1,210 @@
+/*
+    Name: Timer_service.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <cml/utils/Timer_service.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+#include <cml/hal/Interrupt_guard.hpp>
+
+namespace cml {
+namespace utils {
+
+using namespace cml::hal;
+
+void Timer_service::start_one_shot(Timer* a_p_timer, time::tick a_delay, const Callback& a_callback)
+{
+    this->start(a_p_timer, a_delay, 0, a_callback);
+}
+
+void Timer_service::start_periodic(Timer* a_p_timer, time::tick a_period, const Callback& a_callback)
+{
+    assert(a_period > 0);
+
+    this->start(a_p_timer, a_period, a_period, a_callback);
+}
+
+void Timer_service::stop(Timer* a_p_timer)
+{
+    assert(nullptr != a_p_timer);
+
+    Interrupt_guard guard;
+
+    if (true == a_p_timer->is_armed())
+    {
+        unlink(a_p_timer);
+    }
+}
+
+void Timer_service::update()
+{
+    const uint32_t index = this->now & slot_mask;
+
+    // level 0 went around - refill it from the next level up (and that one from its next, when it went around too)
+    for (uint32_t level = 1; 0 == (this->now & ((1u << (level_bits * level)) - 1u)) && level < levels; level++)
+    {
+        this->cascade(level);
+    }
+
+    // taken as a whole, so timers re-armed from callbacks do not end up in the list being run
+    Timer* p_expired = this->p_slots[0][index];
+
+    if (nullptr != p_expired)
+    {
+        p_expired->pp_prev = &p_expired;
+    }
+
+    this->p_slots[0][index] = nullptr;
+    this->now++;
+
+    while (nullptr != p_expired)
+    {
+        Timer* p_timer = p_expired;
+        unlink(p_timer);
+
+        if (p_timer->period > 0)
+        {
+            p_timer->expires += p_timer->period;
+            this->add(p_timer);
+        }
+
+        // may stop or restart any timer, this one included
+        p_timer->callback.function(p_timer->callback.p_user_data);
+    }
+}
+
+time::tick Timer_service::get_ticks_to_next_expiry(time::tick a_limit) const
+{
+    assert(a_limit > 0);
+
+    const uint32_t index = this->now & slot_mask;
+
+    // offset of the update refilling level 0 - nothing from the levels above expires before it
+    const time::tick refill = (slots_per_level - index) & slot_mask;
+
+    Interrupt_guard guard;
+
+    bool upper_armed = false;
+
+    for (uint32_t level = 1; level < levels && false == upper_armed; level++)
+    {
+        for (uint32_t i = 0; i < slots_per_level && false == upper_armed; i++)
+        {
+            upper_armed = nullptr != this->p_slots[level][i];
+        }
+    }
+
+    // level 0 holds only timers less than a revolution ahead, so the slot distance is their exact expiry
+    const time::tick end = true == upper_armed ? refill : slots_per_level;
+    time::tick offset    = 0;
+
+    for (; offset < end && nullptr == this->p_slots[0][(index + offset) & slot_mask]; offset++);
+
+    if (slots_per_level == offset)
+    {
+        return a_limit;
+    }
+
+    return offset + 1u < a_limit ? offset + 1u : a_limit;
+}
+
+void Timer_service::tick_handler(void* a_p_this)
+{
+    assert(nullptr != a_p_this);
+
+    static_cast<Timer_service*>(a_p_this)->update();
+}
+
+void Timer_service::start(Timer* a_p_timer, time::tick a_delay, time::tick a_period, const Callback& a_callback)
+{
+    assert(nullptr != a_p_timer);
+    assert(nullptr != a_callback.function);
+
+    Interrupt_guard guard;
+
+    if (true == a_p_timer->is_armed())
+    {
+        unlink(a_p_timer);
+    }
+
+    a_p_timer->expires  = this->now + a_delay;
+    a_p_timer->period   = a_period;
+    a_p_timer->callback = a_callback;
+
+    this->add(a_p_timer);
+}
+
+void Timer_service::add(Timer* a_p_timer)
+{
+    time::tick delta = a_p_timer->expires - this->now;
+
+    // already due (or far in the past after wrapping around) - the next update runs it
+    if (delta > numeric_traits<int32_t>::get_max())
+    {
+        link(&(this->p_slots[0][this->now & slot_mask]), a_p_timer);
+        return;
+    }
+
+    // beyond the wheel - parked at the furthest slot, the cascade puts it back later
+    time::tick expires = a_p_timer->expires;
+
+    if (delta > max_delta)
+    {
+        delta   = max_delta;
+        expires = this->now + max_delta;
+    }
+
+    uint32_t level = 0;
+    for (; level + 1u < levels && delta >= (1u << (level_bits * (level + 1u))); level++);
+
+    link(&(this->p_slots[level][(expires >> (level_bits * level)) & slot_mask]), a_p_timer);
+}
+
+void Timer_service::cascade(uint32_t a_level)
+{
+    Timer** pp_slot = &(this->p_slots[a_level][(this->now >> (level_bits * a_level)) & slot_mask]);
+    Timer* p_timer  = *pp_slot;
+
+    *pp_slot = nullptr;
+
+    while (nullptr != p_timer)
+    {
+        Timer* p_next = p_timer->p_next;
+        this->add(p_timer);
+        p_timer = p_next;
+    }
+}
+
+void Timer_service::link(Timer** a_pp_head, Timer* a_p_timer)
+{
+    a_p_timer->p_next  = *a_pp_head;
+    a_p_timer->pp_prev = a_pp_head;
+
+    if (nullptr != *a_pp_head)
+    {
+        (*a_pp_head)->pp_prev = &(a_p_timer->p_next);
+    }
+
+    *a_pp_head = a_p_timer;
+}
+
+void Timer_service::unlink(Timer* a_p_timer)
+{
+    *(a_p_timer->pp_prev) = a_p_timer->p_next;
+
+    if (nullptr != a_p_timer->p_next)
+    {
+        a_p_timer->p_next->pp_prev = a_p_timer->pp_prev;
+    }
+
+    a_p_timer->p_next  = nullptr;
+    a_p_timer->pp_prev = nullptr;
+}
+
+} // namespace utils
+} // namespace cml
@@ -0,0 +1,147 @@
+#pragma once
+
+/*
+    Name: Timer_service.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/time.hpp>
+#include <cml/utils/config.hpp>
+
+namespace cml {
+namespace utils {
+
+//
+// One-shot and periodic software timers on a hierarchical timer wheel: starting, stopping and expiring a timer
+// is O(1) and a tick costs the same with one or hundreds of armed timers (apart from the callbacks that fire).
+// Timers are owned by the caller, the service keeps no storage for them. Driven with 'update' once per tick,
+// usually from the systick tick callback - callbacks run in that context. systick has a single tick callback and
+// 'counter' (so delay::ms, wait::until and the driver timeouts) is driven from it too, so both go in one function:
+//
+//     void tick(void* a_p_user_data)
+//     {
+//         counter::update(nullptr);
+//         static_cast<Timer_service*>(a_p_user_data)->update();
+//     }
+//
+//     systick::register_tick_callback({ tick, &timer_service });
+//
+class Timer_service : private Non_copyable
+{
+public:
+
+    struct Callback
+    {
+        using Function = void(*)(void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    class Timer : private Non_copyable
+    {
+    public:
+
+        Timer()
+            : p_next(nullptr)
+            , pp_prev(nullptr)
+            , expires(0)
+            , period(0)
+        {}
+
+        ~Timer() = default;
+
+        bool is_armed() const
+        {
+            return nullptr != this->pp_prev;
+        }
+
+    private:
+
+        Timer* p_next;
+        Timer** pp_prev;
+
+        time::tick expires;
+        time::tick period;
+
+        Callback callback;
+
+    private:
+
+        friend class Timer_service;
+    };
+
+public:
+
+    Timer_service()
+        : now(0)
+        , p_slots{}
+    {}
+
+    ~Timer_service() = default;
+
+    //
+    // 'a_p_timer' fires once after 'a_delay' ticks (0 - at the next update). Restarts an armed timer.
+    //
+    void start_one_shot(Timer* a_p_timer, time::tick a_delay, const Callback& a_callback);
+
+    //
+    // 'a_p_timer' fires every 'a_period' ticks, the first time after one period. Expiry times advance by whole
+    // periods, so late callbacks do not make it drift. Restarts an armed timer.
+    //
+    void start_periodic(Timer* a_p_timer, time::tick a_period, const Callback& a_callback);
+
+    void stop(Timer* a_p_timer);
+
+    void update();
+
+    //
+    // Calls of 'update' up to and including the first one that may fire a timer, 'a_limit' at most (also when
+    // none is armed) - the ticks to sleep for, see systick::sleep and Scheduler::idle. Exact for timers due
+    // within the lowest wheel level, the later ones are bounded by the next refill of that level.
+    //
+    time::tick get_ticks_to_next_expiry(time::tick a_limit) const;
+
+    // 'update' as a callback, for a tick source that drives nothing else - not the systick of 'counter'
+    static void tick_handler(void* a_p_this);
+
+    time::tick get_ticks() const
+    {
+        return this->now;
+    }
+
+private:
+
+    static constexpr uint32_t level_bits      = config::timer_service::wheel_level_bits;
+    static constexpr uint32_t levels          = config::timer_service::wheel_levels;
+    static constexpr uint32_t slots_per_level = 1u << level_bits;
+    static constexpr uint32_t slot_mask       = slots_per_level - 1u;
+    static constexpr time::tick max_delta     = (1u << (level_bits * levels)) - 1u;
+
+private:
+
+    void start(Timer* a_p_timer, time::tick a_delay, time::tick a_period, const Callback& a_callback);
+
+    void add(Timer* a_p_timer);
+    void cascade(uint32_t a_level);
+
+    static void link(Timer** a_pp_head, Timer* a_p_timer);
+    static void unlink(Timer* a_p_timer);
+
+private:
+
+    // next tick to process
+    time::tick now;
+
+    Timer* p_slots[levels][slots_per_level];
+};
+
+} // namespace utils
+} // namespace cml
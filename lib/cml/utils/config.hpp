@@ -57,7 +57,7 @@ struct config
 
     struct logger
     {
-        static constexpr uint32_t line_buffer_capacity = 128u;
+        static constexpr uint32_t deferred_max_arguments = 6u;
 
         logger()              = delete;
         logger(logger&&)      = delete;
@@ -67,7 +67,76 @@ struct config
         logger& operator = (logger&)       = delete;
         logger& operator = (const logger&) = delete;
 
-        static_assert(line_buffer_capacity > 1);
+        static_assert(deferred_max_arguments > 0 && deferred_max_arguments <= 6);
+    };
+
+    struct buffered_usart
+    {
+        static constexpr uint32_t tx_buffer_capacity = 128u;
+        static constexpr uint32_t rx_buffer_capacity = 64u;
+
+        buffered_usart()                      = delete;
+        buffered_usart(buffered_usart&&)      = delete;
+        buffered_usart(const buffered_usart&) = delete;
+        ~buffered_usart()                     = delete;
+
+        buffered_usart& operator = (buffered_usart&)       = delete;
+        buffered_usart& operator = (const buffered_usart&) = delete;
+
+        static_assert(tx_buffer_capacity > 0 && 0 == (tx_buffer_capacity & (tx_buffer_capacity - 1u)));
+        static_assert(rx_buffer_capacity > 0 && 0 == (rx_buffer_capacity & (rx_buffer_capacity - 1u)));
+    };
+
+    struct timer_service
+    {
+        // 'wheel_levels' levels of 2^'wheel_level_bits' slots (one pointer each), timers up to
+        // 2^('wheel_level_bits' * 'wheel_levels') ticks ahead are placed directly, longer ones re-cascade
+        static constexpr uint32_t wheel_level_bits = 6u;
+        static constexpr uint32_t wheel_levels     = 4u;
+
+        timer_service()                     = delete;
+        timer_service(timer_service&&)      = delete;
+        timer_service(const timer_service&) = delete;
+        ~timer_service()                    = delete;
+
+        timer_service& operator = (timer_service&)       = delete;
+        timer_service& operator = (const timer_service&) = delete;
+
+        static_assert(wheel_level_bits > 0 && wheel_levels > 0);
+        static_assert(wheel_level_bits * wheel_levels < 32);
+    };
+
+    struct scheduler
+    {
+        static constexpr uint32_t priorities     = 4u;
+        static constexpr uint32_t queue_capacity = 16u;
+
+        scheduler()                 = delete;
+        scheduler(scheduler&&)      = delete;
+        scheduler(const scheduler&) = delete;
+        ~scheduler()                = delete;
+
+        scheduler& operator = (scheduler&)       = delete;
+        scheduler& operator = (const scheduler&) = delete;
+
+        static_assert(priorities > 0);
+        static_assert(queue_capacity > 0 && 0 == (queue_capacity & (queue_capacity - 1u)));
+    };
+
+    struct profiler
+    {
+        // zones past the capacity are still measured, but not listed by 'dump'
+        static constexpr uint32_t zones_capacity = 16u;
+
+        profiler()                = delete;
+        profiler(profiler&&)      = delete;
+        profiler(const profiler&) = delete;
+        ~profiler()               = delete;
+
+        profiler& operator = (profiler&)       = delete;
+        profiler& operator = (const profiler&) = delete;
+
+        static_assert(zones_capacity > 0);
     };
 
 
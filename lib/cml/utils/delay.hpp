@@ -20,6 +20,10 @@
 #include <soc/stm32l011xx/misc.hpp>
 #endif // STM32L011xx
 
+#ifdef CML_HOST
+#include <soc/host/simulation.hpp>
+#endif // CML_HOST
+
 namespace cml {
 namespace utils {
 
@@ -38,7 +42,16 @@ public:
     static void ms(time::tick a_time)
     {
         time::tick start = hal::counter::get();
+
+#ifdef CML_HOST
+        // simulated time only moves while something waits for it
+        while (time::diff(hal::counter::get(), start) <= a_time)
+        {
+            soc::host::simulation::advance(1);
+        }
+#else
         while (time::diff(hal::counter::get(), start) <= a_time);
+#endif // CML_HOST
     }
 
     inline static void us(time::tick a_time)
@@ -50,6 +63,12 @@ public:
 #ifdef STM32L011xx
         soc::stm32l011xx::misc::delay_us(a_time);
 #endif // STM32L011xx
+
+#ifdef CML_HOST
+        // below the tick resolution - only let pending interrupts run
+        (void)a_time;
+        soc::host::simulation::run_interrupts();
+#endif // CML_HOST
     }
 };
 
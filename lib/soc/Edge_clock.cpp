@@ -0,0 +1,63 @@
+/*
+    Name: Edge_clock.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/Edge_clock.hpp>
+
+//soc
+#include <soc/Interrupt_guard.hpp>
+#include <soc/systick.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace soc {
+
+#if !defined(CML_HOST) && !defined(CML_DWT_PRESENT)
+uint32_t Edge_clock::measure(uint32_t a_loops)
+{
+    Interrupt_guard guard;
+
+    const uint32_t start = SysTick->VAL;
+    spin(a_loops);
+    const uint32_t end = SysTick->VAL;
+
+    // down counter, reloaded at most once in a run this short
+    return start >= end ? start - end : start + (SysTick->LOAD + 1u - end);
+}
+#endif // !CML_HOST && !CML_DWT_PRESENT
+
+void Edge_clock::calibrate()
+{
+#if !defined(CML_HOST) && !defined(CML_DWT_PRESENT)
+    constexpr uint32_t short_run = 16u;
+
+    assert(true == systick::is_enabled());
+
+    // a loop takes up to 8 cycles with flash wait states - a longer run than the systick period could wrap twice
+    const uint32_t max_loops = SysTick->LOAD / 8u;
+    const uint32_t long_run  = max_loops < short_run + 256u ? max_loops : short_run + 256u;
+
+    // too short a period to measure against (sysclk in the tens of kHz), the previous calibration stays
+    if (long_run < short_run * 4u)
+    {
+        return;
+    }
+
+    const uint32_t short_cycles = measure(short_run);
+    const uint32_t long_cycles  = measure(long_run);
+
+    assert(long_cycles > short_cycles);
+
+    const uint32_t loop_cycles = long_cycles - short_cycles;
+
+    loops_per_cycle = ((long_run - short_run) << 16u) / loop_cycles;
+    overhead        = short_cycles - (short_run * loop_cycles) / (long_run - short_run);
+#endif // !CML_HOST && !CML_DWT_PRESENT
+}
+
+} // namespace soc
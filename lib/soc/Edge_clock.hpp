@@ -0,0 +1,117 @@
+#pragma once
+
+/*
+    Name: Edge_clock.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#ifdef STM32L452xx
+#include <stm32l4xx.h>
+#endif
+
+#ifdef STM32L011xx
+#include <stm32l0xx.h>
+#endif
+
+#ifdef CML_HOST
+#include <soc/host/simulation.hpp>
+#endif
+
+namespace soc {
+
+//
+// Busy wait timing of bit-banged edges, in core cycles.
+// With a DWT (CML_DWT_PRESENT, enabled with mcu::enable_dwt) every 'wait' ends a fixed number of cycles after
+// the previous edge, so the code driving the pins in between does not add up over a slot.
+// Without it the wait is a spin loop calibrated against the systick ('calibrate') - the cycles spent between two
+// waits add to the interval, keep them to a few instructions.
+// On the host the waits move host::simulation::get_cycles.
+//
+class Edge_clock
+{
+public:
+
+    Edge_clock()
+        : edge(0)
+    {}
+
+    Edge_clock(Edge_clock&&)      = delete;
+    Edge_clock(const Edge_clock&) = delete;
+
+    Edge_clock& operator = (Edge_clock&&)      = delete;
+    Edge_clock& operator = (const Edge_clock&) = delete;
+
+    //
+    // Takes the current cycle as the previous edge.
+    //
+    void start()
+    {
+#ifdef CML_DWT_PRESENT
+        this->edge = DWT->CYCCNT;
+#endif // CML_DWT_PRESENT
+    }
+
+    //
+    // Returns 'a_cycles' after the previous edge (or 'start'), that is the previous edge from now on.
+    //
+    void wait(uint32_t a_cycles)
+    {
+#ifdef CML_HOST
+        host::simulation::advance_cycles(a_cycles);
+#elif defined(CML_DWT_PRESENT)
+        this->edge += a_cycles;
+        while (static_cast<int32_t>(DWT->CYCCNT - this->edge) < 0);
+#else
+        // 16.16 fixed point split in halves, no 64-bit multiplication
+        const uint32_t cycles = a_cycles > overhead ? a_cycles - overhead : 0;
+        spin((cycles >> 16u) * loops_per_cycle + (((cycles & 0xFFFFu) * loops_per_cycle) >> 16u));
+#endif // CML_HOST
+    }
+
+    //
+    // Measures the spin loop against the systick, which has to be running. Called by systick::enable and,
+    // on the L011, by mcu::set_sysclk (the flash latency changes with it) - call again only after changing
+    // the flash latency by hand. Does nothing with a DWT.
+    //
+    static void calibrate();
+
+    static constexpr uint32_t ns_to_cycles(uint32_t a_ns, uint32_t a_frequency_hz)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(a_ns) * a_frequency_hz + 999999999u) / 1000000000u);
+    }
+
+private:
+
+#if !defined(CML_HOST) && !defined(CML_DWT_PRESENT)
+    static void spin(uint32_t a_loops)
+    {
+        if (a_loops > 0)
+        {
+            // divided syntax (the GCC default for Thumb-1): 'sub' is the 16-bit encoding, which sets the flags
+            __asm__ __volatile__("1: sub %0, #1 \n"
+                                 "   bne 1b     \n"
+                                 : "+r" (a_loops)
+                                 :
+                                 : "cc");
+        }
+    }
+
+    // loops per core cycle (16.16 fixed point) and the cycles of a wait that runs no loop
+    inline static uint32_t loops_per_cycle = 0x10000u / 3u;
+    inline static uint32_t overhead        = 0;
+
+    static uint32_t measure(uint32_t a_loops);
+#endif // !CML_HOST && !CML_DWT_PRESENT
+
+private:
+
+    uint32_t edge;
+};
+
+} // namespace soc
@@ -0,0 +1,254 @@
+#pragma once
+
+/*
+    Name: I2C_timing.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/frequency.hpp>
+
+namespace soc {
+
+//
+// TIMINGR solver of the STM32 I2C peripheral (the one with TIMINGR - L0, L4 and alike), after the formulas in
+// RM0394 "I2C timings" and the I2C-bus specification (UM10204, table 10). All the arithmetic is integer
+// picoseconds, so 'calculate' is usable both in a constant expression and at runtime.
+//
+class I2C_timing
+{
+public:
+
+    struct Bus
+    {
+        // up to 100 kHz standard mode, up to 400 kHz fast mode, up to 1 MHz fast mode plus
+        cml::frequency scl_frequency_hz = cml::kHz(100);
+
+        // of the board, measured or estimated from the bus capacitance and the pull-ups
+        uint32_t rise_time_ns = 0;
+        uint32_t fall_time_ns = 0;
+
+        // CR1 ANFOFF (inverted) and DNF, have to match the peripheral configuration
+        bool analog_filter      = true;
+        uint32_t digital_filter = 0;
+    };
+
+    struct Result
+    {
+        bool valid = false;
+
+        uint32_t presc  = 0;
+        uint32_t scldel = 0;
+        uint32_t sdadel = 0;
+        uint32_t sclh   = 0;
+        uint32_t scll   = 0;
+
+        constexpr uint32_t get_timingr() const
+        {
+            return (this->presc << 28u) | (this->scldel << 20u) | (this->sdadel << 16u) | (this->sclh << 8u) |
+                   this->scll;
+        }
+    };
+
+public:
+
+    I2C_timing()                  = delete;
+    I2C_timing(I2C_timing&&)      = delete;
+    I2C_timing(const I2C_timing&) = delete;
+
+    I2C_timing& operator = (I2C_timing&&)      = delete;
+    I2C_timing& operator = (const I2C_timing&) = delete;
+
+    //
+    // Searches every prescaler that meets the data setup / hold times for the SCL low and high periods giving
+    // the frequency closest to, but not above, 'a_bus.scl_frequency_hz' (at most 20% below it). Out of equally
+    // close solutions the lowest prescaler wins, then the longest low period. Result::valid is false when
+    // the kernel clock is too slow for the bus or too fast for the prescaler.
+    //
+    static constexpr Result calculate(cml::frequency a_clock_frequency_hz, const Bus& a_bus)
+    {
+        Result ret;
+
+        const Spec spec = get_spec(a_bus.scl_frequency_hz);
+
+        if (0 == a_clock_frequency_hz || 0 == spec.scl_frequency_max_hz || a_bus.digital_filter > 15u ||
+            a_bus.rise_time_ns > spec.rise_time_max_ns || a_bus.fall_time_ns > spec.fall_time_max_ns)
+        {
+            return ret;
+        }
+
+        const int64_t clock    = ps_per_s / a_clock_frequency_hz;
+        const int64_t rise     = a_bus.rise_time_ns * ps_per_ns;
+        const int64_t fall     = a_bus.fall_time_ns * ps_per_ns;
+        const int64_t af_min   = true == a_bus.analog_filter ? analog_filter_delay_min_ns * ps_per_ns : 0;
+        const int64_t af_max   = true == a_bus.analog_filter ? analog_filter_delay_max_ns * ps_per_ns : 0;
+        const int64_t dnf      = a_bus.digital_filter * clock;
+        const int64_t sync     = af_min + dnf + 2 * clock;
+        const int64_t low_min  = spec.low_min_ns * ps_per_ns;
+        const int64_t high_min = spec.high_min_ns * ps_per_ns;
+
+        const int64_t scldel_min = rise + spec.data_setup_min_ns * ps_per_ns;
+        const int64_t sdadel_min = spec.data_hold_min_ns * ps_per_ns + fall - af_min - dnf - 3 * clock;
+        const int64_t sdadel_max = spec.data_valid_max_ns * ps_per_ns - rise - af_max - dnf - 4 * clock;
+
+        const int64_t period_min = ps_per_s / a_bus.scl_frequency_hz;
+        const int64_t period_max = period_min * 5 / 4;
+
+        int64_t error = period_max - period_min + 1;
+
+        for (uint32_t presc = 0; presc < 16u; presc++)
+        {
+            const int64_t tpresc = (presc + 1) * clock;
+
+            uint32_t scldel = 0;
+            while (scldel < 16u && (scldel + 1) * tpresc < scldel_min)
+            {
+                scldel++;
+            }
+
+            uint32_t sdadel = 0;
+            while (sdadel < 16u && false == is_in_range((sdadel * (presc + 1) + 1) * clock, sdadel_min, sdadel_max))
+            {
+                sdadel++;
+            }
+
+            if (16u == scldel || 16u == sdadel)
+            {
+                continue;
+            }
+
+            for (uint32_t scll = 256u; scll > 0; scll--)
+            {
+                const int64_t low = scll * tpresc + sync;
+
+                if (low < low_min || clock * 4 >= low - af_min - dnf)
+                {
+                    continue;
+                }
+
+                // the shortest high period keeping the SCL period at least 'period_min'
+                int64_t high = high_min > clock + 1 ? high_min : clock + 1;
+
+                if (low + high + rise + fall < period_min)
+                {
+                    high = period_min - low - rise - fall;
+                }
+
+                int64_t sclh = (high - sync + tpresc - 1) / tpresc;
+
+                if (sclh < 1)
+                {
+                    sclh = 1;
+                }
+
+                if (sclh > 256)
+                {
+                    break;
+                }
+
+                const int64_t period = low + sclh * tpresc + sync + rise + fall;
+
+                if (period <= period_max && period - period_min < error)
+                {
+                    error      = period - period_min;
+                    ret.valid  = true;
+                    ret.presc  = presc;
+                    ret.scldel = scldel;
+                    ret.sdadel = sdadel;
+                    ret.sclh   = static_cast<uint32_t>(sclh - 1);
+                    ret.scll   = scll - 1u;
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    //
+    // SCL frequency on the bus with 'a_timingr' (CubeMX output or one from 'calculate'), with the same model
+    // of the synchronization delays 'calculate' uses.
+    //
+    static constexpr cml::frequency get_scl_frequency_hz(cml::frequency a_clock_frequency_hz,
+                                                         const Bus& a_bus,
+                                                         uint32_t a_timingr)
+    {
+        if (0 == a_clock_frequency_hz)
+        {
+            return 0;
+        }
+
+        const int64_t clock  = ps_per_s / a_clock_frequency_hz;
+        const int64_t tpresc = ((a_timingr >> 28u) + 1) * clock;
+        const int64_t sync   = (true == a_bus.analog_filter ? analog_filter_delay_min_ns * ps_per_ns : 0) +
+                               a_bus.digital_filter * clock + 2 * clock;
+
+        const int64_t period = (((a_timingr >> 8u) & 0xFFu) + 1) * tpresc + ((a_timingr & 0xFFu) + 1) * tpresc +
+                               2 * sync + (a_bus.rise_time_ns + a_bus.fall_time_ns) * ps_per_ns;
+
+        return static_cast<cml::frequency>((ps_per_s + period / 2) / period);
+    }
+
+private:
+
+    // I2C-bus specification limits of a mode
+    struct Spec
+    {
+        cml::frequency scl_frequency_max_hz = 0;
+
+        uint32_t low_min_ns        = 0;
+        uint32_t high_min_ns       = 0;
+        uint32_t data_setup_min_ns = 0;
+        uint32_t data_hold_min_ns  = 0;
+        uint32_t data_valid_max_ns = 0;
+        uint32_t rise_time_max_ns  = 0;
+        uint32_t fall_time_max_ns  = 0;
+    };
+
+private:
+
+    static constexpr Spec get_spec(cml::frequency a_scl_frequency_hz)
+    {
+        if (0 == a_scl_frequency_hz)
+        {
+            return Spec();
+        }
+
+        if (a_scl_frequency_hz <= cml::kHz(100))
+        {
+            return { cml::kHz(100), 4700u, 4000u, 250u, 0u, 3450u, 1000u, 300u };
+        }
+
+        if (a_scl_frequency_hz <= cml::kHz(400))
+        {
+            return { cml::kHz(400), 1300u, 600u, 100u, 0u, 900u, 300u, 300u };
+        }
+
+        if (a_scl_frequency_hz <= cml::MHz(1))
+        {
+            return { cml::MHz(1), 500u, 260u, 50u, 0u, 450u, 120u, 120u };
+        }
+
+        return Spec();
+    }
+
+    static constexpr bool is_in_range(int64_t a_value, int64_t a_min, int64_t a_max)
+    {
+        return a_value >= a_min && a_value <= a_max;
+    }
+
+private:
+
+    static constexpr int64_t ps_per_s  = 1000000000000ll;
+    static constexpr int64_t ps_per_ns = 1000ll;
+
+    // tAF of the analog filter, see the datasheet "I2C analog filter characteristics"
+    static constexpr int64_t analog_filter_delay_min_ns = 50ll;
+    static constexpr int64_t analog_filter_delay_max_ns = 260ll;
+};
+
+} // namespace soc
@@ -6,7 +6,7 @@
 */
 
 //this
-#include <soc/interrupt_guard.hpp>
+#include <soc/Interrupt_guard.hpp>
 
 //externals
 #ifdef STM32L452xx
@@ -17,8 +17,27 @@
 #include <stm32l0xx.h>
 #endif
 
+#ifdef CML_HOST
+#include <soc/host/simulation.hpp>
+#endif
+
 namespace soc {
 
+#ifdef CML_HOST
+
+Interrupt_guard::Interrupt_guard()
+    : primask(host::simulation::get_primask())
+{
+    host::simulation::set_primask(1u);
+}
+
+Interrupt_guard::~Interrupt_guard()
+{
+    host::simulation::set_primask(this->primask);
+}
+
+#else
+
 Interrupt_guard::Interrupt_guard()
     : primask(__get_PRIMASK())
 {
@@ -30,4 +49,6 @@ Interrupt_guard::~Interrupt_guard()
     __set_PRIMASK(this->primask);
 }
 
+#endif // CML_HOST
+
 } // namespace soc
@@ -0,0 +1,137 @@
+#pragma once
+
+/*
+    Name: Out_pin.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/bit.hpp>
+
+namespace soc {
+
+//
+// Output pins over a compile-time port 'Port_t' (GPIO_t of a SoC: static 'get_registers' with the STM32 GPIO
+// layout and 'Pin_level'). Only drive the level - clock and configuration stay with GPIO::enable and
+// pin::out::enable. Every write is a single BSRR / BRR store, so it never races with writes to other pins of
+// the port done from interrupts.
+//
+template<typename Port_t, uint8_t id_t>
+class Out_pin_t
+{
+public:
+
+    static_assert(id_t < 16);
+
+    static constexpr uint32_t mask = 0x1u << id_t;
+
+public:
+
+    static void set_high()
+    {
+        Port_t::get_registers()->BSRR = mask;
+    }
+
+    static void set_low()
+    {
+        Port_t::get_registers()->BRR = mask;
+    }
+
+    static void set_level(typename Port_t::Pin_level a_level)
+    {
+        Port_t::get_registers()->BSRR = Port_t::Pin_level::high == a_level ? mask : mask << 16u;
+    }
+
+    static void toggle_level()
+    {
+        const uint32_t odr = Port_t::get_registers()->ODR;
+        Port_t::get_registers()->BSRR = ((odr & mask) << 16u) | (~odr & mask);
+    }
+
+    static typename Port_t::Pin_level get_level()
+    {
+        const uint32_t idr = Port_t::get_registers()->IDR;
+        return static_cast<typename Port_t::Pin_level>(cml::is_bit(idr, id_t));
+    }
+
+private:
+
+    Out_pin_t()                 = delete;
+    Out_pin_t(Out_pin_t&&)      = delete;
+    Out_pin_t(const Out_pin_t&) = delete;
+    ~Out_pin_t()                = default;
+
+    Out_pin_t& operator = (Out_pin_t&&)      = delete;
+    Out_pin_t& operator = (const Out_pin_t&) = delete;
+};
+
+//
+// Several output pins of one port updated with one BSRR store. Bit 'n' of 'a_levels' drives the n-th pin
+// of the list, e.g. Out_pin_group_t<GPIO_t<GPIO::Id::b>, 4, 2, 7>::set_levels(0x5u) sets PB4 and PB7 high,
+// PB2 low.
+//
+template<typename Port_t, uint8_t... ids_t>
+class Out_pin_group_t
+{
+public:
+
+    static_assert(sizeof...(ids_t) > 0);
+    static_assert(((ids_t < 16) && ...));
+
+    static constexpr uint32_t mask = ((0x1u << ids_t) | ...);
+
+    static_assert(sizeof...(ids_t) == static_cast<uint32_t>(__builtin_popcount(mask)), "pin listed twice");
+
+public:
+
+    static void set_high()
+    {
+        Port_t::get_registers()->BSRR = mask;
+    }
+
+    static void set_low()
+    {
+        Port_t::get_registers()->BRR = mask;
+    }
+
+    static void set_levels(uint32_t a_levels)
+    {
+        const uint32_t high = to_port_bits(a_levels);
+        Port_t::get_registers()->BSRR = ((~high & mask) << 16u) | high;
+    }
+
+    static void toggle_levels()
+    {
+        const uint32_t odr = Port_t::get_registers()->ODR;
+        Port_t::get_registers()->BSRR = ((odr & mask) << 16u) | (~odr & mask);
+    }
+
+private:
+
+    static uint32_t to_port_bits(uint32_t a_levels)
+    {
+        uint32_t ret = 0;
+        uint32_t i   = 0;
+
+        ((ret |= ((a_levels >> i++) & 0x1u) << ids_t), ...);
+
+        return ret;
+    }
+
+private:
+
+    Out_pin_group_t()                       = delete;
+    Out_pin_group_t(Out_pin_group_t&&)      = delete;
+    Out_pin_group_t(const Out_pin_group_t&) = delete;
+    ~Out_pin_group_t()                      = default;
+
+    Out_pin_group_t& operator = (Out_pin_group_t&&)      = delete;
+    Out_pin_group_t& operator = (const Out_pin_group_t&) = delete;
+};
+
+} // namespace soc
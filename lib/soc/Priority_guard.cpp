@@ -0,0 +1,91 @@
+/*
+    Name: Priority_guard.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/Priority_guard.hpp>
+
+//externals
+#ifdef STM32L452xx
+#include <stm32l4xx.h>
+#endif
+
+#ifdef STM32L011xx
+#include <stm32l0xx.h>
+#endif
+
+#ifdef CML_HOST
+#include <soc/host/simulation.hpp>
+#endif
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace soc {
+
+#ifdef STM32L452xx
+
+Priority_guard::Priority_guard(uint32_t a_priority)
+    : basepri(__get_BASEPRI())
+    , primask(__get_PRIMASK())
+{
+    assert(a_priority < (1u << __NVIC_PRIO_BITS));
+
+    // BASEPRI of 0 masks nothing - the most urgent level can only be held off with PRIMASK
+    if (0 == a_priority)
+    {
+        __disable_irq();
+    }
+    else
+    {
+        __set_BASEPRI_MAX(a_priority << (8u - __NVIC_PRIO_BITS));
+    }
+}
+
+Priority_guard::~Priority_guard()
+{
+    __set_PRIMASK(this->primask);
+    __set_BASEPRI(this->basepri);
+}
+
+#endif // STM32L452xx
+
+#ifdef STM32L011xx
+
+Priority_guard::Priority_guard(uint32_t a_priority)
+    : basepri(0)
+    , primask(__get_PRIMASK())
+{
+    assert(a_priority < (1u << __NVIC_PRIO_BITS));
+
+    // no BASEPRI on Cortex-M0+
+    __disable_irq();
+}
+
+Priority_guard::~Priority_guard()
+{
+    __set_PRIMASK(this->primask);
+}
+
+#endif // STM32L011xx
+
+#ifdef CML_HOST
+
+Priority_guard::Priority_guard(uint32_t)
+    : basepri(0)
+    , primask(host::simulation::get_primask())
+{
+    host::simulation::set_primask(1u);
+}
+
+Priority_guard::~Priority_guard()
+{
+    host::simulation::set_primask(this->primask);
+}
+
+#endif // CML_HOST
+
+} // namespace soc
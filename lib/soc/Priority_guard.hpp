@@ -0,0 +1,43 @@
+#pragma once
+
+/*
+    Name: Priority_guard.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+namespace soc {
+
+//
+// Critical section against interrupts of priority 'a_priority' and lower (NVIC_SetPriority values equal to or
+// greater than it) - more urgent interrupts keep running. 'a_priority' is the value the drivers take as
+// 'a_irq_priority', so guarding against a driver's own interrupt is Priority_guard(NVIC_GetPriority(irqn)).
+//
+// Raises BASEPRI on cores that have it (only ever raises it, so guards nest). On Cortex-M0+ and for priority 0
+// it masks all interrupts with PRIMASK, same as Interrupt_guard.
+//
+class Priority_guard
+{
+public:
+
+    explicit Priority_guard(uint32_t a_priority);
+    ~Priority_guard();
+
+    Priority_guard()                      = delete;
+    Priority_guard(Priority_guard&&)      = delete;
+    Priority_guard(const Priority_guard&) = delete;
+
+    Priority_guard& operator = (Priority_guard&&)      = delete;
+    Priority_guard& operator = (const Priority_guard&) = delete;
+
+private:
+
+    uint32_t basepri;
+    uint32_t primask;
+};
+
+} // namespace soc
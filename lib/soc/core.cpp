@@ -0,0 +1,56 @@
+/*
+    Name: core.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/core.hpp>
+
+//externals
+#ifdef STM32L452xx
+#include <stm32l4xx.h>
+#endif
+
+#ifdef STM32L011xx
+#include <stm32l0xx.h>
+#endif
+
+#ifdef CML_HOST
+#include <soc/host/simulation.hpp>
+#endif
+
+//soc
+#ifndef CML_DWT_PRESENT
+#include <soc/systick.hpp>
+#endif
+
+namespace soc {
+
+void core::wait_for_interrupt()
+{
+#ifdef CML_HOST
+    // the simulated interrupts run right away, as if the guard had been released for a tick
+    const uint32_t primask = host::simulation::get_primask();
+
+    host::simulation::set_primask(0);
+    host::simulation::advance(1);
+    host::simulation::set_primask(primask);
+#else
+    __DSB();
+    __WFI();
+    __ISB();
+#endif // CML_HOST
+}
+
+uint32_t core::get_cycle_counter()
+{
+#ifdef CML_DWT_PRESENT
+    return DWT->CYCCNT;
+#else
+    return static_cast<uint32_t>(systick::get_cycles());
+#endif // CML_DWT_PRESENT
+}
+
+} // namespace soc
@@ -0,0 +1,44 @@
+#pragma once
+
+/*
+    Name: core.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+namespace soc {
+
+class core
+{
+public:
+
+    //
+    // Sleeps (WFI) until an interrupt is pending. Works with interrupts masked by Interrupt_guard too - the core
+    // still wakes up and the handler runs once the guard is released, so a check of "anything to do?" followed
+    // by this call under one guard cannot miss a wake-up.
+    //
+    static void wait_for_interrupt();
+
+    //
+    // Free running 32-bit core clock cycle counter, for measuring durations (wraps around every 2^32 cycles).
+    // DWT->CYCCNT on cores with a DWT (CML_DWT_PRESENT, enabled with mcu::enable_dwt), the systick count
+    // otherwise - then it needs the systick running.
+    //
+    static uint32_t get_cycle_counter();
+
+private:
+
+    core()            = delete;
+    core(core&&)      = delete;
+    core(const core&) = delete;
+    ~core()           = default;
+
+    core& operator = (core&&)      = delete;
+    core& operator = (const core&) = delete;
+};
+
+} // namespace soc
@@ -0,0 +1,221 @@
+/*
+    Name: ADC.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#ifdef CML_HOST
+
+//this
+#include <soc/host/peripherals/ADC.hpp>
+
+//std
+#include <cstdio>
+
+//soc
+#include <soc/Interrupt_guard.hpp>
+#include <soc/host/simulation.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace soc {
+namespace host {
+namespace peripherals {
+
+using namespace cml;
+
+void adc_interrupt_handler(void* a_p_this)
+{
+    assert(nullptr != a_p_this);
+
+    ADC* p_this = static_cast<ADC*>(a_p_this);
+
+    if (nullptr != p_this->callback.function && p_this->active_channels_count > 0)
+    {
+        const uint16_t value  = p_this->convert();
+        const bool series_end = 0 == p_this->sequence_index;
+
+        const bool ret = p_this->callback.function(value, series_end, p_this->callback.p_user_data);
+
+        // same as the target: the sequence stops after its end or when the callback refuses more data
+        if (true == series_end || false == ret)
+        {
+            p_this->callback = { nullptr, nullptr };
+        }
+    }
+}
+
+bool ADC::enable(Resolution a_resolution, const Asynchronous_clock& a_clock, uint32_t, time::tick a_timeout)
+{
+    assert(Asynchronous_clock::Divider::unknown != a_clock.divider);
+    assert(a_timeout > 0);
+
+    return this->enable(a_resolution);
+}
+
+bool ADC::enable(Resolution a_resolution, const Synchronous_clock& a_clock, uint32_t, time::tick a_timeout)
+{
+    assert(Synchronous_clock::Divider::unknown != a_clock.divider);
+    assert(a_timeout > 0);
+
+    return this->enable(a_resolution);
+}
+
+void ADC::disable()
+{
+    simulation::unregister_interrupt_handler(this);
+
+    this->callback = { nullptr, nullptr };
+    this->enabled  = false;
+}
+
+void ADC::set_active_channels(const Channel* a_p_channels, uint32_t a_channels_count)
+{
+    assert(true == this->enabled);
+    assert(nullptr != a_p_channels);
+    assert(a_channels_count > 0 && a_channels_count <= max_active_channels);
+
+    for (uint32_t i = 0; i < a_channels_count; i++)
+    {
+        assert(Channel::Id::unknown != a_p_channels[i].id);
+        this->channels[i] = a_p_channels[i];
+    }
+
+    this->active_channels_count = a_channels_count;
+    this->sequence_index        = 0;
+}
+
+void ADC::clear_active_channels()
+{
+    assert(true == this->enabled);
+
+    this->active_channels_count = 0;
+    this->sequence_index        = 0;
+}
+
+void ADC::read_polling(uint16_t* a_p_data, uint32_t a_count)
+{
+    assert(true == this->enabled);
+    assert(nullptr != a_p_data);
+    assert(a_count > 0);
+
+    assert(this->get_active_channels_count() == a_count);
+
+    for (uint32_t i = 0; i < a_count; i++)
+    {
+        a_p_data[i] = this->convert();
+    }
+}
+
+bool ADC::read_polling(uint16_t* a_p_data, uint32_t a_count, time::tick a_timeout)
+{
+    assert(a_timeout > 0);
+
+    this->read_polling(a_p_data, a_count);
+    return true;
+}
+
+void ADC::register_conversion_callback(const Conversion_callback& a_callback)
+{
+    assert(true == this->enabled);
+    assert(nullptr != a_callback.function);
+
+    Interrupt_guard guard;
+
+    this->callback       = a_callback;
+    this->sequence_index = 0;
+}
+
+void ADC::unregister_conversion_callback()
+{
+    assert(true == this->enabled);
+
+    Interrupt_guard guard;
+
+    this->callback = { nullptr, nullptr };
+}
+
+void ADC::set_resolution(Resolution a_resolution)
+{
+    this->resolution = a_resolution;
+}
+
+void ADC::set_samples(const uint16_t* a_p_samples, uint32_t a_count)
+{
+    assert(nullptr != a_p_samples || 0 == a_count);
+    assert(a_count <= max_samples);
+
+    for (uint32_t i = 0; i < a_count && i < max_samples; i++)
+    {
+        this->samples[i] = a_p_samples[i];
+    }
+
+    this->samples_count = a_count < max_samples ? a_count : max_samples;
+    this->sample_index  = 0;
+}
+
+uint32_t ADC::load_samples(const char* a_p_path)
+{
+    assert(nullptr != a_p_path);
+
+    FILE* p_file = fopen(a_p_path, "r");
+
+    if (nullptr == p_file)
+    {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    unsigned int value = 0;
+
+    while (count < max_samples && 1 == fscanf(p_file, "%u", &value))
+    {
+        this->samples[count++] = static_cast<uint16_t>(value);
+    }
+
+    fclose(p_file);
+
+    this->samples_count = count;
+    this->sample_index  = 0;
+
+    return count;
+}
+
+bool ADC::enable(Resolution a_resolution)
+{
+    assert(false == this->enabled);
+
+    this->enabled    = true;
+    this->resolution = a_resolution;
+
+    simulation::register_interrupt_handler({ adc_interrupt_handler, this });
+
+    return true;
+}
+
+uint16_t ADC::convert()
+{
+    const uint32_t max = 0xFFFu >> (static_cast<uint32_t>(this->resolution) * 2u);
+    uint32_t value     = 0;
+
+    if (this->samples_count > 0)
+    {
+        value = this->samples[this->sample_index];
+        this->sample_index = (this->sample_index + 1u) % this->samples_count;
+    }
+
+    if (this->active_channels_count > 0)
+    {
+        this->sequence_index = (this->sequence_index + 1u) % this->active_channels_count;
+    }
+
+    return static_cast<uint16_t>(value < max ? value : max);
+}
+
+} // namespace peripherals
+} // namespace host
+} // namespace soc
+
+#endif // CML_HOST
@@ -0,0 +1,257 @@
+#pragma once
+
+/*
+    Name: ADC.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/Non_copyable.hpp>
+#include <cml/time.hpp>
+
+namespace soc {
+namespace host {
+namespace peripherals {
+
+//
+// ADC model for the host port, same interface as the target driver. Conversions return scripted samples
+// ('set_samples' / 'load_samples') in order, wrapping around at the end. Interrupt mode delivers one
+// conversion per host::simulation pass.
+//
+class ADC : private cml::Non_copyable
+{
+public:
+
+    enum class Id : uint32_t
+    {
+        _1 = 0u
+    };
+
+    enum class Resolution : uint32_t
+    {
+        _6_bit  = 0x3u,
+        _8_bit  = 0x2u,
+        _10_bit = 0x1u,
+        _12_bit = 0u,
+    };
+
+    struct Channel
+    {
+        enum class Id : uint32_t
+        {
+            voltage_reference,
+            _1,
+            _2,
+            _3,
+            _4,
+            _5,
+            _6,
+            _7,
+            _8,
+            _9,
+            _10,
+            _11,
+            _12,
+            _13,
+            _14,
+            _15,
+            _16,
+            temperature_sensor,
+            battery_voltage,
+            unknown
+        };
+
+        enum class Sampling_time : uint32_t
+        {
+            _2_5_clock_cycles   = 0x0u,
+            _6_5_clock_cycles   = 0x1u,
+            _12_5_clock_cycles  = 0x2u,
+            _24_5_clock_cycles  = 0x3u,
+            _47_5_clock_cycles  = 0x4u,
+            _92_5_clock_cycles  = 0x5u,
+            _247_5_clock_cycles = 0x6u,
+            _640_5_clock_cycles = 0x7u,
+            unknown
+        };
+
+        Id id                       = Id::unknown;
+        Sampling_time sampling_time = Sampling_time::unknown;
+    };
+
+    struct Synchronous_clock
+    {
+        enum class Divider : uint32_t
+        {
+            _1 = 0x1u,
+            _2 = 0x2u,
+            _4 = 0x3u,
+            unknown
+        };
+
+        enum class Source
+        {
+            pclk,
+            unknown
+        };
+
+        Source source   = Source::unknown;
+        Divider divider = Divider::unknown;
+    };
+
+    struct Asynchronous_clock
+    {
+        enum class Divider : uint32_t
+        {
+            _1   = 0x0u,
+            _2   = 0x1u,
+            _4   = 0x2u,
+            _6   = 0x3u,
+            _8   = 0x4u,
+            _10  = 0x5u,
+            _12  = 0x6u,
+            _16  = 0x7u,
+            _32  = 0x8u,
+            _64  = 0x9u,
+            _128 = 0xAu,
+            _256 = 0xBu,
+            unknown
+        };
+
+        enum class Source
+        {
+            pllsai,
+            unknown
+        };
+
+        Source source   = Source::unknown;
+        Divider divider = Divider::unknown;
+    };
+
+    struct Calibration_data
+    {
+        uint16_t temperature_sensor_data_1  = 0;
+        uint16_t temperature_sensor_data_2  = 0;
+        uint16_t internal_voltage_reference = 0;
+    };
+
+    struct Conversion_callback
+    {
+        using Function = bool(*)(uint16_t a_value, bool a_series_end, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    static constexpr uint32_t max_samples         = 4096u;
+    static constexpr uint32_t max_active_channels = 16u;
+
+public:
+
+    ADC(Id)
+        : enabled(false)
+        , resolution(Resolution::_12_bit)
+        , active_channels_count(0)
+        , sequence_index(0)
+        , samples_count(0)
+        , sample_index(0)
+        , calibration_data{ 1034u, 1366u, 1655u }
+    {}
+
+    ~ADC()
+    {
+        if (true == this->enabled)
+        {
+            this->disable();
+        }
+    }
+
+    bool enable(Resolution a_resolution,
+                const Asynchronous_clock& a_clock,
+                uint32_t a_irq_priority,
+                cml::time::tick a_timeout);
+
+    bool enable(Resolution a_resolution,
+                const Synchronous_clock& a_clock,
+                uint32_t a_irq_priority,
+                cml::time::tick a_timeout);
+
+    void disable();
+
+    void set_active_channels(const Channel* a_p_channels, uint32_t a_channels_count);
+    void clear_active_channels();
+
+    void read_polling(uint16_t* a_p_data, uint32_t a_count);
+    bool read_polling(uint16_t* a_p_data, uint32_t a_count, cml::time::tick a_timeout);
+
+    void register_conversion_callback(const Conversion_callback& a_callback);
+    void unregister_conversion_callback();
+
+    void set_resolution(Resolution a_resolution);
+
+    //
+    // Samples are raw values at the current resolution (clamped to its range), one per conversion.
+    //
+    void set_samples(const uint16_t* a_p_samples, uint32_t a_count);
+
+    //
+    // Text file with whitespace separated unsigned decimal samples, returns the number loaded (0 on error).
+    //
+    uint32_t load_samples(const char* a_p_path);
+
+    //
+    // Defaults are typical STM32L4 factory values.
+    //
+    void set_calibration_data(const Calibration_data& a_calibration_data)
+    {
+        this->calibration_data = a_calibration_data;
+    }
+
+    uint32_t get_active_channels_count() const
+    {
+        return this->active_channels_count;
+    }
+
+    const Calibration_data& get_calibration_data() const
+    {
+        return this->calibration_data;
+    }
+
+    constexpr Id get_id() const
+    {
+        return Id::_1;
+    }
+
+private:
+
+    bool enable(Resolution a_resolution);
+    uint16_t convert();
+
+private:
+
+    bool enabled;
+    Resolution resolution;
+
+    Channel channels[max_active_channels];
+    uint32_t active_channels_count;
+    uint32_t sequence_index;
+
+    uint16_t samples[max_samples];
+    uint32_t samples_count;
+    uint32_t sample_index;
+
+    Conversion_callback callback;
+    Calibration_data calibration_data;
+
+private:
+
+    friend void adc_interrupt_handler(void* a_p_this);
+};
+
+} // namespace peripherals
+} // namespace host
+} // namespace soc
@@ -0,0 +1,575 @@
+#pragma once
+
+/*
+    Name: GPIO.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/bit.hpp>
+#include <cml/Non_copyable.hpp>
+#include <cml/debug/assert.hpp>
+
+//soc
+#include <soc/Out_pin.hpp>
+
+namespace soc {
+namespace host {
+namespace peripherals {
+
+class GPIO;
+
+struct pin
+{
+    pin()            = delete;
+    pin(pin&&)       = delete;
+    pin(const pin&&) = delete;
+
+    pin& operator = (pin&&)      = delete;
+    pin& operator = (const pin&) = delete;
+
+    enum class Level : uint32_t
+    {
+        low  = 0x0u,
+        high = 0x1u
+    };
+
+    enum class Mode : uint32_t
+    {
+        push_pull  = 0,
+        open_drain = 1,
+        unknown
+    };
+
+    enum class Pull : uint32_t
+    {
+        none    = 0x0u,
+        up      = 0x1u,
+        down    = 0x2u,
+        unknown
+    };
+
+    enum class Speed : uint32_t
+    {
+        low     = 0x0u,
+        medium  = 0x1u,
+        high    = 0x2u,
+        ultra   = 0x3u,
+        unknown
+    };
+
+    class in;
+    class out;
+    class analog;
+    class af;
+
+    class In : private cml::Non_copyable
+    {
+    public:
+
+        In()
+            : p_port(nullptr)
+            , id(0xFF)
+        {}
+        ~In() = default;
+
+        void set_pull(Pull a_pull);
+
+        Pull  get_pull() const;
+        Level get_level() const;
+
+        GPIO* get_port() const
+        {
+            return this->p_port;
+        }
+
+        uint8_t get_id() const
+        {
+            return this->id;
+        }
+
+    private:
+
+        GPIO* p_port;
+        uint8_t id;
+
+    private:
+
+        friend class pin::in;
+    };
+
+    class Out : private cml::Non_copyable
+    {
+    public:
+
+        Out()
+            : p_port(nullptr)
+            , id(0xFF)
+        {}
+        ~Out() = default;
+
+        void set_level(Level a_level);
+        void toggle_level();
+
+        void set_mode(Mode a_mode);
+        void set_pull(Pull a_pull);
+        void set_speed(Speed a_speed);
+
+        Level get_level() const;
+        Mode  get_mode()  const;
+        Pull  get_pull()  const;
+        Speed get_speed() const;
+
+        GPIO* get_port() const
+        {
+            return this->p_port;
+        }
+
+        uint8_t get_id() const
+        {
+            return this->id;
+        }
+
+    private:
+
+        GPIO* p_port;
+        uint8_t id;
+
+    private:
+
+        friend pin::out;
+    };
+
+    class Analog
+    {
+    public:
+
+        Analog()
+            : p_port(nullptr)
+            , id(0xFF)
+        {}
+
+        ~Analog() = default;
+
+        void set_pull(Pull a_pull);
+
+        Pull get_pull() const;
+
+        GPIO* get_port() const
+        {
+            return this->p_port;
+        }
+
+        uint8_t get_id() const
+        {
+            return this->id;
+        }
+
+    private:
+
+        GPIO* p_port;
+        uint8_t id;
+
+    private:
+
+        friend pin::analog;
+    };
+
+    class Af
+    {
+    public:
+
+        Af()
+            : p_port(nullptr)
+            , id(0xFF)
+        {}
+
+        ~Af() = default;
+
+        void set_mode(Mode a_mode);
+        void set_pull(Pull a_pull);
+        void set_speed(Speed a_speed);
+        void set_function(uint32_t a_function);
+
+        Mode  get_mode()  const;
+        Pull  get_pull()  const;
+        Speed get_speed() const;
+
+        uint32_t get_function() const
+        {
+            return this->function;
+        }
+
+        GPIO* get_port() const
+        {
+            return this->p_port;
+        }
+
+        uint8_t get_id() const
+        {
+            return this->id;
+        }
+
+    private:
+
+        GPIO* p_port;
+        uint8_t id;
+
+        uint32_t function;
+
+    private:
+
+        friend af;
+    };
+
+    class in
+    {
+    public:
+
+        in()           = delete;
+        in(in&&)       = delete;
+        in(const in&&) = delete;
+
+        in& operator = (in&&)      = delete;
+        in& operator = (const in&) = delete;
+
+        static void enable(GPIO* a_p_port, uint32_t a_id, Pull a_pull, In* a_p_out_pin = nullptr);
+        static void disable(GPIO* a_p_port, uint32_t a_id);
+
+        static void disable(In* p_pin)
+        {
+            disable(p_pin->get_port(), p_pin->get_id());
+
+            p_pin->p_port = nullptr;
+            p_pin->id     = 0xFF;
+        }
+    };
+
+    class out
+    {
+    public:
+
+        struct Config
+        {
+            Mode  mode = Mode::unknown;
+            Pull  pull = Pull::unknown;
+            Speed speed = Speed::unknown;
+        };
+
+    public:
+
+        out()            = delete;
+        out(out&&)       = delete;
+        out(const out&&) = delete;
+
+        out& operator = (out&&)      = delete;
+        out& operator = (const out&) = delete;
+
+        static void enable(GPIO* a_p_port, uint32_t a_id, const Config& a_config, Out* a_p_out_pin = nullptr);
+        static void disable(GPIO* a_p_port, uint32_t a_id);
+
+        static void disable(Out* p_pin)
+        {
+            disable(p_pin->get_port(), p_pin->get_id());
+
+            p_pin->p_port = nullptr;
+            p_pin->id     = 0xFF;
+        }
+    };
+
+    class analog
+    {
+    public:
+
+        analog()               = delete;
+        analog(analog&&)       = delete;
+        analog(const analog&&) = delete;
+
+        analog& operator = (analog&&)      = delete;
+        analog& operator = (const analog&) = delete;
+
+        static void enable(GPIO* a_p_port, uint32_t a_id, Pull a_pull, Analog* a_p_out_pin = nullptr);
+        static void disable(GPIO* a_p_port, uint32_t a_id);
+
+        static void disable(Analog* p_pin)
+        {
+            disable(p_pin->get_port(), p_pin->get_id());
+
+            p_pin->p_port = nullptr;
+            p_pin->id     = 0xFF;
+        }
+    };
+
+    class af
+    {
+    public:
+
+        struct Config
+        {
+            Mode mode   = Mode::unknown;
+            Pull pull   = Pull::unknown;
+            Speed speed = Speed::unknown;
+
+            uint32_t function = 0;
+        };
+
+    public:
+
+        af()           = delete;
+        af(af&&)       = delete;
+        af(const af&&) = delete;
+
+        af& operator = (af&&)      = delete;
+        af& operator = (const af&) = delete;
+
+        static void enable(GPIO* a_p_port, uint32_t a_id, const Config& a_config, Af* a_p_out_pin = nullptr);
+        static void disable(GPIO* a_p_port, uint32_t a_id);
+
+        static void disable(Af* p_pin)
+        {
+            disable(p_pin->get_port(), p_pin->get_id());
+
+            p_pin->p_port = nullptr;
+            p_pin->id     = 0xFF;
+        }
+    };
+};
+
+//
+// GPIO model for the host port, same interface as the target driver. Pins live in an in-memory register
+// block, input levels are scripted with 'set_input_level'; a pin configured as output reads back its ODR.
+//
+class GPIO : private cml::Non_copyable
+{
+public:
+
+    //
+    // Register block with the target layout. IDR and the write only BSRR / BRR behave as on the target,
+    // so the code driving them (Out_pin_t, Out_pin_group_t) is the one that ships.
+    //
+    struct Registers
+    {
+        // scripted input levels, pins in output mode (MODER = 01) read back ODR
+        class Input_data_register
+        {
+        public:
+
+            Input_data_register(const Registers* a_p_registers)
+                : p_registers(a_p_registers)
+                , levels(0)
+            {}
+
+            Input_data_register(const Input_data_register&) = delete;
+
+            // the levels only, the register stays with its own block
+            Input_data_register& operator = (const Input_data_register& a_other)
+            {
+                this->levels = a_other.levels;
+                return *this;
+            }
+
+            operator uint32_t() const;
+
+            void set_level(uint8_t a_id, bool a_high)
+            {
+                if (true == a_high)
+                {
+                    cml::set_bit(&(this->levels), a_id);
+                }
+                else
+                {
+                    cml::clear_bit(&(this->levels), a_id);
+                }
+            }
+
+        private:
+
+            const Registers* p_registers;
+            uint32_t levels;
+        };
+
+        // BSRR (set in the low half, reset in the high one, set wins) or BRR (reset in the low half)
+        class Set_reset_register
+        {
+        public:
+
+            Set_reset_register(uint32_t* a_p_odr, bool a_set)
+                : p_odr(a_p_odr)
+                , set(a_set)
+            {}
+
+            Set_reset_register(const Set_reset_register&) = delete;
+
+            // write only, nothing to take over
+            Set_reset_register& operator = (const Set_reset_register&)
+            {
+                return *this;
+            }
+
+            Set_reset_register& operator = (uint32_t a_value)
+            {
+                const uint32_t set_bits   = true == this->set ? a_value & 0xFFFFu : 0u;
+                const uint32_t reset_bits = true == this->set ? a_value >> 16u : a_value & 0xFFFFu;
+
+                (*(this->p_odr)) = ((*(this->p_odr)) & ~reset_bits) | set_bits;
+
+                return *this;
+            }
+
+        private:
+
+            uint32_t* p_odr;
+            bool set;
+        };
+
+        uint32_t MODER          = 0xFFFFFFFFu;
+        uint32_t OTYPER         = 0;
+        uint32_t OSPEEDR        = 0;
+        uint32_t PUPDR          = 0;
+        Input_data_register IDR = { this };
+        uint32_t ODR            = 0;
+        Set_reset_register BSRR = { &(this->ODR), true };
+        uint32_t AFR[2]         = { 0, 0 };
+        Set_reset_register BRR  = { &(this->ODR), false };
+    };
+
+    enum class Id : uint32_t
+    {
+        a = 0,
+        b = 1,
+        c = 2,
+        d = 3,
+        e = 4,
+        h = 7
+    };
+
+public:
+
+    GPIO(Id a_id)
+        : id(a_id)
+        , flags(0)
+    {}
+
+    ~GPIO()
+    {
+        this->disable();
+    }
+
+    void enable();
+    void disable();
+
+    bool is_enabled() const
+    {
+        return cml::is_bit(this->flags, 31);
+    }
+
+    Id get_id() const
+    {
+        return this->id;
+    }
+
+    bool is_pin_taken(uint8_t a_id) const
+    {
+        return cml::is_bit(this->flags, a_id);
+    }
+
+    void set_input_level(uint8_t a_id, pin::Level a_level)
+    {
+        assert(a_id < 16);
+
+        this->registers.IDR.set_level(a_id, pin::Level::high == a_level);
+    }
+
+    explicit operator Registers*()
+    {
+        return &(this->registers);
+    }
+
+private:
+
+    void take_pin(uint8_t a_id)
+    {
+        cml::set_bit(&(this->flags), a_id);
+    }
+
+    void give_pin(uint8_t a_id)
+    {
+        cml::clear_bit(&(this->flags), a_id);
+    }
+
+private:
+
+    Id id;
+
+    uint32_t flags;
+    Registers registers;
+
+private:
+
+    friend pin::in;
+    friend pin::out;
+    friend pin::analog;
+    friend pin::af;
+};
+
+//
+// Compile-time form of GPIO. The host has no fixed register addresses, so the pins below work on the
+// registers of the live GPIO_t of their port.
+//
+template<GPIO::Id id_t>
+class GPIO_t : public GPIO
+{
+public:
+
+    using Pin_level = pin::Level;
+
+public:
+
+    GPIO_t()
+        : GPIO(id_t)
+    {
+        p_instance = this;
+    }
+
+    ~GPIO_t()
+    {
+        p_instance = nullptr;
+    }
+
+    static Registers* get_registers()
+    {
+        assert(nullptr != p_instance);
+        return static_cast<Registers*>(*p_instance);
+    }
+
+private:
+
+    inline static GPIO_t* p_instance = nullptr;
+};
+
+template<GPIO::Id port_t, uint8_t id_t> using Out_pin_t = soc::Out_pin_t<GPIO_t<port_t>, id_t>;
+template<GPIO::Id port_t, uint8_t... ids_t> using Out_pin_group_t = soc::Out_pin_group_t<GPIO_t<port_t>, ids_t...>;
+
+inline GPIO::Registers::Input_data_register::operator uint32_t() const
+{
+    uint32_t outputs = 0;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        if (0x1u == ((this->p_registers->MODER >> (i * 2u)) & 0x3u))
+        {
+            outputs |= 0x1u << i;
+        }
+    }
+
+    return (this->levels & ~outputs) | (this->p_registers->ODR & outputs);
+}
+
+} // namespace peripherals
+} // namespace host
+} // namespace soc
\ No newline at end of file
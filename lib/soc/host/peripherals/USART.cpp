@@ -0,0 +1,445 @@
+/*
+    Name: USART.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#ifdef CML_HOST
+
+//this
+#include <soc/host/peripherals/USART.hpp>
+
+//std
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+//soc
+#include <soc/counter.hpp>
+#include <soc/Interrupt_guard.hpp>
+#include <soc/host/simulation.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+namespace {
+
+void set_non_blocking(int a_fd)
+{
+    const int flags = fcntl(a_fd, F_GETFL);
+
+    assert(-1 != flags);
+    fcntl(a_fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+} // namespace ::
+
+namespace soc {
+namespace host {
+namespace peripherals {
+
+using namespace cml;
+
+void usart_interrupt_handler(void* a_p_this)
+{
+    assert(nullptr != a_p_this);
+
+    USART* p_this               = static_cast<USART*>(a_p_this);
+    USART::Registers& registers = p_this->registers;
+
+    if (true == is_flag(registers.CR1, USART::cr1_rxneie) && false == is_flag(registers.ISR, USART::isr_rxne))
+    {
+        uint16_t word = 0;
+
+        if (true == p_this->read_line(&word))
+        {
+            registers.RDR = word;
+            set_flag(&(registers.ISR), USART::isr_rxne);
+
+            p_this->rx_active = true;
+        }
+        else if (true == p_this->rx_active)
+        {
+            set_flag(&(registers.ISR), USART::isr_idle);
+            p_this->rx_active = false;
+        }
+    }
+
+    if (nullptr != p_this->tx_callback.function && true == is_flag(registers.CR1, USART::cr1_txeie))
+    {
+        registers.TDR = USART::tdr_empty;
+
+        bool status        = p_this->tx_callback.function(&(registers.TDR), false, p_this->tx_callback.p_user_data);
+        const bool written = USART::tdr_empty != registers.TDR;
+
+        if (true == written)
+        {
+            p_this->write_line(registers.TDR);
+        }
+
+        if (true == status && false == written && true == is_flag(registers.CR1, USART::cr1_tcie))
+        {
+            status = p_this->tx_callback.function(nullptr, true, p_this->tx_callback.p_user_data);
+        }
+
+        if (false == status)
+        {
+            p_this->unregister_transmit_callback();
+        }
+    }
+
+    if (nullptr != p_this->rx_callback.function)
+    {
+        bool status = true;
+
+        if (true == is_flag(registers.ISR, USART::isr_rxne))
+        {
+            clear_flag(&(registers.ISR), USART::isr_rxne);
+            status = p_this->rx_callback.function(registers.RDR, false, p_this->rx_callback.p_user_data);
+        }
+        else if (true == is_flag(registers.ISR, USART::isr_idle))
+        {
+            clear_flag(&(registers.ISR), USART::isr_idle);
+            status = p_this->rx_callback.function(0x0u, true, p_this->rx_callback.p_user_data);
+        }
+
+        if (false == status)
+        {
+            p_this->unregister_receive_callback();
+        }
+    }
+
+    if (nullptr != p_this->bus_status_callback.function && true == is_flag(registers.CR1, USART::cr1_eie))
+    {
+        USART::Bus_status_flag status = p_this->take_bus_status();
+
+        if (USART::Bus_status_flag::ok != status)
+        {
+            p_this->bus_status_callback.function(status, p_this->bus_status_callback.p_user_data);
+        }
+    }
+}
+
+USART::USART(Id a_id)
+    : id(a_id)
+    , injected_bus_status(Bus_status_flag::ok)
+    , rx_active(false)
+    , input_fds{ -1, -1 }
+    , output_fds{ -1, -1 }
+{
+    const bool pipes_created = 0 == pipe(this->input_fds) && 0 == pipe(this->output_fds);
+    assert(true == pipes_created);
+
+    if (true == pipes_created)
+    {
+        set_non_blocking(this->input_fds[0]);
+        set_non_blocking(this->output_fds[0]);
+    }
+}
+
+USART::~USART()
+{
+    if (true == this->is_enabled())
+    {
+        this->disable();
+    }
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        close(this->input_fds[i]);
+        close(this->output_fds[i]);
+    }
+}
+
+bool USART::enable(const Config& a_config,
+                   const Frame_format& a_frame_format,
+                   const Clock& a_clock,
+                   uint32_t,
+                   time::tick a_timeout_ms)
+{
+    assert(false == this->is_enabled());
+
+    assert(0                          != a_config.baud_rate);
+    assert(Flow_control_flag::unknown != a_config.flow_control);
+    assert(Stop_bits::unknown         != a_config.stop_bits);
+    assert(Sampling_method::unknown   != a_config.sampling_method);
+
+    assert(Parity::unknown      != a_frame_format.parity);
+    assert(Word_length::unknown != a_frame_format.word_length);
+
+    assert(Clock::Source::unknown != a_clock.source);
+    assert(0                      != a_clock.frequency_hz);
+    assert(a_timeout_ms > 0);
+
+    this->config       = a_config;
+    this->clock        = a_clock;
+    this->frame_format = a_frame_format;
+
+    this->registers = Registers();
+    set_flag(&(this->registers.CR1), cr1_ue);
+
+    simulation::register_interrupt_handler({ usart_interrupt_handler, this });
+
+    return true;
+}
+
+void USART::disable()
+{
+    assert(true == this->is_enabled());
+
+    simulation::unregister_interrupt_handler(this);
+
+    this->tx_callback         = { nullptr, nullptr };
+    this->rx_callback         = { nullptr, nullptr };
+    this->bus_status_callback = { nullptr, nullptr };
+
+    this->registers = Registers();
+    this->rx_active = false;
+}
+
+USART::Result USART::transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_words)
+{
+    assert(true == this->is_enabled());
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_words > 0);
+
+    const Bus_status_flag bus_status = this->take_bus_status();
+
+    if (Bus_status_flag::ok != bus_status)
+    {
+        return { bus_status, 0 };
+    }
+
+    for (uint32_t i = 0; i < a_data_size_in_words; i++)
+    {
+        this->write_line(true == this->is_9_bit_frame() ? static_cast<const uint16_t*>(a_p_data)[i] & 0x1FFu :
+                                                          static_cast<const uint8_t*>(a_p_data)[i]);
+    }
+
+    return { bus_status, a_data_size_in_words };
+}
+
+USART::Result USART::transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_words, time::tick a_timeout_ms)
+{
+    assert(a_timeout_ms > 0);
+
+    return this->transmit_bytes_polling(a_p_data, a_data_size_in_words);
+}
+
+USART::Result USART::receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words)
+{
+    assert(true == this->is_enabled());
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_words > 0);
+
+    pollfd input = { this->input_fds[0], POLLIN, 0 };
+    poll(&input, 1, -1);
+
+    return this->receive_bytes_polling(a_p_data, a_data_size_in_words, time::infinity);
+}
+
+USART::Result USART::receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words, time::tick a_timeout_ms)
+{
+    assert(true == this->is_enabled());
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_words > 0);
+    assert(a_timeout_ms > 0);
+
+    time::tick start = counter::get();
+
+    uint32_t ret               = 0;
+    bool idle                  = false;
+    Bus_status_flag bus_status = Bus_status_flag::ok;
+
+    while (false == idle && Bus_status_flag::ok == bus_status && a_timeout_ms >= time::diff(counter::get(), start))
+    {
+        uint16_t word = 0;
+
+        if (true == this->read_line(&word))
+        {
+            if (ret < a_data_size_in_words)
+            {
+                if (true == this->is_9_bit_frame())
+                {
+                    static_cast<uint16_t*>(a_p_data)[ret] = word;
+                }
+                else
+                {
+                    static_cast<uint8_t*>(a_p_data)[ret] = static_cast<uint8_t>(word);
+                }
+            }
+
+            ret++;
+        }
+        else if (ret > 0)
+        {
+            idle = true;
+        }
+        else
+        {
+            simulation::advance(1);
+        }
+
+        bus_status = this->take_bus_status();
+    }
+
+    return { bus_status, ret };
+}
+
+void USART::register_transmit_callback(const TX_callback& a_callback)
+{
+    assert(true == this->is_enabled());
+    assert(nullptr != a_callback.function);
+
+    Interrupt_guard guard;
+
+    this->tx_callback = a_callback;
+    set_flag(&(this->registers.CR1), cr1_txeie | cr1_tcie);
+}
+
+void USART::register_receive_callback(const RX_callback& a_callback)
+{
+    assert(true == this->is_enabled());
+    assert(nullptr != a_callback.function);
+
+    Interrupt_guard guard;
+
+    this->rx_callback = a_callback;
+
+    clear_flag(&(this->registers.ISR), isr_idle);
+    set_flag(&(this->registers.CR1), cr1_rxneie | cr1_idleie);
+}
+
+void USART::register_bus_status_callback(const Bus_status_callback& a_callback)
+{
+    assert(true == this->is_enabled());
+    assert(nullptr != a_callback.function);
+
+    Interrupt_guard guard;
+
+    this->bus_status_callback = a_callback;
+    set_flag(&(this->registers.CR1), cr1_eie);
+}
+
+void USART::unregister_transmit_callback()
+{
+    assert(true == this->is_enabled());
+
+    Interrupt_guard guard;
+
+    clear_flag(&(this->registers.CR1), cr1_txeie | cr1_tcie);
+    this->tx_callback = { nullptr, nullptr };
+}
+
+void USART::unregister_receive_callback()
+{
+    assert(true == this->is_enabled());
+
+    Interrupt_guard guard;
+
+    clear_flag(&(this->registers.CR1), cr1_rxneie | cr1_idleie);
+    this->rx_callback = { nullptr, nullptr };
+}
+
+void USART::unregister_bus_status_callback()
+{
+    assert(true == this->is_enabled());
+
+    Interrupt_guard guard;
+
+    clear_flag(&(this->registers.CR1), cr1_eie);
+    this->bus_status_callback = { nullptr, nullptr };
+}
+
+void USART::set_baud_rate(uint32_t a_baud_rate)
+{
+    assert(0 != a_baud_rate);
+    this->config.baud_rate = a_baud_rate;
+}
+
+void USART::set_oversampling(Oversampling a_oversampling)
+{
+    assert(Oversampling::unknown != a_oversampling);
+    this->config.oversampling = a_oversampling;
+}
+
+void USART::set_stop_bits(Stop_bits a_stop_bits)
+{
+    assert(Stop_bits::unknown != a_stop_bits);
+    this->config.stop_bits = a_stop_bits;
+}
+
+void USART::set_flow_control(Flow_control_flag a_flow_control)
+{
+    assert(Flow_control_flag::unknown != a_flow_control);
+    this->config.flow_control = a_flow_control;
+}
+
+void USART::set_sampling_method(Sampling_method a_sampling_method)
+{
+    assert(Sampling_method::unknown != a_sampling_method);
+    this->config.sampling_method = a_sampling_method;
+}
+
+void USART::set_frame_format(const Frame_format& a_frame_format)
+{
+    assert(Parity::unknown      != a_frame_format.parity);
+    assert(Word_length::unknown != a_frame_format.word_length);
+
+    this->frame_format = a_frame_format;
+}
+
+bool USART::set_mode(Mode_flag a_mode, time::tick a_timeout_ms)
+{
+    assert(a_timeout_ms > 0);
+
+    this->config.mode = a_mode;
+    return true;
+}
+
+bool USART::read_line(uint16_t* a_p_word)
+{
+    if (false == is_flag(static_cast<uint32_t>(this->config.mode), static_cast<uint32_t>(Mode_flag::rx)))
+    {
+        return false;
+    }
+
+    uint8_t data[2] = { 0, 0 };
+    const uint32_t size = true == this->is_9_bit_frame() ? 2u : 1u;
+
+    if (static_cast<ssize_t>(size) != read(this->input_fds[0], data, size))
+    {
+        return false;
+    }
+
+    (*a_p_word) = static_cast<uint16_t>(data[0] | (data[1] << 8u));
+
+    return true;
+}
+
+void USART::write_line(uint16_t a_word)
+{
+    if (true == is_flag(static_cast<uint32_t>(this->config.mode), static_cast<uint32_t>(Mode_flag::tx)))
+    {
+        const uint8_t data[2] = { static_cast<uint8_t>(a_word & 0xFFu), static_cast<uint8_t>(a_word >> 8u) };
+        const ssize_t written = write(this->output_fds[1], data, true == this->is_9_bit_frame() ? 2u : 1u);
+
+        assert(written > 0);
+        (void)written;
+    }
+}
+
+USART::Bus_status_flag USART::take_bus_status()
+{
+    const Bus_status_flag ret = this->injected_bus_status;
+    this->injected_bus_status = Bus_status_flag::ok;
+
+    return ret;
+}
+
+} // namespace peripherals
+} // namespace host
+} // namespace soc
+
+#endif // CML_HOST
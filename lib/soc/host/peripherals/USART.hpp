@@ -0,0 +1,446 @@
+#pragma once
+
+/*
+    Name: USART.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/bit.hpp>
+#include <cml/frequency.hpp>
+#include <cml/Non_copyable.hpp>
+#include <cml/time.hpp>
+#include <cml/type_traits.hpp>
+
+namespace soc {
+namespace host {
+namespace peripherals {
+
+//
+// Byte-stream model of the USART for the host port, same interface as the target drivers (without DMA).
+// The line is a pair of pipes: bytes written to 'get_host_input_fd' are received, everything transmitted
+// can be read from 'get_host_output_fd'. Interrupt mode moves one word per host::simulation pass, baud rate
+// timing is not modelled.
+//
+class USART : private cml::Non_copyable
+{
+public:
+
+    enum class Id : uint32_t
+    {
+        _1 = 0,
+        _2 = 1,
+        _3 = 2
+    };
+
+    enum class Oversampling : uint32_t
+    {
+        _8  = 0x1u,
+        _16 = 0,
+        unknown
+    };
+
+    enum class Stop_bits : uint32_t
+    {
+        _0_5 = 0x1u,
+        _1   = 0x0u,
+        _1_5 = 0x3u,
+        _2   = 0x2u,
+        unknown
+    };
+
+    enum class Flow_control_flag : uint32_t
+    {
+        none            = 0x0u,
+        request_to_send = 0x1u,
+        clear_to_send   = 0x2u,
+        unknown
+    };
+
+    enum Sampling_method : uint32_t
+    {
+        three_sample_bit = 0,
+        one_sample_bit   = 0x1u,
+        unknown
+    };
+
+    enum class Mode_flag : uint32_t
+    {
+        tx      = 0x1u,
+        rx      = 0x2u,
+        unknown = 0x0u
+    };
+
+    enum class Word_length : uint32_t
+    {
+        _7_bit = 0x1u,
+        _8_bit = 0x0u,
+        _9_bit = 0x2u,
+        unknown
+    };
+
+    enum class Parity : uint32_t
+    {
+        none = 0x0u,
+        even = 0x1u,
+        odd  = 0x3u,
+        unknown
+    };
+
+    enum class Frame_length : uint32_t
+    {
+        _7_bit = 0x1u,
+        _8_bit = 0,
+        _9_bit = 0x2u
+    };
+
+    enum class Bus_status_flag : uint32_t
+    {
+        ok             = 0x0,
+        framing_error  = 0x1,
+        parity_error   = 0x2,
+        overrun        = 0x4,
+        noise_detected = 0x8,
+        unknown        = 0x10
+    };
+
+    struct Frame_format
+    {
+        Word_length word_length = Word_length::unknown;
+        Parity parity           = Parity::unknown;
+    };
+
+    struct Config
+    {
+        uint32_t baud_rate              = 0;
+        Oversampling oversampling       = Oversampling::unknown;
+        Stop_bits stop_bits             = Stop_bits::unknown;
+        Flow_control_flag flow_control  = Flow_control_flag::unknown;
+        Sampling_method sampling_method = Sampling_method::unknown;
+        Mode_flag mode                  = Mode_flag::unknown;
+    };
+
+    struct Clock
+    {
+        enum class Source : uint32_t
+        {
+            pclk,
+            sysclk,
+            hsi,
+            unknown
+        };
+
+        Source source               = Source::unknown;
+        cml::frequency frequency_hz = cml::Hz(0);
+    };
+
+    struct Result
+    {
+        Bus_status_flag bus_status    = Bus_status_flag::unknown;
+        uint32_t data_length_in_words = 0;
+    };
+
+    struct TX_callback
+    {
+        using Function = bool(*)(volatile uint16_t* a_p_data, bool a_transfer_complete, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    struct RX_callback
+    {
+        using Function = bool(*)(uint32_t a_data, bool a_idle, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    struct Bus_status_callback
+    {
+        using Function = bool(*)(Bus_status_flag a_bus_status, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+public:
+
+    USART(Id a_id);
+    ~USART();
+
+    bool enable(const Config& a_config,
+                const Frame_format& frame_format,
+                const Clock& a_clock,
+                uint32_t a_irq_priority,
+                cml::time::tick a_timeout_ms);
+
+    void disable();
+
+    template<typename Data_t>
+    Result transmit_polling(const Data_t& a_data)
+    {
+        static_assert(true == cml::is_pod<Data_t>());
+        return this->transmit_bytes_polling(&a_data, sizeof(a_data));
+    }
+
+    template<typename Data_t>
+    Result transmit_polling(const Data_t& a_data, cml::time::tick a_timeout)
+    {
+        static_assert(true == cml::is_pod<Data_t>());
+        return this->transmit_bytes_polling(&a_data, sizeof(a_data), a_timeout);
+    }
+
+    template<typename Data_t>
+    Result receive_polling(Data_t* a_p_data)
+    {
+        static_assert(true == cml::is_pod<Data_t>());
+        return this->receive_bytes_polling(a_p_data, sizeof(Data_t));
+    }
+
+    template<typename Data_t>
+    Result receive_polling(Data_t* a_p_data, cml::time::tick a_timeout)
+    {
+        static_assert(true == cml::is_pod<Data_t>());
+        return this->receive_bytes_polling(a_p_data, sizeof(Data_t), a_timeout);
+    }
+
+    Result transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_words);
+    Result transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_words, cml::time::tick a_timeout_ms);
+    Result receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words);
+
+    //
+    // Waiting for the first word advances host::simulation by one tick per empty poll.
+    //
+    Result receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words, cml::time::tick a_timeout_ms);
+
+    void register_transmit_callback(const TX_callback& a_callback);
+    void register_receive_callback(const RX_callback& a_callback);
+    void register_bus_status_callback(const Bus_status_callback& a_callback);
+
+    void unregister_transmit_callback();
+    void unregister_receive_callback();
+    void unregister_bus_status_callback();
+
+    void set_baud_rate(uint32_t a_baud_rate);
+    void set_oversampling(Oversampling a_oversampling);
+    void set_stop_bits(Stop_bits a_stop_bits);
+    void set_flow_control(Flow_control_flag a_flow_control);
+    void set_sampling_method(Sampling_method a_sampling_method);
+    void set_frame_format(const Frame_format& a_frame_format);
+    bool set_mode(Mode_flag a_mode, cml::time::tick a_timeout_ms);
+
+    //
+    // Scripted line errors: reported by the next polling call or interrupt pass, then cleared.
+    //
+    void inject_bus_status(Bus_status_flag a_bus_status)
+    {
+        this->injected_bus_status = a_bus_status;
+    }
+
+    int get_host_input_fd() const
+    {
+        return this->input_fds[1];
+    }
+
+    int get_host_output_fd() const
+    {
+        return this->output_fds[0];
+    }
+
+    bool is_transmit_callback_registered() const
+    {
+        return nullptr != this->tx_callback.function;
+    }
+
+    bool is_receive_callback_registered() const
+    {
+        return nullptr != this->rx_callback.function;
+    }
+
+    bool is_bus_status_callback_registered() const
+    {
+        return nullptr != this->bus_status_callback.function;
+    }
+
+    Oversampling get_oversampling() const
+    {
+        return this->config.oversampling;
+    }
+
+    Stop_bits get_stop_bits() const
+    {
+        return this->config.stop_bits;
+    }
+
+    Flow_control_flag get_flow_control() const
+    {
+        return this->config.flow_control;
+    }
+
+    Sampling_method get_sampling_method() const
+    {
+        return this->config.sampling_method;
+    }
+
+    Mode_flag get_mode() const
+    {
+        return this->config.mode;
+    }
+
+    bool is_enabled() const
+    {
+        return true == cml::is_flag(this->registers.CR1, cr1_ue);
+    }
+
+    uint32_t get_baud_rate() const
+    {
+        return this->config.baud_rate;
+    }
+
+    const Clock& get_clock() const
+    {
+        return this->clock;
+    }
+
+    const Frame_format& get_frame_format() const
+    {
+        return this->frame_format;
+    }
+
+    Id get_id() const
+    {
+        return this->id;
+    }
+
+private:
+
+    //
+    // The part of the register block the model needs, TDR reads back 'tdr_empty' until a word is written.
+    //
+    struct Registers
+    {
+        uint32_t CR1          = 0;
+        uint32_t ISR          = 0;
+        uint16_t RDR          = 0;
+        volatile uint16_t TDR = 0;
+    };
+
+    static constexpr uint32_t cr1_ue     = 0x1u;
+    static constexpr uint32_t cr1_txeie  = 0x2u;
+    static constexpr uint32_t cr1_tcie   = 0x4u;
+    static constexpr uint32_t cr1_rxneie = 0x8u;
+    static constexpr uint32_t cr1_idleie = 0x10u;
+    static constexpr uint32_t cr1_eie    = 0x20u;
+
+    static constexpr uint32_t isr_rxne = 0x1u;
+    static constexpr uint32_t isr_idle = 0x2u;
+
+    static constexpr uint16_t tdr_empty = 0xFFFFu;
+
+private:
+
+    bool is_9_bit_frame() const
+    {
+        return Parity::none == this->frame_format.parity && Word_length::_9_bit == this->frame_format.word_length;
+    }
+
+    bool read_line(uint16_t* a_p_word);
+    void write_line(uint16_t a_word);
+
+    Bus_status_flag take_bus_status();
+
+private:
+
+    Id id;
+
+    Registers registers;
+
+    TX_callback tx_callback;
+    RX_callback rx_callback;
+    Bus_status_callback bus_status_callback;
+
+    Config config;
+    Clock clock;
+    Frame_format frame_format;
+
+    Bus_status_flag injected_bus_status;
+    bool rx_active;
+
+    int input_fds[2];
+    int output_fds[2];
+
+private:
+
+    friend void usart_interrupt_handler(void* a_p_this);
+};
+
+constexpr USART::Bus_status_flag operator | (USART::Bus_status_flag a_f1, USART::Bus_status_flag a_f2)
+{
+    return static_cast<USART::Bus_status_flag>(static_cast<uint32_t>(a_f1) | static_cast<uint32_t>(a_f2));
+}
+
+constexpr USART::Bus_status_flag operator & (USART::Bus_status_flag a_f1, USART::Bus_status_flag a_f2)
+{
+    return static_cast<USART::Bus_status_flag>(static_cast<uint32_t>(a_f1) & static_cast<uint32_t>(a_f2));
+}
+
+constexpr USART::Bus_status_flag operator |= (USART::Bus_status_flag& a_f1, USART::Bus_status_flag a_f2)
+{
+    a_f1 = a_f1 | a_f2;
+    return a_f1;
+}
+
+constexpr USART::Flow_control_flag operator | (USART::Flow_control_flag a_f1, USART::Flow_control_flag a_f2)
+{
+    return static_cast<USART::Flow_control_flag>(static_cast<uint32_t>(a_f1) | static_cast<uint32_t>(a_f2));
+}
+
+constexpr USART::Flow_control_flag operator & (USART::Flow_control_flag a_f1, USART::Flow_control_flag a_f2)
+{
+    return static_cast<USART::Flow_control_flag>(static_cast<uint32_t>(a_f1) & static_cast<uint32_t>(a_f2));
+}
+
+constexpr USART::Flow_control_flag operator |= (USART::Flow_control_flag& a_f1, USART::Flow_control_flag a_f2)
+{
+    a_f1 = a_f1 | a_f2;
+    return a_f1;
+}
+
+constexpr USART::Mode_flag operator | (USART::Mode_flag a_f1, USART::Mode_flag a_f2)
+{
+    return static_cast<USART::Mode_flag>(static_cast<uint32_t>(a_f1) | static_cast<uint32_t>(a_f2));
+}
+
+constexpr USART::Mode_flag operator & (USART::Mode_flag a_f1, USART::Mode_flag a_f2)
+{
+    return static_cast<USART::Mode_flag>(static_cast<uint32_t>(a_f1) & static_cast<uint32_t>(a_f2));
+}
+
+constexpr USART::Mode_flag operator |= (USART::Mode_flag& a_f1, USART::Mode_flag a_f2)
+{
+    a_f1 = a_f1 | a_f2;
+    return a_f1;
+}
+
+//
+// Compile-time form of USART, so code using it builds for the host too.
+//
+template<USART::Id id_t>
+class USART_t : public USART
+{
+public:
+
+    USART_t()
+        : USART(id_t)
+    {}
+};
+
+} // namespace peripherals
+} // namespace host
+} // namespace soc
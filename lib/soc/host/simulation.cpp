@@ -0,0 +1,117 @@
+/*
+    Name: simulation.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#ifdef CML_HOST
+
+//this
+#include <soc/host/simulation.hpp>
+
+//soc
+#include <soc/systick.hpp>
+
+//cml
+#include <cml/debug/assert.hpp>
+
+extern "C" void SysTick_Handler();
+
+namespace {
+
+using namespace cml;
+using namespace soc::host;
+
+constexpr uint32_t interrupt_handlers_capacity = 16u;
+
+simulation::Interrupt_handler interrupt_handlers[interrupt_handlers_capacity];
+uint32_t primask = 0;
+uint64_t cycles  = 0;
+
+} // namespace ::
+
+namespace soc {
+namespace host {
+
+using namespace cml;
+
+void simulation::advance(time::tick a_ticks)
+{
+    for (time::tick i = 0; i < a_ticks; i++)
+    {
+        if (0 == primask && true == systick::is_enabled())
+        {
+            SysTick_Handler();
+        }
+
+        run_interrupts();
+    }
+}
+
+void simulation::run_interrupts()
+{
+    if (0 != primask)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < interrupt_handlers_capacity; i++)
+    {
+        if (nullptr != interrupt_handlers[i].function)
+        {
+            interrupt_handlers[i].function(interrupt_handlers[i].p_user_data);
+        }
+    }
+}
+
+void simulation::advance_cycles(uint32_t a_cycles)
+{
+    cycles += a_cycles;
+}
+
+uint64_t simulation::get_cycles()
+{
+    return cycles;
+}
+
+void simulation::register_interrupt_handler(const Interrupt_handler& a_handler)
+{
+    assert(nullptr != a_handler.function);
+
+    uint32_t i = 0;
+    for (; i < interrupt_handlers_capacity && nullptr != interrupt_handlers[i].function; i++);
+
+    assert(i < interrupt_handlers_capacity);
+
+    if (i < interrupt_handlers_capacity)
+    {
+        interrupt_handlers[i] = a_handler;
+    }
+}
+
+void simulation::unregister_interrupt_handler(void* a_p_user_data)
+{
+    for (uint32_t i = 0; i < interrupt_handlers_capacity; i++)
+    {
+        if (a_p_user_data == interrupt_handlers[i].p_user_data)
+        {
+            interrupt_handlers[i] = { nullptr, nullptr };
+        }
+    }
+}
+
+uint32_t simulation::get_primask()
+{
+    return primask;
+}
+
+void simulation::set_primask(uint32_t a_primask)
+{
+    primask = a_primask;
+}
+
+} // namespace host
+} // namespace soc
+
+#endif // CML_HOST
@@ -0,0 +1,77 @@
+#pragma once
+
+/*
+    Name: simulation.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//cml
+#include <cml/time.hpp>
+
+namespace soc {
+namespace host {
+
+//
+// Stands in for the core and the interrupt controller of the host (CML_HOST) port. Nothing runs
+// asynchronously: the peripheral models and their interrupt handlers run only from 'run_interrupts', and
+// simulated time only moves in 'advance', so tests and benchmarks are deterministic.
+// Modelled: GPIO, USART and ADC. Deliberately not: I2C, RS485 and DMA - the I2C transaction queue, register
+// access, DMA and bus recovery of the L452 I2C_master are register level code with no host counterpart, only the
+// TIMINGR solver (soc/I2C_timing.hpp) is platform independent and tested on the host.
+//
+class simulation
+{
+public:
+
+    struct Interrupt_handler
+    {
+        using Function = void(*)(void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+public:
+
+    //
+    // Every tick: SysTick_Handler (when systick is enabled), then one 'run_interrupts' pass.
+    //
+    static void advance(cml::time::tick a_ticks);
+
+    //
+    // One pass over the registered peripheral models - each one moves at most one word per pass,
+    // as if its interrupt fired once. Skipped while interrupts are masked (Interrupt_guard).
+    //
+    static void run_interrupts();
+
+    //
+    // Core cycles spent in busy waits (Edge_clock). Only these move them and they never add up to systick ticks -
+    // waits that short do not let interrupts in on the target either.
+    //
+    static void advance_cycles(uint32_t a_cycles);
+    static uint64_t get_cycles();
+
+    static void register_interrupt_handler(const Interrupt_handler& a_handler);
+    static void unregister_interrupt_handler(void* a_p_user_data);
+
+    static uint32_t get_primask();
+    static void set_primask(uint32_t a_primask);
+
+private:
+
+    simulation()                  = delete;
+    simulation(simulation&&)      = delete;
+    simulation(const simulation&) = delete;
+    ~simulation()                 = default;
+
+    simulation& operator = (simulation&&)      = delete;
+    simulation& operator = (const simulation&) = delete;
+};
+
+} // namespace host
+} // namespace soc
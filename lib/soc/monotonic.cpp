@@ -0,0 +1,30 @@
+/*
+    Name: monotonic.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//this
+#include <soc/monotonic.hpp>
+
+//soc
+#include <soc/systick.hpp>
+
+namespace soc {
+
+uint64_t monotonic::get_us()
+{
+    const uint64_t cycles = systick::get_cycles();
+    const uint32_t period = systick::get_tick_period();
+
+    // split, so the cycles within the tick do not overflow when scaled
+    return (cycles / period) * 1000u + ((cycles % period) * 1000u) / period;
+}
+
+uint64_t monotonic::get_ms()
+{
+    return systick::get_cycles() / systick::get_tick_period();
+}
+
+} // namespace soc
@@ -0,0 +1,38 @@
+#pragma once
+
+/*
+    Name: monotonic.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+namespace soc {
+
+//
+// 64-bit time since systick::enable with sub-tick resolution, built on systick::get_cycles. Like counter,
+// it takes one tick as one millisecond. Values never wrap, so they can be compared and subtracted directly
+// (no time::diff), and it keeps counting through systick::sleep.
+//
+class monotonic
+{
+public:
+
+    static uint64_t get_us();
+    static uint64_t get_ms();
+
+private:
+
+    monotonic()                 = delete;
+    monotonic(monotonic&&)      = delete;
+    monotonic(const monotonic&) = delete;
+    ~monotonic()                = default;
+
+    monotonic& operator = (monotonic&&)      = delete;
+    monotonic& operator = (const monotonic&) = delete;
+};
+
+} // namespace soc
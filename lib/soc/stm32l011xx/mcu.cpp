@@ -10,6 +10,10 @@
 //this
 #include <soc/stm32l011xx/mcu.hpp>
 
+//soc
+#include <soc/Edge_clock.hpp>
+#include <soc/systick.hpp>
+
 //cml
 #include <cml/bit.hpp>
 #include <cml/frequency.hpp>
@@ -177,6 +181,12 @@ void mcu::set_sysclk(Sysclk_source a_source, const Bus_prescalers& a_prescalers)
     set_flag(&(FLASH->ACR), FLASH_ACR_PRFTEN | FLASH_ACR_PRE_READ);
     clear_flag(&(FLASH->ACR), FLASH_ACR_DISAB_BUF);
 
+    // the spin loop of the busy waits takes a different number of cycles with another flash latency
+    if (true == systick::is_enabled())
+    {
+        Edge_clock::calibrate();
+    }
+
     if (nullptr != post_sysclk_frequency_change_callback.function)
     {
         post_sysclk_frequency_change_callback.function(post_sysclk_frequency_change_callback.p_user_data);
@@ -212,6 +222,19 @@ mcu::Bus_prescalers mcu::get_bus_prescalers()
              static_cast<Bus_prescalers::APB2>(get_flag(RCC->CFGR, RCC_CFGR_PPRE2)) };
 }
 
+cml::frequency mcu::get_pclk1_frequency_hz()
+{
+    // HPRE: 0xxx - 1, 1000 - 2 ... 1111 - 512 (no 32), PPRE1: 0xx - 1, 100 - 2 ... 111 - 16
+    constexpr uint32_t ahb_shifts[] = { 1u, 2u, 3u, 4u, 6u, 7u, 8u, 9u };
+
+    const uint32_t hpre  = get_flag(RCC->CFGR, RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos;
+    const uint32_t ppre1 = get_flag(RCC->CFGR, RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos;
+
+    const cml::frequency hclk = get_sysclk_frequency_hz() >> (hpre >= 8u ? ahb_shifts[hpre - 8u] : 0u);
+
+    return hclk >> (ppre1 >= 4u ? ppre1 - 3u : 0u);
+}
+
 mcu::Pll_config mcu::get_pll_config()
 {
     return
@@ -235,6 +235,9 @@ public:
         return SystemCoreClock;
     }
 
+    // sysclk through the AHB and APB1 prescalers
+    static cml::frequency get_pclk1_frequency_hz();
+
     static constexpr cml::frequency get_hsi_frequency_hz()
     {
         return cml::MHz(16u);
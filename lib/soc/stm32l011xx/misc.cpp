@@ -11,6 +11,7 @@
 #include <soc/stm32l011xx/misc.hpp>
 
 //soc
+#include <soc/Edge_clock.hpp>
 #include <soc/stm32l011xx/mcu.hpp>
 
 //cml
@@ -28,12 +29,11 @@ void misc::delay_us(time::tick a_time)
     assert(mcu::get_sysclk_frequency_hz() >= MHz(1));
     assert(a_time > 0);
 
-    uint32_t count = ((((mcu::get_sysclk_frequency_hz() / MHz(1))) / 4) * (a_time - 1));
+    // spin loop calibrated by systick::enable, taken as 3 cycles a loop before the systick runs
+    Edge_clock clock;
 
-    __asm__ __volatile__("1: sub %0, #1 \n"
-                         "   cmp %0, #0 \n"
-                         "   bne  1b    \n"
-                         : "+r" (count));
+    clock.start();
+    clock.wait(mcu::get_sysclk_frequency_hz() / MHz(1) * a_time);
 }
 
 } // namespace stm32l011xx
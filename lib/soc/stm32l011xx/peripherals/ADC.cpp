@@ -18,6 +18,9 @@
 //cml
 #include <cml/bit.hpp>
 #include <cml/debug/assert.hpp>
+#ifdef CML_PROFILE_IRQ
+#include <cml/debug/profiler.hpp>
+#endif // CML_PROFILE_IRQ
 #include <cml/utils/delay.hpp>
 #include <cml/utils/wait.hpp>
 
@@ -41,6 +44,10 @@ bool is_channel(ADC::Channel a_type, const ADC::Channel* a_p_channels, uint32_t
     return found;
 }
 
+#ifdef CML_PROFILE_IRQ
+cml::debug::profiler::Zone adc1_comp_irq_zone("ADC1_COMP_IRQHandler");
+#endif // CML_PROFILE_IRQ
+
 } // namespace ::
 
 extern "C"
@@ -48,6 +55,10 @@ extern "C"
 
 void ADC1_COMP_IRQHandler()
 {
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&adc1_comp_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     assert(nullptr != p_adc_1);
     adc_interrupt_handler(p_adc_1);
 }
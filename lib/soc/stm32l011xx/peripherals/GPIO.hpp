@@ -18,6 +18,9 @@
 #include <cml/Non_copyable.hpp>
 #include <cml/debug/assert.hpp>
 
+//soc
+#include <soc/Out_pin.hpp>
+
 namespace soc {
 namespace stm32l011xx {
 namespace peripherals {
@@ -415,6 +418,34 @@ private:
     friend pin::af;
 };
 
+//
+// Compile-time form of GPIO. The register block address is a constant, so pins built on top of it
+// compile to plain stores instead of loads through the GPIO object.
+//
+template<GPIO::Id id_t>
+class GPIO_t : public GPIO
+{
+public:
+
+    using Pin_level = pin::Level;
+
+    static constexpr uint32_t registers_address = IOPPERIPH_BASE + 0x400u * static_cast<uint32_t>(id_t);
+
+public:
+
+    GPIO_t()
+        : GPIO(id_t)
+    {}
+
+    static GPIO_TypeDef* get_registers()
+    {
+        return reinterpret_cast<GPIO_TypeDef*>(registers_address);
+    }
+};
+
+template<GPIO::Id port_t, uint8_t id_t> using Out_pin_t = soc::Out_pin_t<GPIO_t<port_t>, id_t>;
+template<GPIO::Id port_t, uint8_t... ids_t> using Out_pin_group_t = soc::Out_pin_group_t<GPIO_t<port_t>, ids_t...>;
+
 } // namespace peripherals
 } // namespace stm32l011xx
 } // namespace soc
\ No newline at end of file
@@ -90,9 +90,45 @@ I2C_base::Bus_status_flag get_bus_status_flag_from_I2C_ISR(uint32_t a_isr)
         ret |= I2C_base::Bus_status_flag::nack;
     }
 
+    if (true == is_flag(a_isr, I2C_ISR_PECERR))
+    {
+        ret |= I2C_base::Bus_status_flag::crc_error;
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TIMEOUT))
+    {
+        ret |= I2C_base::Bus_status_flag::timeout;
+    }
+
     return ret;
 }
 
+// NBYTES and the end mode of the next chunk of a segment: RELOAD while more than 255 bytes are left, then
+// AUTOEND (STOP) if the segment ends the transaction or software end (TC) if a read segment follows
+uint32_t get_I2C_CR2_chunk(uint32_t a_remaining, bool a_last_segment)
+{
+    if (a_remaining > 255u)
+    {
+        return (255u << I2C_CR2_NBYTES_Pos) | I2C_CR2_RELOAD;
+    }
+
+    return (a_remaining << I2C_CR2_NBYTES_Pos) | (true == a_last_segment ? I2C_CR2_AUTOEND : 0);
+}
+
+// drops the transfer in progress and releases the lines, the configuration registers are kept
+void reset_I2C(I2C_TypeDef* a_p_registers)
+{
+    clear_flag(&(a_p_registers->CR1), I2C_CR1_PE);
+
+    // PE has to stay low for 3 APB cycles, every read of CR1 takes one at least
+    for (uint32_t i = 0; i < 3u; i++)
+    {
+        static_cast<void>(a_p_registers->CR1);
+    }
+
+    set_flag(&(a_p_registers->CR1), I2C_CR1_PE);
+}
+
 Controller controller;
 
 } // namespace ::
@@ -225,6 +261,32 @@ I2C_base::Clock_source I2C_base::get_clock_source() const
     return static_cast<Clock_source>(get_flag(RCC->CCIPR, RCC_CCIPR_I2C1SEL) >> RCC_CCIPR_I2C1SEL_Pos);
 }
 
+frequency I2C_base::get_clock_frequency_hz() const
+{
+    switch (this->get_clock_source())
+    {
+        case Clock_source::pclk1:
+        {
+            return soc::stm32l011xx::mcu::get_pclk1_frequency_hz();
+        }
+        break;
+
+        case Clock_source::sysclk:
+        {
+            return mcu::get_sysclk_frequency_hz();
+        }
+        break;
+
+        case Clock_source::hsi:
+        {
+            return mcu::get_hsi_frequency_hz();
+        }
+        break;
+    }
+
+    return 0;
+}
+
 void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uint32_t a_irq_priority)
 {
     assert(false == this->is_enabled());
@@ -250,6 +312,33 @@ void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uin
     }
 }
 
+bool I2C_master::set_timing(const I2C_timing::Bus& a_bus)
+{
+    assert(nullptr != controller.p_i2c_master_handle);
+
+    const I2C_timing::Result timing = I2C_timing::calculate(this->get_clock_frequency_hz(), a_bus);
+
+    if (false == timing.valid)
+    {
+        return false;
+    }
+
+    // TIMINGR, ANFOFF and DNF are write protected while PE is set
+    const uint32_t cr1 = I2C1->CR1 & ~(I2C_CR1_ANFOFF | I2C_CR1_DNF | I2C_CR1_PE);
+
+    I2C1->CR1     = cr1;
+    I2C1->TIMINGR = timing.get_timingr();
+    I2C1->CR1     = cr1 | (false == a_bus.analog_filter ? I2C_CR1_ANFOFF : 0) |
+                    (a_bus.digital_filter << I2C_CR1_DNF_Pos);
+
+    set_flag(&(I2C1->CR1), I2C_CR1_PE);
+
+    this->bus_timing     = a_bus;
+    this->bus_timing_set = true;
+
+    return true;
+}
+
 void I2C_master::diasble()
 {
     assert(nullptr != controller.p_i2c_master_handle);
@@ -520,6 +609,106 @@ bool I2C_master::is_slave_connected(uint16_t a_slave_address, time::tick a_timeo
     return ret;
 }
 
+I2C_master::Result I2C_master::registers_polling(uint16_t a_slave_address,
+                                                 uint8_t a_register,
+                                                 const void* a_p_write_data,
+                                                 void* a_p_read_data,
+                                                 uint32_t a_data_size_in_bytes,
+                                                 time::tick a_timeout)
+{
+    assert(nullptr != controller.p_i2c_master_handle);
+    assert((nullptr != a_p_write_data) != (nullptr != a_p_read_data));
+    assert(a_data_size_in_bytes > 0);
+
+    const time::tick start = counter::get();
+
+    const bool reading          = nullptr != a_p_read_data;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
+
+    // the register address opens the write segment, a read follows it after TC with a repeated START
+    I2C1->CR2 = address_mask |
+                get_I2C_CR2_chunk(1u + (true == reading ? 0 : a_data_size_in_bytes), false == reading) |
+                I2C_CR2_START;
+
+    uint32_t bytes             = 0;
+    bool register_address_sent = false;
+    bool error                 = false;
+    bool timeout               = false;
+    Bus_status_flag bus_status = Bus_status_flag::ok;
+
+    while (false == is_flag(I2C1->ISR, I2C_ISR_STOPF) && false == error && false == timeout)
+    {
+        const uint32_t isr = I2C1->ISR;
+
+        if (true == is_flag(isr, I2C_ISR_NACKF))
+        {
+            // STOP follows on its own
+            set_flag(&(I2C1->ICR), I2C_ICR_NACKCF);
+            bus_status |= Bus_status_flag::nack;
+        }
+
+        if (true == is_flag(isr, I2C_ISR_TXIS))
+        {
+            if (false == register_address_sent)
+            {
+                I2C1->TXDR            = a_register;
+                register_address_sent = true;
+            }
+            else if (bytes < a_data_size_in_bytes)
+            {
+                I2C1->TXDR = static_cast<const uint8_t*>(a_p_write_data)[bytes++];
+            }
+        }
+
+        if (true == is_flag(isr, I2C_ISR_RXNE))
+        {
+            const uint8_t data = static_cast<uint8_t>(I2C1->RXDR);
+
+            if (bytes < a_data_size_in_bytes)
+            {
+                static_cast<uint8_t*>(a_p_read_data)[bytes++] = data;
+            }
+        }
+
+        if (true == is_flag(isr, I2C_ISR_TCR))
+        {
+            I2C1->CR2 = (I2C1->CR2 & ~(I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_AUTOEND)) |
+                        get_I2C_CR2_chunk(a_data_size_in_bytes - bytes, true);
+        }
+        else if (true == is_flag(isr, I2C_ISR_TC))
+        {
+            I2C1->CR2 = address_mask |
+                        get_I2C_CR2_chunk(a_data_size_in_bytes, true) |
+                        I2C_CR2_RD_WRN |
+                        I2C_CR2_START;
+        }
+
+        error   = is_any_bit(isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_PECERR | I2C_ISR_TIMEOUT);
+        timeout = a_timeout > 0 && time::diff(counter::get(), start) > a_timeout;
+    }
+
+    // the STOP may be seen before the RXNE of the last byte (the loop delayed by an interrupt) - it is still in RXDR
+    while (true == reading && bytes < a_data_size_in_bytes && true == is_flag(I2C1->ISR, I2C_ISR_RXNE))
+    {
+        static_cast<uint8_t*>(a_p_read_data)[bytes++] = static_cast<uint8_t>(I2C1->RXDR);
+    }
+
+    if (true == error || true == timeout)
+    {
+        // no STOP is coming, the transfer is dropped
+        bus_status |= get_bus_status_flag_from_I2C_ISR(I2C1->ISR) |
+                      (true == timeout ? Bus_status_flag::timeout : Bus_status_flag::ok);
+
+        reset_I2C(I2C1);
+        clear_I2C_ISR_errors(&(I2C1->ICR));
+    }
+
+    set_flag(&(I2C1->ICR), I2C_ICR_STOPCF);
+    I2C1->CR2 = 0;
+
+    return { bus_status, bytes };
+}
+
 void I2C_slave::enable(const Config& a_config, Clock_source a_clock_source, uint32_t a_irq_priority)
 {
     assert(false == this->is_enabled());
@@ -21,6 +21,9 @@
 #include <cml/collection/Pair.hpp>
 #include <cml/debug/assert.hpp>
 
+//soc
+#include <soc/I2C_timing.hpp>
+
 namespace soc {
 namespace stm32l011xx {
 namespace peripherals {
@@ -49,7 +52,8 @@ public:
         arbitration_lost = 0x4,
         misplaced        = 0x8,
         nack             = 0x10,
-        unknown          = 0x20
+        unknown          = 0x20,
+        timeout          = 0x40
     };
 
     struct Result
@@ -86,6 +90,9 @@ public:
 
     Clock_source get_clock_source() const;
 
+    // kernel clock of the current source
+    cml::frequency get_clock_frequency_hz() const;
+
     bool is_analog_filter() const
     {
         return false == cml::is_flag(I2C1->CR1, I2C_CR1_ANFOFF);
@@ -172,6 +179,7 @@ public:
 
     I2C_master(Id a_id)
         : I2C_base(a_id)
+        , bus_timing_set(false)
     {}
 
     ~I2C_master()
@@ -184,6 +192,25 @@ public:
                 uint32_t a_irq_priority);
     void diasble();
 
+    //
+    // Solves TIMINGR for the current kernel clock (see I2C_timing) and sets it, with the filters of 'a_bus',
+    // in place of Config::timings. No transfer may be in progress. Returns false and leaves the peripheral as it
+    // was when the kernel clock cannot run the bus as requested.
+    //
+    bool set_timing(const I2C_timing::Bus& a_bus);
+
+    //
+    // Solves the timing of the last 'set_timing' again, for the kernel clock running now. Meant for the mcu post
+    // sysclk frequency change callback:
+    //     mcu::register_post_sysclk_frequency_change_callback(
+    //         { [](void* a_p_user_data) { static_cast<I2C_master*>(a_p_user_data)->update_timing(); }, &i2c });
+    //
+    bool update_timing()
+    {
+        assert(true == this->bus_timing_set);
+        return this->set_timing(this->bus_timing);
+    }
+
     template<typename Data_t>
     Result transmit_polling(uint16_t a_slave_address, const Data_t& a_data)
     {
@@ -226,6 +253,46 @@ public:
                                  uint32_t a_data_size_in_bytes,
                                  cml::time::tick a_timeout);
 
+    //
+    // Register access in one transaction: the register address, then a repeated START and the read (or the data
+    // right after the address for a write), then STOP. Transfers longer than 255 bytes are reloaded.
+    //
+    Result read_registers_polling(uint16_t a_slave_address,
+                                  uint8_t a_register,
+                                  void* a_p_data,
+                                  uint32_t a_data_size_in_bytes)
+    {
+        return this->registers_polling(a_slave_address, a_register, nullptr, a_p_data, a_data_size_in_bytes, 0);
+    }
+
+    Result read_registers_polling(uint16_t a_slave_address,
+                                  uint8_t a_register,
+                                  void* a_p_data,
+                                  uint32_t a_data_size_in_bytes,
+                                  cml::time::tick a_timeout)
+    {
+        assert(a_timeout > 0);
+        return this->registers_polling(a_slave_address, a_register, nullptr, a_p_data, a_data_size_in_bytes, a_timeout);
+    }
+
+    Result write_registers_polling(uint16_t a_slave_address,
+                                   uint8_t a_register,
+                                   const void* a_p_data,
+                                   uint32_t a_data_size_in_bytes)
+    {
+        return this->registers_polling(a_slave_address, a_register, a_p_data, nullptr, a_data_size_in_bytes, 0);
+    }
+
+    Result write_registers_polling(uint16_t a_slave_address,
+                                   uint8_t a_register,
+                                   const void* a_p_data,
+                                   uint32_t a_data_size_in_bytes,
+                                   cml::time::tick a_timeout)
+    {
+        assert(a_timeout > 0);
+        return this->registers_polling(a_slave_address, a_register, a_p_data, nullptr, a_data_size_in_bytes, a_timeout);
+    }
+
     void register_transmit_callback(uint16_t a_slave_address,
                                     const TX_callback& a_callback,
                                     uint32_t a_data_size_in_bytes);
@@ -239,6 +306,20 @@ public:
 
     bool is_slave_connected(uint16_t a_slave_address, cml::time::tick a_timeout) const;
 
+private:
+
+    Result registers_polling(uint16_t a_slave_address,
+                             uint8_t a_register,
+                             const void* a_p_write_data,
+                             void* a_p_read_data,
+                             uint32_t a_data_size_in_bytes,
+                             cml::time::tick a_timeout);
+
+private:
+
+    I2C_timing::Bus bus_timing;
+    bool bus_timing_set;
+
  private:
 
      friend void i2c_master_interrupt_handler(I2C_master* a_p_this);
@@ -17,6 +17,9 @@
 
 //cml
 #include <cml/debug/assert.hpp>
+#ifdef CML_PROFILE_IRQ
+#include <cml/debug/profiler.hpp>
+#endif // CML_PROFILE_IRQ
 #include <cml/utils/wait.hpp>
 
 namespace {
@@ -65,6 +68,10 @@ void clear_USART_ISR_errors()
     set_flag(&(USART2->ICR), USART_ICR_PECF | USART_ICR_FECF | USART_ICR_ORECF | USART_ICR_NCF);
 }
 
+#ifdef CML_PROFILE_IRQ
+cml::debug::profiler::Zone usart2_irq_zone("USART2_IRQHandler");
+#endif // CML_PROFILE_IRQ
+
 } // namespace ::
 
 extern "C"
@@ -72,6 +79,10 @@ extern "C"
 
 void USART2_IRQHandler()
 {
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&usart2_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     assert((nullptr != p_usart_2 && nullptr == p_rs485) || (nullptr == p_usart_2 && nullptr != p_rs485));
 
     if (nullptr != p_usart_2)
@@ -114,7 +125,8 @@ void usart_interrupt_handler(USART* a_p_this)
             }
         }
 
-        if (true == is_flag(isr, USART_ISR_TC) &&
+        if (nullptr != a_p_this->tx_callback.function &&
+            true == is_flag(isr, USART_ISR_TC) &&
             true == is_flag(cr1, USART_CR1_TCIE))
         {
             if (false == a_p_this->tx_callback.function(nullptr, true, a_p_this->tx_callback.p_user_data))
@@ -180,7 +192,8 @@ void rs485_interrupt_handler(RS485* a_p_this)
             }
         }
 
-        if (true == is_flag(isr, USART_ISR_TC) &&
+        if (nullptr != a_p_this->tx_callback.function &&
+            true == is_flag(isr, USART_ISR_TC) &&
             true == is_flag(cr1, USART_CR1_TCIE))
         {
             if (false == a_p_this->tx_callback.function(nullptr, true, a_p_this->tx_callback.p_user_data))
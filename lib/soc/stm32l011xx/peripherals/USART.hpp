@@ -340,6 +340,31 @@ constexpr USART::Mode_flag operator |= (USART::Mode_flag& a_f1, USART::Mode_flag
     return a_f1;
 }
 
+//
+// Compile-time form of USART, for code shared with the other MCUs - the only instance here is addressed
+// directly already.
+//
+template<USART::Id id_t>
+class USART_t : public USART
+{
+    static_assert(USART::Id::_2 == id_t, "USART2 is the only USART instance of the L011");
+
+public:
+
+    static constexpr IRQn_Type irqn = USART2_IRQn;
+
+public:
+
+    USART_t()
+        : USART(id_t)
+    {}
+
+    static USART_TypeDef* get_registers()
+    {
+        return USART2;
+    }
+};
+
 } // namespace peripherals
 } // namespace stm32l011xx
 } // namespace soc
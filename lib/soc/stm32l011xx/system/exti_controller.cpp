@@ -18,6 +18,9 @@
 
 //cml
 #include <cml/debug/assert.hpp>
+#ifdef CML_PROFILE_IRQ
+#include <cml/debug/profiler.hpp>
+#endif // CML_PROFILE_IRQ
 
 namespace {
 
@@ -32,6 +35,12 @@ struct Handler
 
 Handler handlers[16];
 
+#ifdef CML_PROFILE_IRQ
+cml::debug::profiler::Zone exti0_1_irq_zone("EXTI0_1_IRQHandler");
+cml::debug::profiler::Zone exti2_3_irq_zone("EXTI2_3_IRQHandler");
+cml::debug::profiler::Zone exti4_15_irq_zone("EXTI4_15_IRQHandler");
+#endif // CML_PROFILE_IRQ
+
 } // namespace ::
 
 extern "C"
@@ -55,6 +64,10 @@ static bool interrupt_handler(uint32_t a_pr1, uint32_t a_index)
 
 void EXTI0_1_IRQHandler()
 {
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti0_1_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     for (uint32_t i = 0u; i <= 1u; i++)
     {
         if (true == interrupt_handler(EXTI->PR, i))
@@ -66,6 +79,10 @@ void EXTI0_1_IRQHandler()
 
 void EXTI2_3_IRQHandler()
 {
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti2_3_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     for (uint32_t i = 2u; i <= 3u; i++)
     {
         if (true == interrupt_handler(EXTI->PR, i))
@@ -77,6 +94,10 @@ void EXTI2_3_IRQHandler()
 
 void EXTI4_15_IRQHandler()
 {
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti4_15_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     for (uint32_t i = 4u; i <= 15u; i++)
     {
         if (true == interrupt_handler(EXTI->PR, i))
@@ -11,6 +11,7 @@
 #include <soc/stm32l452xx/misc.hpp>
 
 //soc
+#include <soc/Edge_clock.hpp>
 #include <soc/stm32l452xx/mcu.hpp>
 
 //cml
@@ -28,9 +29,11 @@ void misc::delay_us(time::tick a_time)
     assert(mcu::get_sysclk_frequency_hz() >= MHz(1));
     assert(a_time > 0);
 
-    DWT->CYCCNT = 0;
-    const uint32_t max = DWT->CYCCNT + (mcu::get_sysclk_frequency_hz() / MHz(1) * (a_time - 1));
-    while (DWT->CYCCNT < max);
+    // CYCCNT keeps running - profiler and latency stamps taken around the delay stay valid
+    Edge_clock clock;
+
+    clock.start();
+    clock.wait(mcu::get_sysclk_frequency_hz() / MHz(1) * a_time);
 }
 
 } // namespace stm32l452xx
@@ -12,10 +12,13 @@
 
 //soc
 #include <soc/counter.hpp>
-#include <soc/Interrupt_guard.hpp>
+#include <soc/Priority_guard.hpp>
 
 //cml
 #include <cml/debug/assert.hpp>
+#ifdef CML_PROFILE_IRQ
+#include <cml/debug/profiler.hpp>
+#endif // CML_PROFILE_IRQ
 #include <cml/utils/delay.hpp>
 #include <cml/utils/wait.hpp>
 
@@ -43,6 +46,10 @@ bool is_channel(ADC::Channel::Id a_type, const ADC::Channel* a_p_channels, uint3
     return found;
 }
 
+#ifdef CML_PROFILE_IRQ
+cml::debug::profiler::Zone adc1_irq_zone("ADC1_IRQHandler");
+#endif // CML_PROFILE_IRQ
+
 } // namespace ::
 
 extern "C"
@@ -50,6 +57,10 @@ extern "C"
 
 void ADC1_IRQHandler()
 {
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&adc1_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     assert(nullptr != p_adc_1);
     adc_interrupt_handler(p_adc_1);
 }
@@ -285,7 +296,7 @@ void ADC::register_conversion_callback(const Conversion_callback& a_callback)
     assert(nullptr != p_adc_1);
     assert(nullptr != a_callback.function);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(ADC1_IRQn));
 
     this->callaback = a_callback;
 
@@ -297,7 +308,7 @@ void ADC::unregister_conversion_callback()
 {
     assert(nullptr != p_adc_1);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(ADC1_IRQn));
 
     clear_flag(&(ADC1->IER), ADC_IER_EOCIE | ADC_IER_EOSIE);
     clear_flag(&(ADC1->CR), ADC_CR_ADSTART);
@@ -161,7 +161,13 @@ void pin::Out::toggle_level()
 {
     assert(nullptr != this->p_port && 0xFF != this->id);
 
-    toggle_bit(&(static_cast<GPIO_TypeDef*>(*(this->p_port))->ODR), this->id);
+    GPIO_TypeDef* p_registers = static_cast<GPIO_TypeDef*>(*(this->p_port));
+
+    const uint32_t odr = p_registers->ODR;
+    const uint32_t bit = 0x1u << this->id;
+
+    // through BSRR, a read-modify-write of ODR could undo an interrupt's write to another pin of the port
+    p_registers->BSRR = ((odr & bit) << 16u) | (~odr & bit);
 }
 
 void pin::Out::set_mode(Mode a_mode)
@@ -13,16 +13,20 @@
 //soc
 #include <soc/counter.hpp>
 #include <soc/Interrupt_guard.hpp>
+#include <soc/Priority_guard.hpp>
 #include <soc/stm32l452xx/mcu.hpp>
+#include <soc/stm32l452xx/system/dma_controller.hpp>
 
 //cml
 #include <cml/debug/assert.hpp>
+#include <cml/utils/delay.hpp>
 #include <cml/utils/wait.hpp>
 
 namespace {
 
 using namespace cml;
 using namespace soc::stm32l452xx::peripherals;
+using namespace soc::stm32l452xx::system;
 
 struct Controller
 {
@@ -46,12 +50,17 @@ void i2c_1_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
 
     NVIC_SetPriority(I2C1_EV_IRQn, a_irq_priority);
     NVIC_EnableIRQ(I2C1_EV_IRQn);
+
+    // errors of the queued transfers (ERRIE)
+    NVIC_SetPriority(I2C1_ER_IRQn, a_irq_priority);
+    NVIC_EnableIRQ(I2C1_ER_IRQn);
 }
 
 void i2c_1_disable()
 {
     clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C1EN);
     NVIC_DisableIRQ(I2C1_EV_IRQn);
+    NVIC_DisableIRQ(I2C1_ER_IRQn);
 }
 
 void i2c_2_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
@@ -63,12 +72,17 @@ void i2c_2_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
 
     NVIC_SetPriority(I2C2_EV_IRQn, a_irq_priority);
     NVIC_EnableIRQ(I2C2_EV_IRQn);
+
+    // errors of the queued transfers (ERRIE)
+    NVIC_SetPriority(I2C2_ER_IRQn, a_irq_priority);
+    NVIC_EnableIRQ(I2C2_ER_IRQn);
 }
 
 void i2c_2_disable()
 {
     clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C2EN);
     NVIC_DisableIRQ(I2C2_EV_IRQn);
+    NVIC_DisableIRQ(I2C2_ER_IRQn);
 }
 
 void i2c_3_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
@@ -80,12 +94,17 @@ void i2c_3_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
 
     NVIC_SetPriority(I2C3_EV_IRQn, a_irq_priority);
     NVIC_EnableIRQ(I2C3_EV_IRQn);
+
+    // errors of the queued transfers (ERRIE)
+    NVIC_SetPriority(I2C3_ER_IRQn, a_irq_priority);
+    NVIC_EnableIRQ(I2C3_ER_IRQn);
 }
 
 void i2c_3_disable()
 {
     clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_I2C3EN);
     NVIC_DisableIRQ(I2C3_EV_IRQn);
+    NVIC_DisableIRQ(I2C3_ER_IRQn);
 }
 
 void i2c_4_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
@@ -97,14 +116,21 @@ void i2c_4_enable(uint32_t a_clock_source, uint32_t a_irq_priority)
 
     NVIC_SetPriority(I2C4_EV_IRQn, a_irq_priority);
     NVIC_EnableIRQ(I2C4_EV_IRQn);
+
+    // errors of the queued transfers (ERRIE)
+    NVIC_SetPriority(I2C4_ER_IRQn, a_irq_priority);
+    NVIC_EnableIRQ(I2C4_ER_IRQn);
 }
 
 void i2c_4_disable()
 {
     clear_flag(&(RCC->APB1ENR2), RCC_APB1ENR2_I2C4EN);
     NVIC_DisableIRQ(I2C4_EV_IRQn);
+    NVIC_DisableIRQ(I2C4_ER_IRQn);
 }
 
+constexpr IRQn_Type i2c_irqn_lut[] = { I2C1_EV_IRQn, I2C2_EV_IRQn, I2C3_EV_IRQn, I2C4_EV_IRQn };
+
 bool is_I2C_ISR_error(uint32_t a_isr)
 {
     return is_any_bit(a_isr, I2C_ISR_TIMEOUT |
@@ -115,6 +141,13 @@ bool is_I2C_ISR_error(uint32_t a_isr)
                              I2C_ISR_NACKF);
 }
 
+// TIMEOUT and BERR, or an arbitration lost with the bus still busy - no STOP is seen on it
+bool is_I2C_bus_stuck(uint32_t a_isr)
+{
+    return true == is_any_bit(a_isr, I2C_ISR_TIMEOUT | I2C_ISR_BERR) ||
+           (true == is_flag(a_isr, I2C_ISR_ARLO) && true == is_flag(a_isr, I2C_ISR_BUSY));
+}
+
 void clear_I2C_ISR_errors(volatile uint32_t* a_p_icr)
 {
     set_flag(a_p_icr, I2C_ICR_TIMOUTCF |
@@ -149,9 +182,120 @@ I2C_base::Bus_status_flag get_bus_status_flag_from_I2C_ISR(uint32_t a_isr)
         ret |= I2C_base::Bus_status_flag::nack;
     }
 
+    if (true == is_flag(a_isr, I2C_ISR_PECERR))
+    {
+        ret |= I2C_base::Bus_status_flag::crc_error;
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TIMEOUT))
+    {
+        ret |= I2C_base::Bus_status_flag::timeout;
+    }
+
     return ret;
 }
 
+// NBYTES and the end mode of the next chunk of a segment: RELOAD while more than 255 bytes are left, then
+// AUTOEND (STOP) if the segment ends the transaction or software end (TC) if a read segment follows
+uint32_t get_I2C_CR2_chunk(uint32_t a_remaining, bool a_last_segment)
+{
+    if (a_remaining > 255u)
+    {
+        return (255u << I2C_CR2_NBYTES_Pos) | I2C_CR2_RELOAD;
+    }
+
+    return (a_remaining << I2C_CR2_NBYTES_Pos) | (true == a_last_segment ? I2C_CR2_AUTOEND : 0);
+}
+
+// drops the transfer in progress and releases the lines, the configuration registers are kept
+void reset_I2C(I2C_TypeDef* a_p_registers)
+{
+    clear_flag(&(a_p_registers->CR1), I2C_CR1_PE);
+
+    // PE has to stay low for 3 APB cycles, every read of CR1 takes one at least
+    for (uint32_t i = 0; i < 3u; i++)
+    {
+        static_cast<void>(a_p_registers->CR1);
+    }
+
+    set_flag(&(a_p_registers->CR1), I2C_CR1_PE);
+}
+
+// bytes of the write segment not sent yet, the register address included
+uint32_t get_write_remaining(const I2C_master::Transaction* a_p_transaction)
+{
+    return a_p_transaction->write_size_in_bytes - a_p_transaction->written +
+           (true == a_p_transaction->register_addressed && false == a_p_transaction->register_address_sent ? 1u : 0u);
+}
+
+constexpr uint32_t transaction_interrupts = I2C_CR1_TXIE   |
+                                            I2C_CR1_RXIE   |
+                                            I2C_CR1_TCIE   |
+                                            I2C_CR1_STOPIE |
+                                            I2C_CR1_NACKIE |
+                                            I2C_CR1_ERRIE;
+
+// the data moves by DMA, TXIS and RXNE are DMA requests then
+constexpr uint32_t transaction_dma_interrupts = I2C_CR1_TCIE   |
+                                                I2C_CR1_STOPIE |
+                                                I2C_CR1_NACKIE |
+                                                I2C_CR1_ERRIE;
+
+constexpr uint32_t slave_dma_interrupts = I2C_CR1_ADDRIE |
+                                          I2C_CR1_STOPIE |
+                                          I2C_CR1_NACKIE |
+                                          I2C_CR1_ERRIE;
+
+struct DMA_lines
+{
+    dma_controller::Id id      = dma_controller::Id::_1;
+    dma_controller::Channel tx = dma_controller::Channel::_1;
+    dma_controller::Channel rx = dma_controller::Channel::_1;
+    uint32_t request           = 0;
+};
+
+// see RM0394 "DMA1 / DMA2 requests for each channel" - I2C1 goes to DMA2, its DMA1 channels are the USART2 ones
+const DMA_lines dma_lines[] =
+{
+    { dma_controller::Id::_2, dma_controller::Channel::_7, dma_controller::Channel::_6, 0x5u },
+    { dma_controller::Id::_1, dma_controller::Channel::_4, dma_controller::Channel::_5, 0x3u },
+    { dma_controller::Id::_1, dma_controller::Channel::_2, dma_controller::Channel::_3, 0x3u },
+    { dma_controller::Id::_2, dma_controller::Channel::_2, dma_controller::Channel::_1, 0x0u }
+};
+
+void start_DMA_channel(dma_controller::Id a_id,
+                       dma_controller::Channel a_channel,
+                       volatile uint32_t* a_p_peripheral,
+                       const void* a_p_memory,
+                       uint32_t a_size_in_bytes,
+                       bool a_to_peripheral)
+{
+    assert(a_size_in_bytes <= 0xFFFFu);
+
+    DMA_Channel_TypeDef* p_channel = dma_controller::get_channel_registers(a_id, a_channel);
+
+    p_channel->CCR   = 0;
+    p_channel->CPAR  = reinterpret_cast<uint32_t>(a_p_peripheral);
+    p_channel->CMAR  = reinterpret_cast<uint32_t>(a_p_memory);
+    p_channel->CNDTR = a_size_in_bytes;
+    p_channel->CCR   = (true == a_to_peripheral ? DMA_CCR_DIR : 0) | DMA_CCR_MINC | DMA_CCR_TEIE | DMA_CCR_EN;
+}
+
+// returns the bytes not transferred
+uint32_t stop_DMA_channel(dma_controller::Id a_id, dma_controller::Channel a_channel)
+{
+    DMA_Channel_TypeDef* p_channel = dma_controller::get_channel_registers(a_id, a_channel);
+
+    p_channel->CCR = 0;
+
+    return p_channel->CNDTR;
+}
+
+uint32_t get_DMA_channel_remaining(dma_controller::Id a_id, dma_controller::Channel a_channel)
+{
+    return dma_controller::get_channel_registers(a_id, a_channel)->CNDTR;
+}
+
 I2C_base::Clock_source get_clock_source_from_RCC_CCIPR(I2C_base::Id a_id)
 {
     switch (a_id)
@@ -160,8 +304,8 @@ I2C_base::Clock_source get_clock_source_from_RCC_CCIPR(I2C_base::Id a_id)
         case I2C_base::Id::_2:
         case I2C_base::Id::_3:
         {
-            return static_cast<I2C_base::Clock_source>(get_flag(RCC->CCIPR,
-                                                                0x3 << (RCC_CCIPR_I2C1SEL_Pos + static_cast<uint32_t>(a_id) * 2)) >> RCC_CCIPR_I2C1SEL_Pos);
+            const uint32_t position = RCC_CCIPR_I2C1SEL_Pos + static_cast<uint32_t>(a_id) * 2;
+            return static_cast<I2C_base::Clock_source>(get_flag(RCC->CCIPR, 0x3u << position) >> position);
         }
         break;
 
@@ -208,43 +352,44 @@ Controller controllers[]
 extern "C"
 {
 
-void interupt_handler(uint32_t a_controller_index)
+void I2C1_EV_IRQHandler()
 {
-    assert(nullptr != controllers[a_controller_index].p_i2c_master_handle ||
-           nullptr != controllers[a_controller_index].p_i2c_slave_handle);
-
-    if (nullptr != controllers[a_controller_index].p_i2c_master_handle)
-    {
-        i2c_master_interrupt_handler(controllers[a_controller_index].p_i2c_master_handle);
-    }
-    else if (nullptr != controllers[a_controller_index].p_i2c_slave_handle)
-    {
-        i2c_slave_interrupt_handler(controllers[a_controller_index].p_i2c_slave_handle);
-    }
-    else
-    {
-        assert(false);
-    }
+    i2c_interrupt_handler<I2C_base::Id::_1>();
 }
 
-void I2C1_EV_IRQHandler()
+void I2C1_ER_IRQHandler()
 {
-    interupt_handler(0);
+    i2c_interrupt_handler<I2C_base::Id::_1>();
 }
 
 void I2C2_EV_IRQHandler()
 {
-    interupt_handler(1);
+    i2c_interrupt_handler<I2C_base::Id::_2>();
+}
+
+void I2C2_ER_IRQHandler()
+{
+    i2c_interrupt_handler<I2C_base::Id::_2>();
 }
 
 void I2C3_EV_IRQHandler()
 {
-    interupt_handler(2);
+    i2c_interrupt_handler<I2C_base::Id::_3>();
+}
+
+void I2C3_ER_IRQHandler()
+{
+    i2c_interrupt_handler<I2C_base::Id::_3>();
 }
 
 void I2C4_EV_IRQHandler()
 {
-    interupt_handler(3);
+    i2c_interrupt_handler<I2C_base::Id::_4>();
+}
+
+void I2C4_ER_IRQHandler()
+{
+    i2c_interrupt_handler<I2C_base::Id::_4>();
 }
 
 } // extern "C"
@@ -256,16 +401,34 @@ namespace peripherals {
 using namespace cml;
 using namespace cml::utils;
 
-void I2C_base::bus_status_interrupt_handler(uint32_t a_isr)
+I2C_master::Interrupt_context I2C_master::interrupt_contexts[4];
+I2C_slave::Interrupt_context I2C_slave::interrupt_contexts[4];
+
+// bound to the instance at compile time - the registers and the interrupt context are constant addresses,
+// OA1EN (set by I2C_slave::enable only) tells the role the instance is in
+template<I2C_base::Id id_t>
+void i2c_interrupt_handler()
+{
+    if (true == is_flag(I2C_slave::get_registers(id_t)->OAR1, I2C_OAR1_OA1EN))
+    {
+        I2C_slave::interrupt_handler<id_t>();
+    }
+    else
+    {
+        I2C_master::interrupt_handler<id_t>();
+    }
+}
+
+void I2C_base::bus_status_interrupt_handler(I2C_TypeDef* a_p_registers, Interrupt_context* a_p_context, uint32_t a_isr)
 {
-    if (nullptr != this->bus_status_callback.function)
+    if (nullptr != a_p_context->bus_status_callback.function)
     {
         I2C_base::Bus_status_flag status = get_bus_status_flag_from_I2C_ISR(a_isr);
 
         if (I2C_base::Bus_status_flag::ok != status &&
-            true == this->bus_status_callback.function(status, this->bus_status_callback.p_user_data))
+            true == a_p_context->bus_status_callback.function(status, a_p_context->bus_status_callback.p_user_data))
         {
-            clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+            clear_I2C_ISR_errors(&(a_p_registers->ICR));
         }
     }
 }
@@ -275,83 +438,160 @@ bool I2C_base::is_enabled() const
     return is_flag(controllers[static_cast<uint32_t>(this->id)].p_registers->CR1, I2C_CR1_PE);
 }
 
-void I2C_base::rxne_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
+void I2C_base::rxne_interrupt_handler(I2C_TypeDef* a_p_registers,
+                                      Interrupt_context* a_p_context,
+                                      uint32_t a_isr,
+                                      uint32_t a_cr1)
 {
     if (true == is_flag(a_isr, I2C_ISR_RXNE) && true == is_flag(a_cr1, I2C_CR1_RXIE))
     {
-        this->rx_callback.function(static_cast<uint8_t>(this->p_i2c->RXDR), false, this->rx_callback.p_user_data);
+        a_p_context->rx_callback.function(static_cast<uint8_t>(a_p_registers->RXDR),
+                                          false,
+                                          a_p_context->rx_callback.p_user_data);
     }
 }
 
-void I2C_base::txe_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
+void I2C_base::txe_interrupt_handler(I2C_TypeDef* a_p_registers,
+                                     Interrupt_context* a_p_context,
+                                     uint32_t a_isr,
+                                     uint32_t a_cr1)
 {
     if (true == is_flag(a_isr, I2C_ISR_TXE) && true == is_flag(a_cr1, I2C_CR1_TXIE))
     {
-        this->tx_callback.function(reinterpret_cast<volatile uint32_t*>(&(this->p_i2c->TXDR)),
-                                   false,
-                                   this->tx_callback.p_user_data);
+        a_p_context->tx_callback.function(reinterpret_cast<volatile uint32_t*>(&(a_p_registers->TXDR)),
+                                          false,
+                                          a_p_context->tx_callback.p_user_data);
     }
 }
 
-void I2C_base::stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1)
+void I2C_base::stopf_interrupt_handler(I2C_TypeDef* a_p_registers,
+                                       Interrupt_context* a_p_context,
+                                       uint32_t a_isr,
+                                       uint32_t a_cr1)
 {
     if (true == is_flag(a_isr, I2C_ISR_STOPF) && true == is_flag(a_cr1, I2C_CR1_STOPIE))
     {
-        if (nullptr != this->tx_callback.function)
+        if (nullptr != a_p_context->tx_callback.function)
         {
-            this->tx_callback.function(nullptr, true, this->tx_callback.p_user_data);
+            a_p_context->tx_callback.function(nullptr, true, a_p_context->tx_callback.p_user_data);
 
-            clear_flag(&(this->p_i2c->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
+            clear_flag(&(a_p_registers->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 
-            this->tx_callback = { nullptr, nullptr };
+            a_p_context->tx_callback = { nullptr, nullptr };
         }
 
-        if (nullptr != this->rx_callback.function)
+        if (nullptr != a_p_context->rx_callback.function)
         {
-            this->rx_callback.function(0, true, this->rx_callback.p_user_data);
+            a_p_context->rx_callback.function(0, true, a_p_context->rx_callback.p_user_data);
 
-            clear_flag(&(this->p_i2c->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
+            clear_flag(&(a_p_registers->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 
-            this->rx_callback = { nullptr, nullptr };
+            a_p_context->rx_callback = { nullptr, nullptr };
         }
 
-        set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+        set_flag(&(a_p_registers->ICR), I2C_ICR_STOPCF);
+    }
+}
+
+template<I2C_base::Id id_t>
+void I2C_master::interrupt_handler()
+{
+    I2C_TypeDef* const p_registers = get_registers(id_t);
+    Interrupt_context* p_context   = &(interrupt_contexts[static_cast<uint32_t>(id_t)]);
+
+    const uint32_t isr = p_registers->ISR;
+    const uint32_t cr1 = p_registers->CR1;
+
+    if (nullptr != p_context->p_queue_head)
+    {
+        transaction_interrupt_handler(id_t, isr);
+        return;
+    }
+
+    bus_status_interrupt_handler(p_registers, p_context, isr);
+
+    // cleared here, not only by an accepting bus status callback, or it would be counted again on every interrupt
+    if (true == is_flag(isr, I2C_ISR_NACKF))
+    {
+        count_nack(p_context, Bus_status_flag::nack);
+        set_flag(&(p_registers->ICR), I2C_ICR_NACKCF);
+    }
+
+    // ERRIE is on with the bus recovery only - no STOP comes after an error, the callback transfer ends here
+    if (true == is_bus_recovery_enabled(*p_context) &&
+        true == is_any_bit(isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_PECERR | I2C_ISR_TIMEOUT))
+    {
+        abort_transfer(id_t, is_I2C_bus_stuck(isr));
+        stopf_interrupt_handler(p_registers, p_context, I2C_ISR_STOPF, cr1);
+        return;
     }
+
+    rxne_interrupt_handler(p_registers, p_context, isr, cr1);
+    txe_interrupt_handler(p_registers, p_context, isr, cr1);
+    stopf_interrupt_handler(p_registers, p_context, isr, cr1);
 }
 
-void i2c_master_interrupt_handler(I2C_master* a_p_this)
+template<I2C_base::Id id_t>
+void I2C_master::dma_interrupt_handler(uint32_t a_flags, void*)
 {
-    const uint32_t isr = a_p_this->p_i2c->ISR;
-    const uint32_t cr1 = a_p_this->p_i2c->CR1;
+    const Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(id_t)];
+
+    // transfer complete is seen by the I2C (TC / STOPF), only the errors matter - not of a timed out transaction,
+    // the I2C interrupt finishes it
+    if (true == is_flag(a_flags, DMA_ISR_TEIF1) &&
+        nullptr != context.p_queue_head &&
+        false == context.transaction_timed_out)
+    {
+        I2C_TypeDef* const p_registers = get_registers(id_t);
 
-    a_p_this->bus_status_interrupt_handler(isr);
-    a_p_this->rxne_interrupt_handler(isr, cr1);
-    a_p_this->txe_interrupt_handler(isr, cr1);
-    a_p_this->stopf_interrupt_handler(isr, cr1);
+        reset_I2C(p_registers);
+        clear_I2C_ISR_errors(&(p_registers->ICR));
+
+        finish_transaction(id_t, context.p_queue_head->bus_status | Bus_status_flag::buffer_error);
+    }
 }
 
-void i2c_slave_interrupt_handler(I2C_slave* a_p_this)
+template<I2C_base::Id id_t>
+void I2C_slave::interrupt_handler()
 {
-    const uint32_t isr = a_p_this->p_i2c->ISR;
-    const uint32_t cr1 = a_p_this->p_i2c->CR1;
+    I2C_TypeDef* const p_registers = get_registers(id_t);
+    Interrupt_context* p_context   = &(interrupt_contexts[static_cast<uint32_t>(id_t)]);
+
+    const uint32_t isr = p_registers->ISR;
+    const uint32_t cr1 = p_registers->CR1;
+
+    if (true == p_context->dma_busy)
+    {
+        dma_transfer_interrupt_handler(id_t, isr);
+        return;
+    }
 
     if (true == is_flag(isr, I2C_ISR_NACKF) &&
-        nullptr != a_p_this->tx_callback.function)
+        nullptr != p_context->tx_callback.function)
     {
-        set_flag(&(a_p_this->p_i2c->ICR), I2C_ICR_NACKCF);
+        set_flag(&(p_registers->ICR), I2C_ICR_NACKCF);
     }
     else
     {
-        a_p_this->bus_status_interrupt_handler(isr);
+        bus_status_interrupt_handler(p_registers, p_context, isr);
     }
 
-    a_p_this->rxne_interrupt_handler(isr, cr1);
-    a_p_this->txe_interrupt_handler(isr, cr1);
-    a_p_this->stopf_interrupt_handler(isr, cr1);
+    rxne_interrupt_handler(p_registers, p_context, isr, cr1);
+    txe_interrupt_handler(p_registers, p_context, isr, cr1);
+    stopf_interrupt_handler(p_registers, p_context, isr, cr1);
 
     if (true == is_flag(isr, I2C_ISR_ADDR) && true == is_flag(cr1, I2C_CR1_ADDRIE))
     {
-        set_flag(&(a_p_this->p_i2c->ICR), I2C_ICR_ADDRCF);
+        set_flag(&(p_registers->ICR), I2C_ICR_ADDRCF);
+    }
+}
+
+template<I2C_base::Id id_t>
+void I2C_slave::dma_interrupt_handler(uint32_t a_flags, void*)
+{
+    if (true == is_flag(a_flags, DMA_ISR_TEIF1) && true == interrupt_contexts[static_cast<uint32_t>(id_t)].dma_busy)
+    {
+        finish_dma(id_t, Bus_status_flag::buffer_error);
     }
 }
 
@@ -360,6 +600,32 @@ I2C_base::Clock_source I2C_base::get_clock_source() const
     return get_clock_source_from_RCC_CCIPR(this->id);
 }
 
+frequency I2C_base::get_clock_frequency_hz() const
+{
+    switch (this->get_clock_source())
+    {
+        case Clock_source::pclk1:
+        {
+            return soc::stm32l452xx::mcu::get_pclk1_frequency_hz();
+        }
+        break;
+
+        case Clock_source::sysclk:
+        {
+            return mcu::get_sysclk_frequency_hz();
+        }
+        break;
+
+        case Clock_source::hsi:
+        {
+            return mcu::get_hsi_frequency_hz();
+        }
+        break;
+    }
+
+    return 0;
+}
+
 void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uint32_t a_irq_priority)
 {
     assert(false   == this->is_enabled());
@@ -373,6 +639,7 @@ void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uin
     this->p_i2c = controllers[static_cast<uint32_t>(this->id)].p_registers;
 
     this->p_i2c->CR1     = 0;
+    this->p_i2c->OAR1    = 0;
     this->p_i2c->TIMINGR = a_config.timings;
 
     this->p_i2c->CR1 = (false == a_config.analog_filter ? I2C_CR1_ANFOFF : 0) |
@@ -387,10 +654,45 @@ void I2C_master::enable(const Config& a_config, Clock_source a_clock_source, uin
     }
 }
 
+bool I2C_master::set_timing(const I2C_timing::Bus& a_bus)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr == this->get_interrupt_context().p_queue_head);
+
+    const I2C_timing::Result timing = I2C_timing::calculate(this->get_clock_frequency_hz(), a_bus);
+
+    if (false == timing.valid)
+    {
+        return false;
+    }
+
+    // TIMINGR, ANFOFF and DNF are write protected while PE is set
+    const uint32_t cr1 = this->p_i2c->CR1 & ~(I2C_CR1_ANFOFF | I2C_CR1_DNF | I2C_CR1_PE);
+
+    this->p_i2c->CR1     = cr1;
+    this->p_i2c->TIMINGR = timing.get_timingr();
+    this->p_i2c->CR1     = cr1 | (false == a_bus.analog_filter ? I2C_CR1_ANFOFF : 0) |
+                           (a_bus.digital_filter << I2C_CR1_DNF_Pos);
+
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_PE);
+
+    this->bus_timing     = a_bus;
+    this->bus_timing_set = true;
+
+    return true;
+}
+
 void I2C_master::diasble()
 {
     assert(nullptr != this->p_i2c);
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
+    assert(nullptr == this->get_interrupt_context().p_queue_head);
+    assert(false == this->is_bus_recovery_in_progress());
+
+    if (true == this->get_interrupt_context().dma_enabled)
+    {
+        this->disable_dma();
+    }
 
     this->p_i2c->CR1 = 0;
 
@@ -402,6 +704,12 @@ void I2C_master::diasble()
     controllers[static_cast<uint32_t>(this->id)].disable();
     controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle = nullptr;
 
+    // the context belongs to the instance, the next handle enabled on it starts with no callbacks
+    this->get_interrupt_context().tx_callback         = { nullptr, nullptr };
+    this->get_interrupt_context().rx_callback         = { nullptr, nullptr };
+    this->get_interrupt_context().bus_status_callback = { nullptr, nullptr };
+    this->get_interrupt_context().bus_recovery_config = Bus_recovery_config();
+
     this->p_i2c = nullptr;
 }
 
@@ -435,13 +743,25 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
 
     if (true == error)
     {
-        bus_status = get_bus_status_flag_from_I2C_ISR(this->p_i2c->ISR);
-        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+        const uint32_t isr = this->p_i2c->ISR;
+
+        bus_status = get_bus_status_flag_from_I2C_ISR(isr);
+
+        if (true == is_I2C_bus_stuck(isr))
+        {
+            this->abort_transfer_polling(true);
+        }
+        else
+        {
+            clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+        }
     }
 
     set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
     this->p_i2c->CR2 = 0;
 
+    count_nack(&(this->get_interrupt_context()), bus_status);
+
     return { bus_status, words };
 }
 
@@ -481,13 +801,31 @@ I2C_master::Result I2C_master::transmit_bytes_polling(uint16_t a_slave_address,
 
     if (true == error)
     {
-        bus_status = get_bus_status_flag_from_I2C_ISR(this->p_i2c->ISR);
-        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+        const uint32_t isr = this->p_i2c->ISR;
+
+        bus_status = get_bus_status_flag_from_I2C_ISR(isr);
+
+        if (true == is_I2C_bus_stuck(isr))
+        {
+            this->abort_transfer_polling(true);
+        }
+        else
+        {
+            clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+        }
+    }
+    else if (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF))
+    {
+        // timed out, no STOP is coming either
+        bus_status = Bus_status_flag::timeout;
+        this->abort_transfer_polling(true);
     }
 
     set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
     this->p_i2c->CR2 = 0;
 
+    count_nack(&(this->get_interrupt_context()), bus_status);
+
     return { bus_status, words };
 }
 
@@ -521,13 +859,25 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
 
     if (true == error)
     {
-        bus_status = get_bus_status_flag_from_I2C_ISR(this->p_i2c->ISR);
-        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+        const uint32_t isr = this->p_i2c->ISR;
+
+        bus_status = get_bus_status_flag_from_I2C_ISR(isr);
+
+        if (true == is_I2C_bus_stuck(isr))
+        {
+            this->abort_transfer_polling(true);
+        }
+        else
+        {
+            clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+        }
     }
 
     set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
     this->p_i2c->CR2 = 0;
 
+    count_nack(&(this->get_interrupt_context()), bus_status);
+
     return { bus_status, words };
 }
 
@@ -567,13 +917,31 @@ I2C_master::Result I2C_master::receive_bytes_polling(uint16_t a_slave_address,
 
     if (true == error)
     {
-        bus_status = get_bus_status_flag_from_I2C_ISR(this->p_i2c->ISR);
-        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+        const uint32_t isr = this->p_i2c->ISR;
+
+        bus_status = get_bus_status_flag_from_I2C_ISR(isr);
+
+        if (true == is_I2C_bus_stuck(isr))
+        {
+            this->abort_transfer_polling(true);
+        }
+        else
+        {
+            clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+        }
+    }
+    else if (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF))
+    {
+        // timed out, no STOP is coming either
+        bus_status = Bus_status_flag::timeout;
+        this->abort_transfer_polling(true);
     }
 
     set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
     this->p_i2c->CR2 = 0;
 
+    count_nack(&(this->get_interrupt_context()), bus_status);
+
     return { bus_status, words };
 }
 
@@ -586,10 +954,10 @@ void I2C_master::register_transmit_callback(uint16_t a_slave_address,
     assert(nullptr != a_callback.function);
     assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->rx_callback = { nullptr, nullptr };
-    this->tx_callback = a_callback;
+    this->get_interrupt_context().rx_callback = { nullptr, nullptr };
+    this->get_interrupt_context().tx_callback = a_callback;
 
     const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
     const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
@@ -607,10 +975,10 @@ void I2C_master::register_receive_callback(uint16_t a_slave_address,
     assert(nullptr != a_callback.function);
     assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->tx_callback = { nullptr, nullptr };
-    this->rx_callback = a_callback;
+    this->get_interrupt_context().tx_callback = { nullptr, nullptr };
+    this->get_interrupt_context().rx_callback = a_callback;
 
     const uint32_t address_mask   = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
     const uint32_t data_size_mask = static_cast<uint32_t>(a_data_size_in_bytes) << I2C_CR2_NBYTES_Pos;
@@ -624,9 +992,9 @@ void I2C_master::register_bus_status_callback(const Bus_status_callback& a_callb
     assert(nullptr != this->p_i2c);
     assert(nullptr != a_callback.function);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->bus_status_callback = a_callback;
+    this->get_interrupt_context().bus_status_callback = a_callback;
     set_flag(&(this->p_i2c->CR1), I2C_CR1_NACKIE);
 }
 
@@ -634,11 +1002,11 @@ void I2C_master::unregister_bus_status_callback()
 {
     assert(nullptr != this->p_i2c);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     clear_flag(&(this->p_i2c->CR1), I2C_CR1_NACKIE);
 
-    this->bus_status_callback = { nullptr, nullptr };
+    this->get_interrupt_context().bus_status_callback = { nullptr, nullptr };
 }
 
 bool I2C_master::is_slave_connected(uint16_t a_slave_address, time::tick a_timeout) const
@@ -669,58 +1037,724 @@ bool I2C_master::is_slave_connected(uint16_t a_slave_address, time::tick a_timeo
     return ret;
 }
 
-void I2C_slave::enable(const Config& a_config, Clock_source a_clock_source, uint32_t a_irq_priority)
+I2C_master::Result I2C_master::registers_polling(uint16_t a_slave_address,
+                                                 uint8_t a_register,
+                                                 const void* a_p_write_data,
+                                                 void* a_p_read_data,
+                                                 uint32_t a_data_size_in_bytes,
+                                                 time::tick a_timeout)
 {
-    assert(false   == this->is_enabled());
-    assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
-    assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
-    assert(a_config.address <= 0x7F);
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
+    assert(nullptr == this->get_interrupt_context().p_queue_head);
+    assert((nullptr != a_p_write_data) != (nullptr != a_p_read_data));
+    assert(a_data_size_in_bytes > 0);
 
-    controllers[static_cast<uint32_t>(this->id)].enable(get_RCC_CCIPR_from_clock_source(a_clock_source, this->id),
-                                                      a_irq_priority);
+    const time::tick start = counter::get();
 
-    controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle = this;
-    this->p_i2c = controllers[static_cast<uint32_t>(this->id)].p_registers;
+    const bool reading          = nullptr != a_p_read_data;
+    const uint32_t address_mask = (static_cast<uint32_t>(a_slave_address) << 1) & I2C_CR2_SADD;
 
-    this->p_i2c->CR1     = 0;
-    this->p_i2c->TIMINGR = a_config.timings;
+    // the register address opens the write segment, a read follows it after TC with a repeated START
+    this->p_i2c->CR2 = address_mask |
+                       get_I2C_CR2_chunk(1u + (true == reading ? 0 : a_data_size_in_bytes), false == reading) |
+                       I2C_CR2_START;
 
-    this->p_i2c->OAR1 = I2C_OAR1_OA1EN | (a_config.address << 1);
-    this->p_i2c->CR1  = (false == a_config.analog_filter ? I2C_CR1_ANFOFF : 0) |
-                        (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)|
-                        I2C_CR1_PE;
+    uint32_t bytes             = 0;
+    bool register_address_sent = false;
+    bool error                 = false;
+    bool timeout               = false;
+    Bus_status_flag bus_status = Bus_status_flag::ok;
 
-    if (true == a_config.fast_plus)
+    while (false == is_flag(this->p_i2c->ISR, I2C_ISR_STOPF) && false == error && false == timeout)
     {
-        assert(true == mcu::is_syscfg_enabled());
+        const uint32_t isr = this->p_i2c->ISR;
 
-        set_bit(&(SYSCFG->CFGR1), SYSCFG_CFGR1_I2C1_FMP_Pos + static_cast<uint32_t>(this->id));
-    }
-}
+        if (true == is_flag(isr, I2C_ISR_NACKF))
+        {
+            // STOP follows on its own
+            set_flag(&(this->p_i2c->ICR), I2C_ICR_NACKCF);
+            bus_status |= Bus_status_flag::nack;
+        }
 
-void I2C_slave::diasble()
-{
-    assert(nullptr != this->p_i2c);
-    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+        if (true == is_flag(isr, I2C_ISR_TXIS))
+        {
+            if (false == register_address_sent)
+            {
+                this->p_i2c->TXDR     = a_register;
+                register_address_sent = true;
+            }
+            else if (bytes < a_data_size_in_bytes)
+            {
+                this->p_i2c->TXDR = static_cast<const uint8_t*>(a_p_write_data)[bytes++];
+            }
+        }
 
-    this->p_i2c->CR1 = 0;
+        if (true == is_flag(isr, I2C_ISR_RXNE))
+        {
+            const uint8_t data = static_cast<uint8_t>(this->p_i2c->RXDR);
 
-    if (true == this->is_fast_plus())
+            if (bytes < a_data_size_in_bytes)
+            {
+                static_cast<uint8_t*>(a_p_read_data)[bytes++] = data;
+            }
+        }
+
+        if (true == is_flag(isr, I2C_ISR_TCR))
+        {
+            this->p_i2c->CR2 = (this->p_i2c->CR2 & ~(I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_AUTOEND)) |
+                               get_I2C_CR2_chunk(a_data_size_in_bytes - bytes, true);
+        }
+        else if (true == is_flag(isr, I2C_ISR_TC))
+        {
+            this->p_i2c->CR2 = address_mask |
+                               get_I2C_CR2_chunk(a_data_size_in_bytes, true) |
+                               I2C_CR2_RD_WRN |
+                               I2C_CR2_START;
+        }
+
+        error   = is_any_bit(isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_PECERR | I2C_ISR_TIMEOUT);
+        timeout = a_timeout > 0 && time::diff(counter::get(), start) > a_timeout;
+    }
+
+    // the STOP may be seen before the RXNE of the last byte (the loop delayed by an interrupt) - it is still in RXDR
+    while (true == reading && bytes < a_data_size_in_bytes && true == is_flag(this->p_i2c->ISR, I2C_ISR_RXNE))
     {
-        clear_bit(&(SYSCFG->CFGR1), SYSCFG_CFGR1_I2C1_FMP_Pos + static_cast<uint32_t>(this->id));
+        static_cast<uint8_t*>(a_p_read_data)[bytes++] = static_cast<uint8_t>(this->p_i2c->RXDR);
     }
 
-    controllers[static_cast<uint32_t>(this->id)].disable();
-    controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle = nullptr;
+    if (true == error || true == timeout)
+    {
+        // no STOP is coming, the transfer is dropped
+        const uint32_t isr = this->p_i2c->ISR;
 
-    this->p_i2c = nullptr;
+        bus_status |= get_bus_status_flag_from_I2C_ISR(isr) |
+                      (true == timeout ? Bus_status_flag::timeout : Bus_status_flag::ok);
+
+        this->abort_transfer_polling(true == timeout || true == is_I2C_bus_stuck(isr));
+    }
+
+    set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+    this->p_i2c->CR2 = 0;
+
+    count_nack(&(this->get_interrupt_context()), bus_status);
+
+    return { bus_status, bytes };
 }
 
-I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_bytes)
+void I2C_master::enqueue(Transaction* a_p_transaction)
 {
     assert(nullptr != this->p_i2c);
-    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
-    assert(nullptr != a_p_data);
+    assert(nullptr != a_p_transaction);
+    assert(false == a_p_transaction->pending);
+    assert(0 == a_p_transaction->write_size_in_bytes || nullptr != a_p_transaction->p_write_data);
+    assert(0 == a_p_transaction->read_size_in_bytes || nullptr != a_p_transaction->p_read_data);
+
+    Interrupt_context& context = this->get_interrupt_context();
+
+    Interrupt_guard guard;
+
+    a_p_transaction->p_next  = nullptr;
+    a_p_transaction->pending = true;
+
+    if (nullptr == context.p_queue_head)
+    {
+        context.p_queue_head = a_p_transaction;
+        context.p_queue_tail = a_p_transaction;
+
+        // started by 'update' once the bus is recovered otherwise
+        if (Bus_recovery_step::idle == context.bus_recovery_step)
+        {
+            start_transaction(this->id, a_p_transaction);
+        }
+    }
+    else
+    {
+        context.p_queue_tail->p_next = a_p_transaction;
+        context.p_queue_tail         = a_p_transaction;
+    }
+}
+
+void I2C_master::update()
+{
+    assert(nullptr != this->p_i2c);
+
+    Interrupt_context& context = this->get_interrupt_context();
+
+    if (Bus_recovery_step::idle != context.bus_recovery_step)
+    {
+        // 'enqueue' holds the queue for the recovery, from any priority
+        Interrupt_guard guard;
+
+        if (true == advance_bus_recovery(this->id) &&
+            nullptr != context.p_queue_head &&
+            false == context.transaction_timed_out)
+        {
+            start_transaction(this->id, context.p_queue_head);
+        }
+
+        return;
+    }
+
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
+
+    Transaction* p_transaction = context.p_queue_head;
+
+    if (nullptr != p_transaction &&
+        false == context.transaction_timed_out &&
+        p_transaction->timeout > 0 &&
+        time::diff(counter::get(), p_transaction->start) > p_transaction->timeout)
+    {
+        abort_transfer(this->id, true);
+        set_flag(&(this->p_i2c->ICR), I2C_ICR_STOPCF);
+
+        // finished from the interrupt handler, as every other transaction end
+        context.transaction_timed_out = true;
+        NVIC_SetPendingIRQ(i2c_irqn_lut[static_cast<uint32_t>(this->id)]);
+    }
+}
+
+void I2C_master::enable_dma()
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr == this->get_interrupt_context().p_queue_head);
+    assert(false == this->get_interrupt_context().dma_enabled);
+
+    constexpr dma_controller::Callback::Function dma_interrupt_handlers[] = { dma_interrupt_handler<Id::_1>,
+                                                                             dma_interrupt_handler<Id::_2>,
+                                                                             dma_interrupt_handler<Id::_3>,
+                                                                             dma_interrupt_handler<Id::_4> };
+
+    const DMA_lines& lines                       = dma_lines[static_cast<uint32_t>(this->id)];
+    const uint32_t priority                      = NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]);
+    const dma_controller::Callback::Function dma = dma_interrupt_handlers[static_cast<uint32_t>(this->id)];
+
+    dma_controller::enable_channel(lines.id, lines.tx, lines.request, priority, { dma, nullptr });
+    dma_controller::enable_channel(lines.id, lines.rx, lines.request, priority, { dma, nullptr });
+
+    this->get_interrupt_context().dma_enabled = true;
+}
+
+void I2C_master::disable_dma()
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr == this->get_interrupt_context().p_queue_head);
+    assert(true == this->get_interrupt_context().dma_enabled);
+
+    const DMA_lines& lines = dma_lines[static_cast<uint32_t>(this->id)];
+
+    clear_flag(&(this->p_i2c->CR1), I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN);
+
+    dma_controller::disable_channel(lines.id, lines.tx);
+    dma_controller::disable_channel(lines.id, lines.rx);
+
+    this->get_interrupt_context().dma_enabled = false;
+}
+
+void I2C_master::enable_bus_recovery(const Bus_recovery_config& a_config)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != a_config.p_scl_port && nullptr != a_config.p_sda_port);
+    assert(a_config.scl_pin < 16u && a_config.sda_pin < 16u);
+    assert(true == mcu::is_dwt_enabled());
+
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
+
+    this->get_interrupt_context().bus_recovery_config = a_config;
+
+    // TIDLE = 0 - TIMEOUTA counts SCL low in 2048 kernel clocks, writable with TIMOUTEN cleared only
+    this->p_i2c->TIMEOUTR = 0;
+
+    if (a_config.scl_low_timeout_us > 0)
+    {
+        const uint64_t clocks   = static_cast<uint64_t>(a_config.scl_low_timeout_us) * this->get_clock_frequency_hz() /
+                                  MHz(1);
+        const uint32_t timeouta = clocks >= 2048u ? static_cast<uint32_t>(clocks / 2048u) - 1u : 0u;
+
+        assert(timeouta <= (I2C_TIMEOUTR_TIMEOUTA >> I2C_TIMEOUTR_TIMEOUTA_Pos));
+
+        this->p_i2c->TIMEOUTR = (timeouta << I2C_TIMEOUTR_TIMEOUTA_Pos) | I2C_TIMEOUTR_TIMOUTEN;
+    }
+
+    set_flag(&(this->p_i2c->CR1), I2C_CR1_ERRIE);
+}
+
+void I2C_master::disable_bus_recovery()
+{
+    assert(nullptr != this->p_i2c);
+    assert(false == this->is_bus_recovery_in_progress());
+
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
+
+    this->p_i2c->TIMEOUTR = 0;
+
+    // the queue needs it still
+    if (nullptr == this->get_interrupt_context().p_queue_head)
+    {
+        clear_flag(&(this->p_i2c->CR1), I2C_CR1_ERRIE);
+    }
+
+    this->get_interrupt_context().bus_recovery_config = Bus_recovery_config();
+}
+
+bool I2C_master::recover_bus(Id a_id)
+{
+    const Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(a_id)];
+
+    // standard mode half period
+    constexpr time::tick half_period_us = 5u;
+
+    start_bus_recovery(a_id);
+
+    do
+    {
+        delay::us(half_period_us);
+    }
+    while (false == advance_bus_recovery(a_id));
+
+    return context.bus_idle_after_recovery;
+}
+
+void I2C_master::start_bus_recovery(Id a_id)
+{
+    Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(a_id)];
+
+    assert(true == is_bus_recovery_enabled(context));
+    assert(Bus_recovery_step::idle == context.bus_recovery_step);
+
+    const Bus_recovery_config& config = context.bus_recovery_config;
+
+    // the peripheral lets the lines go, the GPIO drives them from now on
+    clear_flag(&(get_registers(a_id)->CR1), I2C_CR1_PE);
+
+    pin::af::disable(config.p_scl_port, config.scl_pin);
+    pin::af::disable(config.p_sda_port, config.sda_pin);
+
+    pin::out::enable(config.p_scl_port,
+                     config.scl_pin,
+                     { pin::Mode::open_drain, config.af_config.pull, config.af_config.speed },
+                     &(context.bus_recovery_scl));
+    pin::out::enable(config.p_sda_port,
+                     config.sda_pin,
+                     { pin::Mode::open_drain, config.af_config.pull, config.af_config.speed },
+                     &(context.bus_recovery_sda));
+
+    context.bus_recovery_scl.set_level(pin::Level::high);
+    context.bus_recovery_sda.set_level(pin::Level::high);
+
+    context.bus_recovery_pulses = 0;
+    context.bus_recovery_step   = Bus_recovery_step::scl_high;
+}
+
+bool I2C_master::advance_bus_recovery(Id a_id)
+{
+    Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(a_id)];
+
+    pin::Out& scl = context.bus_recovery_scl;
+    pin::Out& sda = context.bus_recovery_sda;
+
+    switch (context.bus_recovery_step)
+    {
+        case Bus_recovery_step::scl_high:
+        {
+            // a slave holding SDA low gets the rest of its byte and the acknowledge clocked out, nine pulses at most
+            scl.set_level(pin::Level::low);
+
+            context.bus_recovery_step = pin::Level::low == sda.get_level() && context.bus_recovery_pulses < 9u ?
+                                        Bus_recovery_step::scl_low :
+                                        Bus_recovery_step::stop_scl_low;
+        }
+        break;
+
+        case Bus_recovery_step::scl_low:
+        {
+            scl.set_level(pin::Level::high);
+
+            context.bus_recovery_pulses++;
+            context.bus_recovery_step = Bus_recovery_step::scl_high;
+        }
+        break;
+
+        // STOP - SDA rises while SCL is high
+        case Bus_recovery_step::stop_scl_low:
+        {
+            sda.set_level(pin::Level::low);
+            context.bus_recovery_step = Bus_recovery_step::stop_sda_low;
+        }
+        break;
+
+        case Bus_recovery_step::stop_sda_low:
+        {
+            scl.set_level(pin::Level::high);
+            context.bus_recovery_step = Bus_recovery_step::stop_scl_high;
+        }
+        break;
+
+        case Bus_recovery_step::stop_scl_high:
+        {
+            sda.set_level(pin::Level::high);
+            context.bus_recovery_step = Bus_recovery_step::stop_sda_high;
+        }
+        break;
+
+        case Bus_recovery_step::stop_sda_high:
+        {
+            I2C_TypeDef* p_registers          = get_registers(a_id);
+            const Bus_recovery_config& config = context.bus_recovery_config;
+
+            context.bus_idle_after_recovery = pin::Level::high == scl.get_level() &&
+                                              pin::Level::high == sda.get_level();
+
+            pin::out::disable(&scl);
+            pin::out::disable(&sda);
+
+            pin::af::enable(config.p_scl_port, config.scl_pin, config.af_config);
+            pin::af::enable(config.p_sda_port, config.sda_pin, config.af_config);
+
+            p_registers->CR2 = 0;
+            clear_I2C_ISR_errors(&(p_registers->ICR));
+            set_flag(&(p_registers->CR1), I2C_CR1_PE);
+
+            context.bus_recovery_count++;
+            context.bus_recovery_step = Bus_recovery_step::idle;
+        }
+        break;
+
+        case Bus_recovery_step::idle:
+        {
+        }
+        break;
+    }
+
+    return Bus_recovery_step::idle == context.bus_recovery_step;
+}
+
+void I2C_master::abort_transfer(Id a_id, bool a_stuck)
+{
+    if (true == a_stuck && true == is_bus_recovery_enabled(interrupt_contexts[static_cast<uint32_t>(a_id)]))
+    {
+        start_bus_recovery(a_id);
+    }
+    else
+    {
+        I2C_TypeDef* p_registers = get_registers(a_id);
+
+        reset_I2C(p_registers);
+        clear_I2C_ISR_errors(&(p_registers->ICR));
+    }
+}
+
+void I2C_master::abort_transfer_polling(bool a_stuck)
+{
+    if (true == a_stuck && true == this->is_bus_recovery_enabled())
+    {
+        recover_bus(this->id);
+    }
+    else
+    {
+        reset_I2C(this->p_i2c);
+        clear_I2C_ISR_errors(&(this->p_i2c->ICR));
+    }
+}
+
+void I2C_master::start_transaction(Id a_id, Transaction* a_p_transaction)
+{
+    I2C_TypeDef* p_registers   = get_registers(a_id);
+    Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(a_id)];
+
+    a_p_transaction->bus_status            = Bus_status_flag::ok;
+    a_p_transaction->written               = 0;
+    a_p_transaction->read                  = 0;
+    a_p_transaction->start                 = counter::get();
+    a_p_transaction->register_address_sent = false;
+
+    const uint32_t address_mask = (static_cast<uint32_t>(a_p_transaction->slave_address) << 1) & I2C_CR2_SADD;
+    const uint32_t write_size   = get_write_remaining(a_p_transaction);
+
+    // a byte left in TXDR by a transfer cut short by NACK must not go out first
+    set_flag(&(p_registers->ISR), I2C_ISR_TXE);
+
+    if (true == context.dma_enabled)
+    {
+        const DMA_lines& lines = dma_lines[static_cast<uint32_t>(a_id)];
+
+        if (true == a_p_transaction->register_addressed)
+        {
+            // the register address waits in TXDR, the DMA follows with the data
+            p_registers->TXDR                      = a_p_transaction->register_address;
+            a_p_transaction->register_address_sent = true;
+        }
+
+        if (a_p_transaction->write_size_in_bytes > 0)
+        {
+            start_DMA_channel(lines.id,
+                              lines.tx,
+                              &(p_registers->TXDR),
+                              a_p_transaction->p_write_data,
+                              a_p_transaction->write_size_in_bytes,
+                              true);
+            set_flag(&(p_registers->CR1), I2C_CR1_TXDMAEN);
+        }
+
+        if (a_p_transaction->read_size_in_bytes > 0)
+        {
+            start_DMA_channel(lines.id,
+                              lines.rx,
+                              &(p_registers->RXDR),
+                              a_p_transaction->p_read_data,
+                              a_p_transaction->read_size_in_bytes,
+                              false);
+            set_flag(&(p_registers->CR1), I2C_CR1_RXDMAEN);
+        }
+
+        set_flag(&(p_registers->CR1), transaction_dma_interrupts);
+    }
+    else
+    {
+        set_flag(&(p_registers->CR1), transaction_interrupts);
+    }
+
+    if (write_size > 0 || 0 == a_p_transaction->read_size_in_bytes)
+    {
+        p_registers->CR2 = address_mask |
+                           get_I2C_CR2_chunk(write_size, 0 == a_p_transaction->read_size_in_bytes) |
+                           I2C_CR2_START;
+    }
+    else
+    {
+        p_registers->CR2 = address_mask |
+                           get_I2C_CR2_chunk(a_p_transaction->read_size_in_bytes, true) |
+                           I2C_CR2_RD_WRN |
+                           I2C_CR2_START;
+    }
+}
+
+void I2C_master::finish_transaction(Id a_id, Bus_status_flag a_bus_status)
+{
+    I2C_TypeDef* p_registers   = get_registers(a_id);
+    Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(a_id)];
+
+    Transaction* p_done = nullptr;
+
+    {
+        Interrupt_guard guard;
+
+        p_done = context.p_queue_head;
+
+        if (true == context.dma_enabled)
+        {
+            const DMA_lines& lines = dma_lines[static_cast<uint32_t>(a_id)];
+
+            clear_flag(&(p_registers->CR1), I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN);
+
+            if (p_done->write_size_in_bytes > 0)
+            {
+                p_done->written = p_done->write_size_in_bytes - stop_DMA_channel(lines.id, lines.tx);
+            }
+
+            if (p_done->read_size_in_bytes > 0)
+            {
+                p_done->read = p_done->read_size_in_bytes - stop_DMA_channel(lines.id, lines.rx);
+            }
+        }
+
+        context.p_queue_head = p_done->p_next;
+
+        p_done->p_next     = nullptr;
+        p_done->pending    = false;
+        p_done->bus_status = a_bus_status;
+
+        count_nack(&context, a_bus_status);
+
+        if (nullptr != context.p_queue_head)
+        {
+            // started by 'update' once the bus is recovered otherwise
+            if (Bus_recovery_step::idle == context.bus_recovery_step)
+            {
+                start_transaction(a_id, context.p_queue_head);
+            }
+        }
+        else
+        {
+            context.p_queue_tail = nullptr;
+            p_registers->CR2     = 0;
+
+            // NACKIE stays on for the bus status callback, ERRIE for the bus recovery
+            clear_flag(&(p_registers->CR1),
+                       transaction_interrupts &
+                       ~((nullptr != context.bus_status_callback.function ? I2C_CR1_NACKIE : 0) |
+                         (true == is_bus_recovery_enabled(context) ? I2C_CR1_ERRIE : 0)));
+        }
+    }
+
+    if (nullptr != p_done->callback.function)
+    {
+        p_done->callback.function(p_done, p_done->callback.p_user_data);
+    }
+}
+
+void I2C_master::transaction_interrupt_handler(Id a_id, uint32_t a_isr)
+{
+    I2C_TypeDef* p_registers   = get_registers(a_id);
+    Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(a_id)];
+
+    Transaction* p_transaction = context.p_queue_head;
+
+    if (true == context.transaction_timed_out)
+    {
+        // aborted by 'update' already
+        context.transaction_timed_out = false;
+        finish_transaction(a_id, p_transaction->bus_status | Bus_status_flag::timeout);
+        return;
+    }
+
+    if (true == is_any_bit(a_isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_PECERR | I2C_ISR_TIMEOUT))
+    {
+        // no STOP is coming after these
+        const Bus_status_flag bus_status = get_bus_status_flag_from_I2C_ISR(a_isr);
+
+        abort_transfer(a_id, is_I2C_bus_stuck(a_isr));
+        finish_transaction(a_id, p_transaction->bus_status | bus_status);
+        return;
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_NACKF))
+    {
+        // the peripheral sends STOP on its own, the transaction ends at STOPF
+        set_flag(&(p_registers->ICR), I2C_ICR_NACKCF);
+        p_transaction->bus_status |= Bus_status_flag::nack;
+    }
+
+    if (true == context.dma_enabled)
+    {
+        const DMA_lines& lines = dma_lines[static_cast<uint32_t>(a_id)];
+
+        // progress for the reload below, the flags of the data are DMA requests
+        if (p_transaction->write_size_in_bytes > 0)
+        {
+            p_transaction->written = p_transaction->write_size_in_bytes - get_DMA_channel_remaining(lines.id, lines.tx);
+        }
+
+        if (p_transaction->read_size_in_bytes > 0)
+        {
+            p_transaction->read = p_transaction->read_size_in_bytes - get_DMA_channel_remaining(lines.id, lines.rx);
+        }
+    }
+    else if (true == is_flag(a_isr, I2C_ISR_RXNE))
+    {
+        const uint8_t data = static_cast<uint8_t>(p_registers->RXDR);
+
+        if (p_transaction->read < p_transaction->read_size_in_bytes)
+        {
+            static_cast<uint8_t*>(p_transaction->p_read_data)[p_transaction->read++] = data;
+        }
+    }
+
+    if (false == context.dma_enabled && true == is_flag(a_isr, I2C_ISR_TXIS))
+    {
+        if (true == p_transaction->register_addressed && false == p_transaction->register_address_sent)
+        {
+            p_registers->TXDR                    = p_transaction->register_address;
+            p_transaction->register_address_sent = true;
+        }
+        else if (p_transaction->written < p_transaction->write_size_in_bytes)
+        {
+            p_registers->TXDR = static_cast<const uint8_t*>(p_transaction->p_write_data)[p_transaction->written++];
+        }
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_TCR))
+    {
+        const bool reading       = is_flag(p_registers->CR2, I2C_CR2_RD_WRN);
+        const uint32_t remaining = true == reading ? p_transaction->read_size_in_bytes - p_transaction->read :
+                                                     get_write_remaining(p_transaction);
+
+        p_registers->CR2 = (p_registers->CR2 & ~(I2C_CR2_NBYTES | I2C_CR2_RELOAD | I2C_CR2_AUTOEND)) |
+                           get_I2C_CR2_chunk(remaining, true == reading || 0 == p_transaction->read_size_in_bytes);
+    }
+    else if (true == is_flag(a_isr, I2C_ISR_TC))
+    {
+        // write segment done, the read segment starts with a repeated START
+        p_registers->CR2 = (p_registers->CR2 & I2C_CR2_SADD) |
+                           get_I2C_CR2_chunk(p_transaction->read_size_in_bytes, true) |
+                           I2C_CR2_RD_WRN |
+                           I2C_CR2_START;
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_STOPF))
+    {
+        set_flag(&(p_registers->ICR), I2C_ICR_STOPCF);
+        finish_transaction(a_id, p_transaction->bus_status);
+    }
+}
+
+void I2C_slave::enable(const Config& a_config, Clock_source a_clock_source, uint32_t a_irq_priority)
+{
+    assert(false   == this->is_enabled());
+    assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_i2c_master_handle);
+    assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+    assert(a_config.address <= 0x7F);
+
+    controllers[static_cast<uint32_t>(this->id)].enable(get_RCC_CCIPR_from_clock_source(a_clock_source, this->id),
+                                                      a_irq_priority);
+
+    controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle = this;
+    this->p_i2c = controllers[static_cast<uint32_t>(this->id)].p_registers;
+
+    this->p_i2c->CR1     = 0;
+    this->p_i2c->TIMINGR = a_config.timings;
+
+    this->p_i2c->OAR1 = I2C_OAR1_OA1EN | (a_config.address << 1);
+    this->p_i2c->CR1  = (false == a_config.analog_filter ? I2C_CR1_ANFOFF : 0) |
+                        (true == a_config.crc_enable ? I2C_CR1_PECEN : 0)|
+                        I2C_CR1_PE;
+
+    if (true == a_config.fast_plus)
+    {
+        assert(true == mcu::is_syscfg_enabled());
+
+        set_bit(&(SYSCFG->CFGR1), SYSCFG_CFGR1_I2C1_FMP_Pos + static_cast<uint32_t>(this->id));
+    }
+}
+
+void I2C_slave::diasble()
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+
+    if (true == this->get_interrupt_context().dma_busy)
+    {
+        const DMA_lines& lines = dma_lines[static_cast<uint32_t>(this->id)];
+
+        dma_controller::disable_channel(lines.id, true == this->get_interrupt_context().dma_transmit ? lines.tx : lines.rx);
+
+        this->get_interrupt_context().dma_callback = { nullptr, nullptr };
+        this->get_interrupt_context().dma_busy     = false;
+    }
+
+    this->p_i2c->CR1  = 0;
+    this->p_i2c->OAR1 = 0;
+
+    if (true == this->is_fast_plus())
+    {
+        clear_bit(&(SYSCFG->CFGR1), SYSCFG_CFGR1_I2C1_FMP_Pos + static_cast<uint32_t>(this->id));
+    }
+
+    controllers[static_cast<uint32_t>(this->id)].disable();
+    controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle = nullptr;
+
+    this->get_interrupt_context().tx_callback         = { nullptr, nullptr };
+    this->get_interrupt_context().rx_callback         = { nullptr, nullptr };
+    this->get_interrupt_context().bus_status_callback = { nullptr, nullptr };
+
+    this->p_i2c = nullptr;
+}
+
+I2C_slave::Result I2C_slave::transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_bytes)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+    assert(nullptr != a_p_data);
     assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
 
     constexpr uint32_t error_mask = I2C_ISR_TIMEOUT | I2C_ISR_PECERR | I2C_ISR_OVR | I2C_ISR_ARLO | I2C_ISR_BERR;
@@ -911,10 +1945,10 @@ void I2C_slave::register_transmit_callback(const TX_callback& a_callback, uint32
     assert(nullptr != a_callback.function);
     assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->rx_callback = { nullptr, nullptr };
-    this->tx_callback = a_callback;
+    this->get_interrupt_context().rx_callback = { nullptr, nullptr };
+    this->get_interrupt_context().tx_callback = a_callback;
 
     set_flag(&(this->p_i2c->CR1), I2C_CR1_TXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE | I2C_CR1_NACKIE);
 }
@@ -926,10 +1960,10 @@ void I2C_slave::register_receive_callback(const RX_callback& a_callback, uint32_
     assert(nullptr != a_callback.function);
     assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 255);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->tx_callback = { nullptr, nullptr };
-    this->rx_callback = a_callback;
+    this->get_interrupt_context().tx_callback = { nullptr, nullptr };
+    this->get_interrupt_context().rx_callback = a_callback;
 
     set_flag(&(this->p_i2c->CR1), I2C_CR1_RXIE | I2C_CR1_STOPIE | I2C_CR1_ADDRIE);
 }
@@ -939,9 +1973,9 @@ void I2C_slave::register_bus_status_callback(const Bus_status_callback& a_callba
     assert(nullptr != this->p_i2c);
     assert(nullptr != a_callback.function);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->bus_status_callback = a_callback;
+    this->get_interrupt_context().bus_status_callback = a_callback;
     set_flag(&(this->p_i2c->CR1), I2C_CR1_NACKIE | I2C_CR1_ADDRIE);
 }
 
@@ -949,11 +1983,156 @@ void I2C_slave::unregister_bus_status_callback()
 {
     assert(nullptr != this->p_i2c);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     clear_flag(&(this->p_i2c->CR1), I2C_CR1_NACKIE | I2C_CR1_ADDRIE);
 
-    this->bus_status_callback = { nullptr, nullptr };
+    this->get_interrupt_context().bus_status_callback = { nullptr, nullptr };
+}
+
+bool I2C_slave::transmit_bytes_dma(const void* a_p_data, uint32_t a_data_size_in_bytes, const DMA_callback& a_callback)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 0xFFFFu);
+    assert(nullptr == this->get_interrupt_context().tx_callback.function && nullptr == this->get_interrupt_context().rx_callback.function);
+
+    if (true == this->get_interrupt_context().dma_busy)
+    {
+        return false;
+    }
+
+    this->start_dma(true, a_p_data, a_data_size_in_bytes, a_callback);
+
+    return true;
+}
+
+bool I2C_slave::receive_bytes_dma(void* a_p_data, uint32_t a_data_size_in_bytes, const DMA_callback& a_callback)
+{
+    assert(nullptr != this->p_i2c);
+    assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_i2c_slave_handle);
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_bytes > 0 && a_data_size_in_bytes <= 0xFFFFu);
+    assert(nullptr == this->get_interrupt_context().tx_callback.function && nullptr == this->get_interrupt_context().rx_callback.function);
+
+    if (true == this->get_interrupt_context().dma_busy)
+    {
+        return false;
+    }
+
+    this->start_dma(false, a_p_data, a_data_size_in_bytes, a_callback);
+
+    return true;
+}
+
+void I2C_slave::start_dma(bool a_transmit, const void* a_p_data, uint32_t a_data_size_in_bytes, const DMA_callback& a_callback)
+{
+    constexpr dma_controller::Callback::Function dma_interrupt_handlers[] = { dma_interrupt_handler<Id::_1>,
+                                                                             dma_interrupt_handler<Id::_2>,
+                                                                             dma_interrupt_handler<Id::_3>,
+                                                                             dma_interrupt_handler<Id::_4> };
+
+    const DMA_lines& lines                       = dma_lines[static_cast<uint32_t>(this->id)];
+    const uint32_t priority                      = NVIC_GetPriority(i2c_irqn_lut[static_cast<uint32_t>(this->id)]);
+    const dma_controller::Callback::Function dma = dma_interrupt_handlers[static_cast<uint32_t>(this->id)];
+
+    Priority_guard guard(priority);
+
+    this->get_interrupt_context().dma_callback      = a_callback;
+    this->get_interrupt_context().dma_size_in_bytes = a_data_size_in_bytes;
+    this->get_interrupt_context().dma_transmit      = a_transmit;
+    this->get_interrupt_context().dma_busy          = true;
+
+    if (true == a_transmit)
+    {
+        dma_controller::enable_channel(lines.id, lines.tx, lines.request, priority, { dma, nullptr });
+        start_DMA_channel(lines.id, lines.tx, &(this->p_i2c->TXDR), a_p_data, a_data_size_in_bytes, true);
+
+        set_flag(&(this->p_i2c->CR1), I2C_CR1_TXDMAEN | slave_dma_interrupts);
+    }
+    else
+    {
+        dma_controller::enable_channel(lines.id, lines.rx, lines.request, priority, { dma, nullptr });
+        start_DMA_channel(lines.id, lines.rx, &(this->p_i2c->RXDR), a_p_data, a_data_size_in_bytes, false);
+
+        set_flag(&(this->p_i2c->CR1), I2C_CR1_RXDMAEN | slave_dma_interrupts);
+    }
+}
+
+void I2C_slave::finish_dma(Id a_id, Bus_status_flag a_bus_status)
+{
+    I2C_TypeDef* p_registers   = get_registers(a_id);
+    Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(a_id)];
+
+    const DMA_lines& lines                = dma_lines[static_cast<uint32_t>(a_id)];
+    const dma_controller::Channel channel = true == context.dma_transmit ? lines.tx : lines.rx;
+
+    uint32_t length = context.dma_size_in_bytes - stop_DMA_channel(lines.id, channel);
+
+    // a byte still in TXDR was fetched by the DMA but never clocked out
+    if (true == context.dma_transmit && false == is_flag(p_registers->ISR, I2C_ISR_TXE))
+    {
+        length--;
+        set_flag(&(p_registers->ISR), I2C_ISR_TXE);
+    }
+
+    dma_controller::disable_channel(lines.id, channel);
+
+    // ADDRIE and NACKIE stay on for the bus status callback
+    clear_flag(&(p_registers->CR1),
+               I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN |
+               (nullptr != context.bus_status_callback.function ? slave_dma_interrupts & ~(I2C_CR1_ADDRIE | I2C_CR1_NACKIE) :
+                                                                  slave_dma_interrupts));
+
+    const DMA_callback callback = context.dma_callback;
+
+    context.dma_callback = { nullptr, nullptr };
+    context.dma_busy     = false;
+
+    if (nullptr != callback.function)
+    {
+        callback.function(a_bus_status, length, callback.p_user_data);
+    }
+}
+
+void I2C_slave::dma_transfer_interrupt_handler(Id a_id, uint32_t a_isr)
+{
+    I2C_TypeDef* p_registers   = get_registers(a_id);
+    Interrupt_context& context = interrupt_contexts[static_cast<uint32_t>(a_id)];
+
+    if (true == is_any_bit(a_isr, I2C_ISR_ARLO | I2C_ISR_BERR | I2C_ISR_OVR | I2C_ISR_PECERR | I2C_ISR_TIMEOUT))
+    {
+        const Bus_status_flag bus_status = get_bus_status_flag_from_I2C_ISR(a_isr);
+
+        clear_I2C_ISR_errors(&(p_registers->ICR));
+        finish_dma(a_id, bus_status);
+
+        return;
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_ADDR))
+    {
+        if (true == context.dma_transmit)
+        {
+            // nothing stale goes out ahead of the buffer
+            set_flag(&(p_registers->ISR), I2C_ISR_TXE);
+        }
+
+        set_flag(&(p_registers->ICR), I2C_ICR_ADDRCF);
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_NACKF))
+    {
+        // the master ends its read with a NACK
+        set_flag(&(p_registers->ICR), I2C_ICR_NACKCF);
+    }
+
+    if (true == is_flag(a_isr, I2C_ISR_STOPF))
+    {
+        set_flag(&(p_registers->ICR), I2C_ICR_STOPCF);
+        finish_dma(a_id, Bus_status_flag::ok);
+    }
 }
 
 } // namespace peripherals
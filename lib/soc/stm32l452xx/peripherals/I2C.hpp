@@ -20,6 +20,10 @@
 #include <cml/type_traits.hpp>
 #include <cml/debug/assert.hpp>
 
+//soc
+#include <soc/I2C_timing.hpp>
+#include <soc/stm32l452xx/peripherals/GPIO.hpp>
+
 namespace soc {
 namespace stm32l452xx {
 namespace peripherals {
@@ -51,7 +55,8 @@ public:
         arbitration_lost = 0x4,
         misplaced        = 0x8,
         nack             = 0x10,
-        unknown          = 0x20
+        unknown          = 0x20,
+        timeout          = 0x40
     };
 
     struct Result
@@ -89,6 +94,9 @@ public:
     Clock_source get_clock_source() const;
     bool is_enabled() const;
 
+    // kernel clock of the current source
+    cml::frequency get_clock_frequency_hz() const;
+
     bool is_analog_filter() const
     {
         assert(nullptr != this->p_i2c);
@@ -115,6 +123,19 @@ public:
         return this->id;
     }
 
+protected:
+
+    //
+    // Everything the interrupts of an instance touch. There is one per instance, not per handle, so the handlers
+    // of a vector find it at a constant address instead of through the handle. I2C_master and I2C_slave extend it.
+    //
+    struct Interrupt_context
+    {
+        RX_callback rx_callback;
+        TX_callback tx_callback;
+        Bus_status_callback bus_status_callback;
+    };
+
 protected:
 
     I2C_base(Id a_id)
@@ -122,21 +143,34 @@ protected:
         , p_i2c(nullptr)
     {}
 
-    void bus_status_interrupt_handler(uint32_t a_isr);
-    void rxne_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
-    void txe_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
-    void stopf_interrupt_handler(uint32_t a_isr, uint32_t a_cr1);
+    static I2C_TypeDef* get_registers(Id a_id)
+    {
+        constexpr uintptr_t registers_addresses[] = { I2C1_BASE, I2C2_BASE, I2C3_BASE, I2C4_BASE };
+        return reinterpret_cast<I2C_TypeDef*>(registers_addresses[static_cast<uint32_t>(a_id)]);
+    }
+
+    static void bus_status_interrupt_handler(I2C_TypeDef* a_p_registers, Interrupt_context* a_p_context, uint32_t a_isr);
+    static void rxne_interrupt_handler(I2C_TypeDef* a_p_registers,
+                                       Interrupt_context* a_p_context,
+                                       uint32_t a_isr,
+                                       uint32_t a_cr1);
+    static void txe_interrupt_handler(I2C_TypeDef* a_p_registers,
+                                      Interrupt_context* a_p_context,
+                                      uint32_t a_isr,
+                                      uint32_t a_cr1);
+    static void stopf_interrupt_handler(I2C_TypeDef* a_p_registers,
+                                        Interrupt_context* a_p_context,
+                                        uint32_t a_isr,
+                                        uint32_t a_cr1);
 
 protected:
 
     Id id;
     mutable I2C_TypeDef* p_i2c;
-
-    RX_callback rx_callback;
-    TX_callback tx_callback;
-    Bus_status_callback bus_status_callback;
 };
 
+template<I2C_base::Id id_t> void i2c_interrupt_handler();
+
 constexpr I2C_base::Bus_status_flag operator | (I2C_base::Bus_status_flag a_f1, I2C_base::Bus_status_flag a_f2)
 {
     return static_cast<I2C_base::Bus_status_flag>(static_cast<uint32_t>(a_f1) | static_cast<uint32_t>(a_f2));
@@ -174,10 +208,73 @@ public:
         uint32_t timings    = 0;
     };
 
+    //
+    // Queued transfer: the write segment, then the read segment after a repeated START, then STOP. Either
+    // segment may be empty (both empty probes the address). Owned by the caller, it has to stay untouched
+    // until its callback runs - the results are valid from then on.
+    //
+    struct Transaction
+    {
+        struct Callback
+        {
+            using Function = void(*)(Transaction* a_p_transaction, void* a_p_user_data);
+
+            Function function = nullptr;
+            void* p_user_data = nullptr;
+        };
+
+        uint16_t slave_address = 0;
+
+        const void* p_write_data     = nullptr;
+        uint32_t write_size_in_bytes = 0;
+
+        void* p_read_data           = nullptr;
+        uint32_t read_size_in_bytes = 0;
+
+        // sent ahead of the write segment when set, see 'enqueue_read_registers' / 'enqueue_write_registers'
+        bool register_addressed  = false;
+        uint8_t register_address = 0;
+
+        // counter ticks from the START, 0 for none (see 'update')
+        cml::time::tick timeout = 0;
+
+        Callback callback;
+
+        // results
+        Bus_status_flag bus_status = Bus_status_flag::ok;
+        uint32_t written           = 0;
+        uint32_t read              = 0;
+
+        // queue bookkeeping
+        Transaction* p_next        = nullptr;
+        cml::time::tick start      = 0;
+        bool pending               = false;
+        bool register_address_sent = false;
+    };
+
+    //
+    // SCL and SDA with the alternate function configuration they are enabled with, see 'enable_bus_recovery'.
+    //
+    struct Bus_recovery_config
+    {
+        GPIO* p_scl_port = nullptr;
+        uint32_t scl_pin = 0;
+
+        GPIO* p_sda_port = nullptr;
+        uint32_t sda_pin = 0;
+
+        pin::af::Config af_config;
+
+        // clock stretch watchdog: SCL held low for longer ends the transfer with Bus_status_flag::timeout
+        // (TIMEOUTA, up to 4096 x 2048 kernel clocks), 0 for none
+        uint32_t scl_low_timeout_us = 0;
+    };
+
 public:
 
     I2C_master(Id a_id)
         : I2C_base(a_id)
+        , bus_timing_set(false)
     {}
 
     ~I2C_master()
@@ -190,6 +287,25 @@ public:
                 uint32_t a_irq_priority);
     void diasble();
 
+    //
+    // Solves TIMINGR for the current kernel clock (see I2C_timing) and sets it, with the filters of 'a_bus',
+    // in place of Config::timings. No transfer may be in progress. Returns false and leaves the peripheral as it
+    // was when the kernel clock cannot run the bus as requested.
+    //
+    bool set_timing(const I2C_timing::Bus& a_bus);
+
+    //
+    // Solves the timing of the last 'set_timing' again, for the kernel clock running now. Meant for the mcu post
+    // sysclk frequency change callback:
+    //     mcu::register_post_sysclk_frequency_change_callback(
+    //         { [](void* a_p_user_data) { static_cast<I2C_master*>(a_p_user_data)->update_timing(); }, &i2c });
+    //
+    bool update_timing()
+    {
+        assert(true == this->bus_timing_set);
+        return this->set_timing(this->bus_timing);
+    }
+
     template<typename Data_t>
     Result transmit_polling(uint16_t a_slave_address, const Data_t& a_data)
     {
@@ -232,6 +348,46 @@ public:
                                  uint32_t a_data_size_in_bytes,
                                  cml::time::tick a_timeout);
 
+    //
+    // Register access in one transaction: the register address, then a repeated START and the read (or the data
+    // right after the address for a write), then STOP. Transfers longer than 255 bytes are reloaded.
+    //
+    Result read_registers_polling(uint16_t a_slave_address,
+                                  uint8_t a_register,
+                                  void* a_p_data,
+                                  uint32_t a_data_size_in_bytes)
+    {
+        return this->registers_polling(a_slave_address, a_register, nullptr, a_p_data, a_data_size_in_bytes, 0);
+    }
+
+    Result read_registers_polling(uint16_t a_slave_address,
+                                  uint8_t a_register,
+                                  void* a_p_data,
+                                  uint32_t a_data_size_in_bytes,
+                                  cml::time::tick a_timeout)
+    {
+        assert(a_timeout > 0);
+        return this->registers_polling(a_slave_address, a_register, nullptr, a_p_data, a_data_size_in_bytes, a_timeout);
+    }
+
+    Result write_registers_polling(uint16_t a_slave_address,
+                                   uint8_t a_register,
+                                   const void* a_p_data,
+                                   uint32_t a_data_size_in_bytes)
+    {
+        return this->registers_polling(a_slave_address, a_register, a_p_data, nullptr, a_data_size_in_bytes, 0);
+    }
+
+    Result write_registers_polling(uint16_t a_slave_address,
+                                   uint8_t a_register,
+                                   const void* a_p_data,
+                                   uint32_t a_data_size_in_bytes,
+                                   cml::time::tick a_timeout)
+    {
+        assert(a_timeout > 0);
+        return this->registers_polling(a_slave_address, a_register, a_p_data, nullptr, a_data_size_in_bytes, a_timeout);
+    }
+
     void register_transmit_callback(uint16_t a_slave_address,
                                     const TX_callback& a_callback,
                                     uint32_t a_data_size_in_bytes);
@@ -245,9 +401,226 @@ public:
 
     bool is_slave_connected(uint16_t a_slave_address, cml::time::tick a_timeout) const;
 
- private:
+    //
+    // Appends the transaction to the queue, it goes on the bus at once if the queue was empty. Transactions run
+    // back-to-back from the interrupt handler, where their callbacks are called too (after the next one has
+    // been started). Safe from any interrupt priority, including the callbacks. Errors of the queued transfers
+    // are reported in the transaction only - not to the bus status callback. The polling and the callback
+    // transfers must not be used while the queue is not empty.
+    //
+    void enqueue(Transaction* a_p_transaction);
+
+    //
+    // Interrupt driven register access, on the queue. Sets the addressing of the transaction and enqueues it,
+    // the callback and the timeout are left as the caller set them.
+    //
+    void enqueue_read_registers(Transaction* a_p_transaction,
+                                uint16_t a_slave_address,
+                                uint8_t a_register,
+                                void* a_p_data,
+                                uint32_t a_data_size_in_bytes)
+    {
+        assert(nullptr != a_p_transaction);
+        assert(a_data_size_in_bytes > 0);
+
+        a_p_transaction->slave_address       = a_slave_address;
+        a_p_transaction->register_addressed  = true;
+        a_p_transaction->register_address    = a_register;
+        a_p_transaction->p_write_data        = nullptr;
+        a_p_transaction->write_size_in_bytes = 0;
+        a_p_transaction->p_read_data         = a_p_data;
+        a_p_transaction->read_size_in_bytes  = a_data_size_in_bytes;
+
+        this->enqueue(a_p_transaction);
+    }
 
-     friend void i2c_master_interrupt_handler(I2C_master* a_p_this);
+    void enqueue_write_registers(Transaction* a_p_transaction,
+                                 uint16_t a_slave_address,
+                                 uint8_t a_register,
+                                 const void* a_p_data,
+                                 uint32_t a_data_size_in_bytes)
+    {
+        assert(nullptr != a_p_transaction);
+        assert(a_data_size_in_bytes > 0);
+
+        a_p_transaction->slave_address       = a_slave_address;
+        a_p_transaction->register_addressed  = true;
+        a_p_transaction->register_address    = a_register;
+        a_p_transaction->p_write_data        = a_p_data;
+        a_p_transaction->write_size_in_bytes = a_data_size_in_bytes;
+        a_p_transaction->p_read_data         = nullptr;
+        a_p_transaction->read_size_in_bytes  = 0;
+
+        this->enqueue(a_p_transaction);
+    }
+
+    //
+    // Aborts the transaction on the bus once its timeout passed (Bus_status_flag::timeout). Call periodically,
+    // e.g. from the systick tick callback. The transaction is finished - its callback called and the next one
+    // started - by the interrupt handler, set pending here, never in the context of the caller. A bus recovery
+    // started by the interrupt handler or by a timeout is advanced here too, one SCL / SDA edge a call, so the
+    // calls have to be 5 us apart at least; the queue waits for its end.
+    //
+    void update();
+
+    bool is_queue_empty() const
+    {
+        return nullptr == this->get_interrupt_context().p_queue_head;
+    }
+
+    //
+    // Queued transactions move their data with DMA from here on (up to 65535 bytes a segment), the interrupt
+    // handler runs on the segment ends, STOP, NACK and errors only. Takes the DMA channels of the instance
+    // (TX / RX): I2C1 - DMA2 7 / 6, I2C2 - DMA1 4 / 5 (as USART1), I2C3 - DMA1 2 / 3 (as USART3),
+    // I2C4 - DMA2 2 / 1. The queue has to be empty.
+    //
+    void enable_dma();
+    void disable_dma();
+
+    bool is_dma_enabled() const
+    {
+        return this->get_interrupt_context().dma_enabled;
+    }
+
+    //
+    // From here on TIMEOUT, a bus error, an arbitration lost with the bus still busy and the timeouts of the
+    // polling transfers and the queue end with the bus recovery instead of a plain reset of the peripheral.
+    // ERRIE stays on, so a bus stuck between the transfers is seen too. The clock stretch watchdog is set for
+    // the kernel clock at the time of the call. The polling transfers run the recovery to its end with
+    // delay::us (the DWT has to be enabled), the interrupt handler and the queue timeout only start it -
+    // 'update' does the rest.
+    //
+    void enable_bus_recovery(const Bus_recovery_config& a_config);
+    void disable_bus_recovery();
+
+    bool is_bus_recovery_enabled() const
+    {
+        return is_bus_recovery_enabled(this->get_interrupt_context());
+    }
+
+    //
+    // Drops the transfer in progress and takes SCL and SDA over as open drain outputs. Clocks SCL (100 kHz) until
+    // a slave holding SDA low lets it go - nine pulses at most, for the rest of a byte and its acknowledge. Then
+    // sends STOP, gives the pins back to the peripheral and enables it again. Returns false if the bus is still
+    // not idle, e.g. a slave keeps SCL low. Blocks for about 100 us, no other recovery may be in progress.
+    //
+    bool recover_bus()
+    {
+        assert(nullptr != this->p_i2c);
+        return recover_bus(this->id);
+    }
+
+    bool is_bus_recovery_in_progress() const
+    {
+        return Bus_recovery_step::idle != this->get_interrupt_context().bus_recovery_step;
+    }
+
+    uint32_t get_bus_recovery_count() const
+    {
+        return this->get_interrupt_context().bus_recovery_count;
+    }
+
+    // transfers and transactions ended with NACK, 'is_slave_connected' probes not included
+    uint32_t get_nack_count() const
+    {
+        return this->get_interrupt_context().nack_count;
+    }
+
+    void clear_counters()
+    {
+        this->get_interrupt_context().bus_recovery_count = 0;
+        this->get_interrupt_context().nack_count         = 0;
+    }
+
+private:
+
+    // the bus lines driven by the recovery, at the end of each step
+    enum class Bus_recovery_step : uint32_t
+    {
+        idle,
+        scl_high,
+        scl_low,
+        stop_scl_low,
+        stop_sda_low,
+        stop_scl_high,
+        stop_sda_high
+    };
+
+    struct Interrupt_context : public I2C_base::Interrupt_context
+    {
+        Transaction* volatile p_queue_head = nullptr;
+        Transaction* p_queue_tail          = nullptr;
+
+        // set by 'update', the interrupt handler finishes the transaction with Bus_status_flag::timeout
+        volatile bool transaction_timed_out = false;
+
+        bool dma_enabled = false;
+
+        Bus_recovery_config bus_recovery_config;
+
+        volatile Bus_recovery_step bus_recovery_step = Bus_recovery_step::idle;
+        uint32_t bus_recovery_pulses                 = 0;
+        bool bus_idle_after_recovery                 = false;
+        pin::Out bus_recovery_scl;
+        pin::Out bus_recovery_sda;
+
+        volatile uint32_t bus_recovery_count = 0;
+        volatile uint32_t nack_count         = 0;
+    };
+
+private:
+
+    Interrupt_context& get_interrupt_context() const
+    {
+        return interrupt_contexts[static_cast<uint32_t>(this->id)];
+    }
+
+    Result registers_polling(uint16_t a_slave_address,
+                             uint8_t a_register,
+                             const void* a_p_write_data,
+                             void* a_p_read_data,
+                             uint32_t a_data_size_in_bytes,
+                             cml::time::tick a_timeout);
+
+    template<Id id_t> static void interrupt_handler();
+    template<Id id_t> static void dma_interrupt_handler(uint32_t a_flags, void* a_p_user_data);
+
+    static void start_transaction(Id a_id, Transaction* a_p_transaction);
+    static void finish_transaction(Id a_id, Bus_status_flag a_bus_status);
+    static void transaction_interrupt_handler(Id a_id, uint32_t a_isr);
+
+    // no STOP comes after an error or a timeout - 'a_stuck' ones are recovered when enabled, reset otherwise;
+    // the recovery is started only, 'update' advances it
+    static void abort_transfer(Id a_id, bool a_stuck);
+    void abort_transfer_polling(bool a_stuck);
+
+    static bool recover_bus(Id a_id);
+    static void start_bus_recovery(Id a_id);
+    static bool advance_bus_recovery(Id a_id);
+
+    static bool is_bus_recovery_enabled(const Interrupt_context& a_context)
+    {
+        return nullptr != a_context.bus_recovery_config.p_scl_port;
+    }
+
+    static void count_nack(Interrupt_context* a_p_context, Bus_status_flag a_bus_status)
+    {
+        if (Bus_status_flag::ok != (a_bus_status & Bus_status_flag::nack))
+        {
+            a_p_context->nack_count++;
+        }
+    }
+
+private:
+
+    I2C_timing::Bus bus_timing;
+    bool bus_timing_set;
+
+    static Interrupt_context interrupt_contexts[4];
+
+private:
+
+    template<Id id_t> friend void i2c_interrupt_handler();
 };
 
 class I2C_slave : public I2C_base
@@ -272,6 +645,14 @@ public:
         uint16_t address   = 0;
     };
 
+    struct DMA_callback
+    {
+        using Function = void(*)(Bus_status_flag a_bus_status, uint32_t a_data_length, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
 public:
 
     I2C_slave(Id a_id)
@@ -332,9 +713,52 @@ public:
     void register_bus_status_callback(const Bus_status_callback& a_callback);
     void unregister_bus_status_callback();
 
+    //
+    // One transfer with the master by DMA (channels as for I2C_master::enable_dma). The buffer is caller
+    // owned and has to stay valid until the callback, called from the interrupt handler at the STOP or on an
+    // error with the number of bytes that went over the bus. Interrupts on the address match, NACK, STOP and
+    // errors only. The master must not move more bytes than the buffer holds - the clock stays stretched then.
+    //
+    bool transmit_bytes_dma(const void* a_p_data, uint32_t a_data_size_in_bytes, const DMA_callback& a_callback);
+    bool receive_bytes_dma(void* a_p_data, uint32_t a_data_size_in_bytes, const DMA_callback& a_callback);
+
+    bool is_dma_busy() const
+    {
+        return true == this->get_interrupt_context().dma_busy;
+    }
+
+private:
+
+    struct Interrupt_context : public I2C_base::Interrupt_context
+    {
+        DMA_callback dma_callback;
+        uint32_t dma_size_in_bytes = 0;
+        bool dma_transmit          = false;
+        volatile bool dma_busy     = false;
+    };
+
+private:
+
+    Interrupt_context& get_interrupt_context() const
+    {
+        return interrupt_contexts[static_cast<uint32_t>(this->id)];
+    }
+
+    void start_dma(bool a_transmit, const void* a_p_data, uint32_t a_data_size_in_bytes, const DMA_callback& a_callback);
+
+    template<Id id_t> static void interrupt_handler();
+    template<Id id_t> static void dma_interrupt_handler(uint32_t a_flags, void* a_p_user_data);
+
+    static void finish_dma(Id a_id, Bus_status_flag a_bus_status);
+    static void dma_transfer_interrupt_handler(Id a_id, uint32_t a_isr);
+
+private:
+
+    static Interrupt_context interrupt_contexts[4];
+
 private:
 
-    friend void i2c_slave_interrupt_handler(I2C_slave* a_p_this);
+    template<Id id_t> friend void i2c_interrupt_handler();
 };
 
 } // namespace peripherals
@@ -14,68 +14,61 @@
 
 //soc
 #include <soc/counter.hpp>
-#include <soc/Interrupt_guard.hpp>
+#include <soc/Priority_guard.hpp>
+#include <soc/stm32l452xx/system/dma_controller.hpp>
 
 //cml
 #include <cml/debug/assert.hpp>
+#ifdef CML_PROFILE_IRQ
+#include <cml/debug/profiler.hpp>
+#endif // CML_PROFILE_IRQ
+#ifdef CML_TRACE_LATENCY
+#include <cml/debug/latency.hpp>
+#endif // CML_TRACE_LATENCY
 #include <cml/utils/wait.hpp>
 
+namespace soc {
+namespace stm32l452xx {
+namespace peripherals {
+
+template<USART::Id id_t> void usart_interrupt_handler();
+template<USART::Id id_t> void usart_dma_tx_interrupt_handler(bool a_transfer_error);
+template<USART::Id id_t> void usart_dma_rx_interrupt_handler(bool a_idle);
+template<USART::Id id_t> void usart_dma_rx_error_handler();
+
+} // namespace peripherals
+} // namespace stm32l452xx
+} // namespace soc
+
 namespace {
 
 using namespace cml;
 using namespace soc;
 using namespace soc::stm32l452xx::peripherals;
+using namespace soc::stm32l452xx::system;
 
-void usart_1_enable(USART::Clock::Source a_clock_source, uint32_t a_irq_priority)
+template<USART::Id id_t>
+void usart_enable(USART::Clock::Source a_clock_source, uint32_t a_irq_priority)
 {
     assert(a_clock_source != USART::Clock::Source::unknown);
 
-    constexpr uint32_t clock_source_lut[] = { 0, RCC_CCIPR_USART1SEL_0, RCC_CCIPR_USART1SEL_1 };
-    set_flag(&(RCC->CCIPR), RCC_CCIPR_USART1SEL, clock_source_lut[static_cast<uint32_t>(a_clock_source)]);
-    set_flag(&(RCC->APB2ENR), RCC_APB2ENR_USART1EN);
+    constexpr uint32_t clock_source_lut[] = { 0x0u, 0x1u, 0x2u };
+    set_flag(&(RCC->CCIPR),
+             0x3u << USART_t<id_t>::rcc_clock_select_position,
+             clock_source_lut[static_cast<uint32_t>(a_clock_source)] << USART_t<id_t>::rcc_clock_select_position);
+    set_flag(reinterpret_cast<volatile uint32_t*>(USART_t<id_t>::rcc_enable_register_address),
+             USART_t<id_t>::rcc_enable_flag);
 
-    NVIC_SetPriority(USART1_IRQn, a_irq_priority);
-    NVIC_EnableIRQ(USART1_IRQn);
+    NVIC_SetPriority(USART_t<id_t>::irqn, a_irq_priority);
+    NVIC_EnableIRQ(USART_t<id_t>::irqn);
 }
 
-void usart_1_disable()
+template<USART::Id id_t>
+void usart_disable()
 {
-    clear_flag(&(RCC->APB2ENR), RCC_APB2ENR_USART1EN);
-    NVIC_DisableIRQ(USART1_IRQn);
-}
-
-void usart_2_enable(USART::Clock::Source a_clock_source, uint32_t a_irq_priority)
-{
-    assert(a_clock_source != USART::Clock::Source::unknown);
-
-    constexpr uint32_t clock_source_lut[] = { 0, RCC_CCIPR_USART2SEL_0, RCC_CCIPR_USART2SEL_1 };
-    set_flag(&(RCC->CCIPR), RCC_CCIPR_USART2SEL, clock_source_lut[static_cast<uint32_t>(a_clock_source)]);
-    set_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_USART2EN);
-
-    NVIC_SetPriority(USART2_IRQn, a_irq_priority);
-    NVIC_EnableIRQ(USART2_IRQn);
-}
-
-void usart_2_disable()
-{
-    clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_USART2EN);
-    NVIC_DisableIRQ(USART2_IRQn);
-}
-
-void usart_3_enable(USART::Clock::Source a_clock_source, uint32_t a_irq_priority)
-{
-    constexpr uint32_t clock_source_lut[] = { 0, RCC_CCIPR_USART3SEL_0, RCC_CCIPR_USART3SEL_1 };
-    set_flag(&(RCC->CCIPR), RCC_CCIPR_USART3SEL, clock_source_lut[static_cast<int32_t>(a_clock_source)]);
-    set_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_USART3EN);
-
-    NVIC_SetPriority(USART3_IRQn, a_irq_priority);
-    NVIC_EnableIRQ(USART3_IRQn);
-}
-
-void usart_3_disable()
-{
-    clear_flag(&(RCC->APB1ENR1), RCC_APB1ENR1_USART3EN);
-    NVIC_DisableIRQ(USART3_IRQn);
+    clear_flag(reinterpret_cast<volatile uint32_t*>(USART_t<id_t>::rcc_enable_register_address),
+               USART_t<id_t>::rcc_enable_flag);
+    NVIC_DisableIRQ(USART_t<id_t>::irqn);
 }
 
 bool is_USART_ISR_error(uint32_t a_isr)
@@ -130,44 +123,256 @@ struct Controller
 
 Controller controllers[] =
 {
-    { USART1, nullptr, nullptr, usart_1_enable, usart_1_disable },
-    { USART2, nullptr, nullptr, usart_2_enable, usart_2_disable },
-    { USART3, nullptr, nullptr, usart_3_enable, usart_3_disable }
+    { USART1, nullptr, nullptr, usart_enable<USART::Id::_1>, usart_disable<USART::Id::_1> },
+    { USART2, nullptr, nullptr, usart_enable<USART::Id::_2>, usart_disable<USART::Id::_2> },
+    { USART3, nullptr, nullptr, usart_enable<USART::Id::_3>, usart_disable<USART::Id::_3> }
 };
 
-} // namespace ::
+struct DMA_lines
+{
+    dma_controller::Channel tx = dma_controller::Channel::_1;
+    dma_controller::Channel rx = dma_controller::Channel::_1;
+};
 
-extern "C"
+// DMA1 channels with request 2 (CxS = 0b0010) selected, see RM0394 "DMA1 requests for each channel"
+constexpr uint32_t dma_usart_request = 0x2u;
+
+const DMA_lines dma_lines[] =
+{
+    { dma_controller::Channel::_4, dma_controller::Channel::_5 },
+    { dma_controller::Channel::_7, dma_controller::Channel::_6 },
+    { dma_controller::Channel::_2, dma_controller::Channel::_3 }
+};
+
+constexpr IRQn_Type usart_irqn_lut[] = { USART1_IRQn, USART2_IRQn, USART3_IRQn };
+
+DMA_Channel_TypeDef* get_DMA_channel_registers(dma_controller::Channel a_channel)
+{
+    return dma_controller::get_channel_registers(dma_controller::Id::_1, a_channel);
+}
+
+uint32_t get_DMA_CCR_size_flags(const USART::Frame_format& a_frame_format)
+{
+    if (USART::Parity::none == a_frame_format.parity && USART::Word_length::_9_bit == a_frame_format.word_length)
+    {
+        return DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0;
+    }
+
+    return 0;
+}
+
+// registers of a USART_t for the polling below - the address is a constant in the code using them
+template<USART::Id id_t>
+struct Fixed_registers
+{
+    USART_TypeDef* operator -> () const
+    {
+        return USART_t<id_t>::get_registers();
+    }
+};
+
+bool is_9_bit_data(const USART::Frame_format& a_frame_format)
+{
+    return USART::Parity::none == a_frame_format.parity && USART::Word_length::_9_bit == a_frame_format.word_length;
+}
+
+// 'a_registers' is the USART_TypeDef* of the handle or Fixed_registers of a USART_t, 0 'a_timeout_ms' for none
+template<typename Registers_t>
+USART::Result usart_transmit_polling(Registers_t a_registers,
+                                     bool a_9_bit_data,
+                                     const void* a_p_data,
+                                     uint32_t a_data_size_in_words,
+                                     time::tick a_timeout_ms)
+{
+    const time::tick start = a_timeout_ms > 0 ? counter::get() : 0;
+
+    set_flag(&(a_registers->ICR), USART_ICR_TCCF);
+
+    uint32_t words = 0;
+    bool error = false;
+    USART::Bus_status_flag bus_status = USART::Bus_status_flag::ok;
+
+    while (false == is_flag(a_registers->ISR, USART_ISR_TC) &&
+           false == error &&
+           (0 == a_timeout_ms || a_timeout_ms >= time::diff(counter::get(), start)))
+    {
+        if (true == is_flag(a_registers->ISR, USART_ISR_TXE) && words < a_data_size_in_words)
+        {
+            if (true == a_9_bit_data)
+            {
+                a_registers->TDR = (static_cast<const uint16_t*>(a_p_data)[words++]) & 0x1FFu;
+            }
+            else
+            {
+                a_registers->TDR = (static_cast<const uint8_t*>(a_p_data)[words++]) & 0xFFu;
+            }
+        }
+
+        error = is_USART_ISR_error(a_registers->ISR);
+    }
+
+    if (true == error)
+    {
+        bus_status = get_bus_status_flag_from_USART_ISR(a_registers->ISR);
+        clear_USART_ISR_errors(&(a_registers->ICR));
+    }
+
+    return { bus_status, words };
+}
+
+template<typename Registers_t>
+USART::Result usart_receive_polling(Registers_t a_registers,
+                                    bool a_9_bit_data,
+                                    void* a_p_data,
+                                    uint32_t a_data_size_in_words,
+                                    time::tick a_timeout_ms)
+{
+    const time::tick start = a_timeout_ms > 0 ? counter::get() : 0;
+
+    set_flag(&(a_registers->ICR), USART_ICR_IDLECF);
+
+    uint32_t words = 0;
+    bool error = false;
+    USART::Bus_status_flag bus_status = USART::Bus_status_flag::ok;
+
+    while (false == is_flag(a_registers->ISR, USART_ISR_IDLE) &&
+           false == error &&
+           (0 == a_timeout_ms || a_timeout_ms >= time::diff(counter::get(), start)))
+    {
+        if (true == is_flag(a_registers->ISR, USART_ISR_RXNE))
+        {
+            if (words < a_data_size_in_words)
+            {
+                if (true == a_9_bit_data)
+                {
+                    static_cast<uint16_t*>(a_p_data)[words++] = (a_registers->RDR & 0x1FFu);
+                }
+                else
+                {
+                    static_cast<uint8_t*>(a_p_data)[words++] = (a_registers->RDR & 0xFFu);
+                }
+            }
+            else
+            {
+                set_flag(&(a_registers->RQR), USART_RQR_RXFRQ);
+                words++;
+            }
+        }
+
+        error = is_USART_ISR_error(a_registers->ISR);
+    }
+
+    if (true == error)
+    {
+        bus_status = get_bus_status_flag_from_USART_ISR(a_registers->ISR);
+        clear_USART_ISR_errors(&(a_registers->ICR));
+    }
+
+    return { bus_status, words };
+}
+
+#ifdef CML_PROFILE_IRQ
+cml::debug::profiler::Zone usart1_irq_zone("USART1_IRQHandler");
+#endif // CML_PROFILE_IRQ
+
+#ifdef CML_TRACE_LATENCY
+#ifndef CML_TRACE_LATENCY_USART
+#define CML_TRACE_LATENCY_USART 1
+#endif // CML_TRACE_LATENCY_USART
+
+static_assert(CML_TRACE_LATENCY_USART >= 1 && CML_TRACE_LATENCY_USART <= 3);
+
+// the only instance stamping latency::Path::usart_rx, on its RXNE interrupts only - other instances and causes
+// would overwrite the stamps of the byte measured
+constexpr USART::Id latency_traced_usart = static_cast<USART::Id>(CML_TRACE_LATENCY_USART - 1);
+
+// taken at the handler entry, stored as the 'vector' stage once the cause turns out to be RXNE
+volatile uint32_t latency_vector_cycles = 0;
+#endif // CML_TRACE_LATENCY
+
+// bound to the instance at compile time - the USART path works on the registers and the interrupt context of
+// USART_t<id_t>, both constant addresses. Only an RS485 on the same instance is reached through its handle.
+template<USART::Id id_t>
+void interrupt_handler()
 {
+#ifdef CML_TRACE_LATENCY
+    if constexpr (latency_traced_usart == id_t)
+    {
+        latency_vector_cycles = cml::hal::core::get_cycle_counter();
+    }
+#endif // CML_TRACE_LATENCY
 
-static void interrupt_handler(uint32_t a_index)
+    RS485* p_rs485_handle = controllers[static_cast<uint32_t>(id_t)].p_rs485_handle;
+
+    if (nullptr == p_rs485_handle)
+    {
+        usart_interrupt_handler<id_t>();
+    }
+    else
+    {
+        rs485_interrupt_handler(p_rs485_handle);
+    }
+}
+
+// dma_controller callbacks, the instance is the template argument
+template<USART::Id id_t>
+void dma_tx_interrupt_handler(uint32_t a_flags, void*)
 {
-    assert((nullptr != controllers[a_index].p_usart_handle && nullptr == controllers[a_index].p_rs485_handle) ||
-           (nullptr == controllers[a_index].p_usart_handle && nullptr != controllers[a_index].p_rs485_handle));
+    if (true == is_any_bit(a_flags, DMA_ISR_TCIF1 | DMA_ISR_TEIF1))
+    {
+        usart_dma_tx_interrupt_handler<id_t>(is_flag(a_flags, DMA_ISR_TEIF1));
+    }
+}
 
-    if (nullptr != controllers[a_index].p_usart_handle)
+template<USART::Id id_t>
+void dma_rx_interrupt_handler(uint32_t a_flags, void*)
+{
+    if (true == is_flag(a_flags, DMA_ISR_TEIF1))
     {
-        usart_interrupt_handler(controllers[a_index].p_usart_handle);
+        usart_dma_rx_error_handler<id_t>();
     }
-    else if (nullptr != controllers[a_index].p_rs485_handle)
+    else if (true == is_any_bit(a_flags, DMA_ISR_TCIF1 | DMA_ISR_HTIF1))
     {
-        rs485_interrupt_handler(controllers[a_index].p_rs485_handle);
+        usart_dma_rx_interrupt_handler<id_t>(false);
     }
 }
 
+constexpr dma_controller::Callback::Function dma_tx_interrupt_handlers[] =
+{
+    dma_tx_interrupt_handler<USART::Id::_1>,
+    dma_tx_interrupt_handler<USART::Id::_2>,
+    dma_tx_interrupt_handler<USART::Id::_3>
+};
+
+constexpr dma_controller::Callback::Function dma_rx_interrupt_handlers[] =
+{
+    dma_rx_interrupt_handler<USART::Id::_1>,
+    dma_rx_interrupt_handler<USART::Id::_2>,
+    dma_rx_interrupt_handler<USART::Id::_3>
+};
+
+} // namespace ::
+
+extern "C"
+{
+
 void USART1_IRQHandler()
 {
-    interrupt_handler(0);
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&usart1_irq_zone);
+#endif // CML_PROFILE_IRQ
+
+    interrupt_handler<USART::Id::_1>();
 }
 
 void USART2_IRQHandler()
 {
-    interrupt_handler(1);
+    interrupt_handler<USART::Id::_2>();
 }
 
 void USART3_IRQHandler()
 {
-    interrupt_handler(2);
+    interrupt_handler<USART::Id::_3>();
 }
 
 } // extern "C"
@@ -179,74 +384,175 @@ namespace peripherals {
 using namespace cml;
 using namespace cml::utils;
 
-void usart_interrupt_handler(USART* a_p_this)
+USART::Interrupt_context USART::interrupt_contexts[3];
+
+template<USART::Id id_t>
+void usart_interrupt_handler()
 {
-    assert(nullptr != a_p_this);
+    USART_TypeDef* const p_registers    = USART_t<id_t>::get_registers();
+    USART::Interrupt_context& context = USART_t<id_t>::get_interrupt_context();
 
-    const uint32_t isr = a_p_this->p_usart->ISR;
-    const uint32_t cr1 = a_p_this->p_usart->CR1;
-    const uint32_t cr3 = a_p_this->p_usart->CR3;
+    const uint32_t isr = p_registers->ISR;
+    const uint32_t cr1 = p_registers->CR1;
+    const uint32_t cr3 = p_registers->CR3;
 
-    if (nullptr != a_p_this->tx_callback.function)
+    if (nullptr != context.tx_callback.function)
     {
+        bool status = true;
+
         if (true == is_flag(isr, USART_ISR_TXE) &&
             true == is_flag(cr1, USART_CR1_TXEIE))
         {
-            if (false == a_p_this->tx_callback.function(&(a_p_this->p_usart->TDR),
-                                                        false,
-                                                        a_p_this->tx_callback.p_user_data))
-            {
-                a_p_this->unregister_transmit_callback();
-            }
+            status = context.tx_callback.function(&(p_registers->TDR), false, context.tx_callback.p_user_data);
         }
 
-        if (true == is_flag(isr, USART_ISR_TC) &&
+        if (true == status &&
+            true == is_flag(isr, USART_ISR_TC) &&
             true == is_flag(cr1, USART_CR1_TCIE))
         {
-            if (false == a_p_this->tx_callback.function(nullptr, true, a_p_this->tx_callback.p_user_data))
-            {
-                a_p_this->unregister_transmit_callback();
-            }
+            status = context.tx_callback.function(nullptr, true, context.tx_callback.p_user_data);
+        }
+
+        if (false == status)
+        {
+            clear_flag(&(p_registers->CR1), USART_CR1_TXEIE | USART_CR1_TCIE);
+            context.tx_callback = { nullptr, nullptr };
         }
     }
 
-    if (nullptr != a_p_this->rx_callback.function)
+    if (nullptr != context.rx_callback.function)
     {
         bool status = true;
 
         if (true == is_flag(isr, USART_ISR_RXNE) && true == is_flag(cr1, USART_CR1_RXNEIE))
         {
-            status = a_p_this->rx_callback.function(a_p_this->p_usart->RDR,
-                                                    false,
-                                                    a_p_this->rx_callback.p_user_data);
-        }
+#ifdef CML_TRACE_LATENCY
+            if constexpr (latency_traced_usart == id_t)
+            {
+                using debug::latency;
+
+                latency::mark(latency::Path::usart_rx, latency::Stage::vector, latency_vector_cycles);
+                latency::mark(latency::Path::usart_rx, latency::Stage::dispatch);
+            }
+#endif // CML_TRACE_LATENCY
 
+            status = context.rx_callback.function(p_registers->RDR, false, context.rx_callback.p_user_data);
+        }
         else if (true == is_flag(isr, USART_ISR_IDLE) && true == is_flag(cr1, USART_CR1_IDLEIE))
         {
-            set_flag(&(a_p_this->p_usart->ICR), USART_ICR_IDLECF);
-            status = a_p_this->rx_callback.function(0x0u, true, a_p_this->rx_callback.p_user_data);
+            set_flag(&(p_registers->ICR), USART_ICR_IDLECF);
+            status = context.rx_callback.function(0x0u, true, context.rx_callback.p_user_data);
         }
 
         if (false == status)
         {
-            a_p_this->unregister_receive_callback();
+            clear_flag(&(p_registers->CR1), USART_CR1_RXNEIE | USART_CR1_IDLEIE);
+            context.rx_callback = { nullptr, nullptr };
         }
     }
 
-    if (nullptr != a_p_this->bus_status_callback.function &&
+    if (nullptr != context.dma_rx_callback.function &&
+        true == is_flag(isr, USART_ISR_IDLE) &&
+        true == is_flag(cr1, USART_CR1_IDLEIE))
+    {
+        set_flag(&(p_registers->ICR), USART_ICR_IDLECF);
+        usart_dma_rx_interrupt_handler<id_t>(true);
+    }
+
+    if (nullptr != context.bus_status_callback.function &&
         true == is_flag(cr3, USART_CR3_EIE) &&
         true == is_flag(cr1, USART_CR1_PEIE))
     {
         USART::Bus_status_flag status = get_bus_status_flag_from_USART_ISR(isr);
 
         if (status != USART::Bus_status_flag::ok &&
-            true == a_p_this->bus_status_callback.function(status, a_p_this->bus_status_callback.p_user_data))
+            true == context.bus_status_callback.function(status, context.bus_status_callback.p_user_data))
         {
-            clear_USART_ISR_errors(&(a_p_this->p_usart->ICR));
+            clear_USART_ISR_errors(&(p_registers->ICR));
         }
     }
 }
 
+template<USART::Id id_t>
+void usart_dma_tx_interrupt_handler(bool a_transfer_error)
+{
+    USART::Interrupt_context& context = USART_t<id_t>::get_interrupt_context();
+
+    clear_flag(&(USART_t<id_t>::get_registers()->CR3), USART_CR3_DMAT);
+    system::dma_controller::disable_channel(system::dma_controller::Id::_1, dma_lines[static_cast<uint32_t>(id_t)].tx);
+
+    const USART::DMA_TX_callback callback = context.dma_tx_callback;
+
+    context.dma_tx_callback = { nullptr, nullptr };
+    context.dma_tx_busy     = false;
+
+    if (nullptr != callback.function)
+    {
+        callback.function(a_transfer_error, callback.p_user_data);
+    }
+}
+
+template<USART::Id id_t>
+void usart_dma_rx_interrupt_handler(bool a_idle)
+{
+    USART::Interrupt_context& context = USART_t<id_t>::get_interrupt_context();
+
+    DMA_Channel_TypeDef* p_channel        = get_DMA_channel_registers(dma_lines[static_cast<uint32_t>(id_t)].rx);
+    const USART::DMA_RX_callback callback = context.dma_rx_callback;
+
+    const uint32_t size      = context.dma_rx_buffer_size_in_words;
+    const uint32_t word_size = true == is_flag(p_channel->CCR, DMA_CCR_MSIZE_0) ? 2u : 1u;
+    const uint32_t position  = size - p_channel->CNDTR;
+
+    const uint8_t* p_buffer = static_cast<const uint8_t*>(context.p_dma_rx_buffer);
+
+    if (position < context.dma_rx_position)
+    {
+        callback.function(p_buffer + context.dma_rx_position * word_size,
+                          size - context.dma_rx_position,
+                          a_idle,
+                          callback.p_user_data);
+
+        context.dma_rx_position = 0;
+    }
+
+    if (position > context.dma_rx_position)
+    {
+        callback.function(p_buffer + context.dma_rx_position * word_size,
+                          position - context.dma_rx_position,
+                          a_idle,
+                          callback.p_user_data);
+    }
+
+    context.dma_rx_position = size == position ? 0 : position;
+}
+
+template<USART::Id id_t>
+void usart_dma_rx_error_handler()
+{
+    USART_TypeDef* const p_registers    = USART_t<id_t>::get_registers();
+    USART::Interrupt_context& context = USART_t<id_t>::get_interrupt_context();
+
+    const USART::DMA_RX_callback callback = context.dma_rx_callback;
+
+    // the channel is already off - reception stopped, told with no data before the callback goes
+    callback.function(nullptr, 0, false, callback.p_user_data);
+
+    // unless the callback did it itself
+    if (nullptr != context.dma_rx_callback.function)
+    {
+        clear_flag(&(p_registers->CR1), USART_CR1_IDLEIE);
+        clear_flag(&(p_registers->CR3), USART_CR3_DMAR);
+
+        system::dma_controller::disable_channel(system::dma_controller::Id::_1, dma_lines[static_cast<uint32_t>(id_t)].rx);
+
+        context.dma_rx_callback             = { nullptr, nullptr };
+        context.p_dma_rx_buffer             = nullptr;
+        context.dma_rx_buffer_size_in_words = 0;
+        context.dma_rx_position             = 0;
+    }
+}
+
 void rs485_interrupt_handler(RS485* a_p_this)
 {
     assert(nullptr != a_p_this);
@@ -268,7 +574,8 @@ void rs485_interrupt_handler(RS485* a_p_this)
             }
         }
 
-        if (true == is_flag(isr, USART_ISR_TC) &&
+        if (nullptr != a_p_this->tx_callback.function &&
+            true == is_flag(isr, USART_ISR_TC) &&
             true == is_flag(cr1, USART_CR1_TCIE))
         {
             if (false == a_p_this->tx_callback.function(nullptr, true, a_p_this->tx_callback.p_user_data))
@@ -384,12 +691,12 @@ bool USART::enable(const Config& a_config,
     this->clock        = a_clock;
     this->frame_format = a_frame_format;
 
-    uint32_t wait_flag = (true == is_flag(USART2->CR1, USART_CR1_RE) ? USART_ISR_REACK : 0) |
-                         (true == is_flag(USART2->CR1, USART_CR1_TE) ? USART_ISR_TEACK : 0);
+    uint32_t wait_flag = (true == is_flag(this->p_usart->CR1, USART_CR1_RE) ? USART_ISR_REACK : 0) |
+                         (true == is_flag(this->p_usart->CR1, USART_CR1_TE) ? USART_ISR_TEACK : 0);
 
 
 
-    return wait::until(&(USART2->ISR), wait_flag, false, start, a_timeout_ms);
+    return wait::until(&(this->p_usart->ISR), wait_flag, false, start, a_timeout_ms);
 }
 
 void USART::disable()
@@ -398,10 +705,30 @@ void USART::disable()
     assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
+    Interrupt_context& context = this->get_interrupt_context();
+
+    if (nullptr != context.dma_rx_callback.function)
+    {
+        this->unregister_receive_dma_callback();
+    }
+
+    if (true == context.dma_tx_busy)
+    {
+        system::dma_controller::disable_channel(system::dma_controller::Id::_1, dma_lines[static_cast<uint32_t>(this->id)].tx);
+
+        context.dma_tx_callback = { nullptr, nullptr };
+        context.dma_tx_busy     = false;
+    }
+
     this->p_usart->CR1 = 0;
     this->p_usart->CR2 = 0;
     this->p_usart->CR3 = 0;
 
+    // the context belongs to the instance, the next handle enabled on it starts with no callbacks
+    context.tx_callback         = { nullptr, nullptr };
+    context.rx_callback         = { nullptr, nullptr };
+    context.bus_status_callback = { nullptr, nullptr };
+
     controllers[static_cast<uint32_t>(this->id)].disable();
     controllers[static_cast<uint32_t>(this->id)].p_usart_handle = nullptr;
 
@@ -417,36 +744,7 @@ USART::Result USART::transmit_bytes_polling(const void* a_p_data, uint32_t a_dat
     assert(nullptr != a_p_data);
     assert(a_data_size_in_words > 0);
 
-    set_flag(&(this->p_usart->ICR), USART_ICR_TCCF);
-
-    uint32_t words = 0;
-    bool error = false;
-    Bus_status_flag bus_status = Bus_status_flag::ok;
-
-    while (false == is_flag(this->p_usart->ISR, USART_ISR_TC) && false == error)
-    {
-        if (true == is_flag(this->p_usart->ISR, USART_ISR_TXE) && words < a_data_size_in_words)
-        {
-            if (Parity::none == this->frame_format.parity && Word_length::_9_bit == this->frame_format.word_length)
-            {
-                this->p_usart->TDR = (static_cast<const uint16_t*>(a_p_data)[words++]) & 0x1FFu;
-            }
-            else
-            {
-                this->p_usart->TDR = (static_cast<const uint8_t*>(a_p_data)[words++]) & 0xFFu;
-            }
-        }
-
-        error = is_USART_ISR_error(this->p_usart->ISR);
-    }
-
-    if (true == error)
-    {
-        bus_status = get_bus_status_flag_from_USART_ISR(this->p_usart->ISR);
-        clear_USART_ISR_errors(&(this->p_usart->ICR));
-    }
-
-    return { bus_status, words };
+    return usart_transmit_polling(this->p_usart, is_9_bit_data(this->frame_format), a_p_data, a_data_size_in_words, 0);
 }
 
 USART::Result USART::transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_words, time::tick a_timeout_ms)
@@ -459,40 +757,11 @@ USART::Result USART::transmit_bytes_polling(const void* a_p_data, uint32_t a_dat
     assert(a_data_size_in_words > 0);
     assert(a_timeout_ms > 0);
 
-    time::tick start = counter::get();
-
-    set_flag(&(this->p_usart->ICR), USART_ICR_TCCF);
-
-    uint32_t words = 0;
-    bool error = false;
-    Bus_status_flag bus_status = Bus_status_flag::ok;
-
-    while (false == is_flag(this->p_usart->ISR, USART_ISR_TC) &&
-           false ==  error &&
-           a_timeout_ms < time::diff(counter::get(), start))
-    {
-        if (true == is_flag(this->p_usart->ISR, USART_ISR_TXE) && words < a_data_size_in_words)
-        {
-            if (Parity::none == this->frame_format.parity && Word_length::_9_bit == this->frame_format.word_length)
-            {
-                this->p_usart->TDR = (static_cast<const uint16_t*>(a_p_data)[words++]) & 0x1FFu;
-            }
-            else
-            {
-                this->p_usart->TDR = (static_cast<const uint8_t*>(a_p_data)[words++]) & 0xFFu;
-            }
-        }
-
-        error = is_USART_ISR_error(this->p_usart->ISR);
-    }
-
-    if (true == error)
-    {
-        bus_status = get_bus_status_flag_from_USART_ISR(this->p_usart->ISR);
-        clear_USART_ISR_errors(&(this->p_usart->ICR));
-    }
-
-    return { bus_status, words };
+    return usart_transmit_polling(this->p_usart,
+                                  is_9_bit_data(this->frame_format),
+                                  a_p_data,
+                                  a_data_size_in_words,
+                                  a_timeout_ms);
 }
 
 USART::Result USART::receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words)
@@ -504,44 +773,7 @@ USART::Result USART::receive_bytes_polling(void* a_p_data, uint32_t a_data_size_
     assert(nullptr != a_p_data);
     assert(a_data_size_in_words > 0);
 
-    set_flag(&(this->p_usart->ICR), USART_ICR_IDLECF);
-
-    uint32_t words = 0;
-    bool error = false;
-    Bus_status_flag bus_status = Bus_status_flag::ok;
-
-    while (false == is_flag(this->p_usart->ISR, USART_ISR_IDLE) && false == error)
-    {
-        if (true == is_flag(this->p_usart->ISR, USART_ISR_RXNE))
-        {
-            if (words < a_data_size_in_words)
-            {
-                if (Parity::none == this->frame_format.parity && Word_length::_9_bit == this->frame_format.word_length)
-                {
-                    static_cast<uint16_t*>(a_p_data)[words++] = (this->p_usart->RDR & 0x1FFu);
-                }
-                else
-                {
-                    static_cast<uint8_t*>(a_p_data)[words++] = (this->p_usart->RDR & 0xFFu);
-                }
-            }
-            else
-            {
-                set_flag(&(this->p_usart->RQR), USART_RQR_RXFRQ);
-                words++;
-            }
-        }
-
-        error = is_USART_ISR_error(this->p_usart->ISR);
-    }
-
-    if (true == error)
-    {
-        bus_status = get_bus_status_flag_from_USART_ISR(this->p_usart->ISR);
-        clear_USART_ISR_errors(&(this->p_usart->ICR));
-    }
-
-    return { bus_status, words };
+    return usart_receive_polling(this->p_usart, is_9_bit_data(this->frame_format), a_p_data, a_data_size_in_words, 0);
 }
 
 USART::Result USART::receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words, time::tick a_timeout_ms)
@@ -554,50 +786,79 @@ USART::Result USART::receive_bytes_polling(void* a_p_data, uint32_t a_data_size_
     assert(a_data_size_in_words > 0);
     assert(a_timeout_ms > 0);
 
-    time::tick start = counter::get();
+    return usart_receive_polling(this->p_usart,
+                                 is_9_bit_data(this->frame_format),
+                                 a_p_data,
+                                 a_data_size_in_words,
+                                 a_timeout_ms);
+}
 
-    set_flag(&(this->p_usart->ICR), USART_ICR_IDLECF);
+template<USART::Id id_t>
+USART::Result USART_t<id_t>::transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_words)
+{
+    assert(nullptr != this->p_usart);
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_words > 0);
 
-    uint32_t ret = 0;
-    bool error = false;
-    Bus_status_flag bus_status = Bus_status_flag::ok;
+    return usart_transmit_polling(Fixed_registers<id_t>(),
+                                  is_9_bit_data(this->frame_format),
+                                  a_p_data,
+                                  a_data_size_in_words,
+                                  0);
+}
 
-    while (false == is_flag(this->p_usart->ISR, USART_ISR_IDLE) &&
-           false == error &&
-           a_timeout_ms >= time::diff(counter::get(), start))
-    {
-        if (true == is_flag(this->p_usart->ISR, USART_ISR_RXNE))
-        {
-            if (ret < a_data_size_in_words)
-            {
-                if (Parity::none == this->frame_format.parity && Word_length::_9_bit == this->frame_format.word_length)
-                {
-                    static_cast<uint16_t*>(a_p_data)[ret++] = (this->p_usart->RDR & 0x1FFu);
-                }
-                else
-                {
-                    static_cast<uint8_t*>(a_p_data)[ret++] = (this->p_usart->RDR & 0xFFu);
-                }
-            }
-            else
-            {
-                set_flag(&(this->p_usart->RQR), USART_RQR_RXFRQ);
-                ret++;
-            }
-        }
+template<USART::Id id_t>
+USART::Result USART_t<id_t>::transmit_bytes_polling(const void* a_p_data,
+                                                    uint32_t a_data_size_in_words,
+                                                    time::tick a_timeout_ms)
+{
+    assert(nullptr != this->p_usart);
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_words > 0);
+    assert(a_timeout_ms > 0);
 
-        error = is_USART_ISR_error(this->p_usart->ISR);
-    }
+    return usart_transmit_polling(Fixed_registers<id_t>(),
+                                  is_9_bit_data(this->frame_format),
+                                  a_p_data,
+                                  a_data_size_in_words,
+                                  a_timeout_ms);
+}
 
-    if (true == error)
-    {
-        bus_status = get_bus_status_flag_from_USART_ISR(this->p_usart->ISR);
-        clear_USART_ISR_errors(&(this->p_usart->ICR));
-    }
+template<USART::Id id_t>
+USART::Result USART_t<id_t>::receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words)
+{
+    assert(nullptr != this->p_usart);
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_words > 0);
+
+    return usart_receive_polling(Fixed_registers<id_t>(),
+                                 is_9_bit_data(this->frame_format),
+                                 a_p_data,
+                                 a_data_size_in_words,
+                                 0);
+}
+
+template<USART::Id id_t>
+USART::Result USART_t<id_t>::receive_bytes_polling(void* a_p_data,
+                                                   uint32_t a_data_size_in_words,
+                                                   time::tick a_timeout_ms)
+{
+    assert(nullptr != this->p_usart);
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_words > 0);
+    assert(a_timeout_ms > 0);
 
-    return { bus_status, ret };
+    return usart_receive_polling(Fixed_registers<id_t>(),
+                                 is_9_bit_data(this->frame_format),
+                                 a_p_data,
+                                 a_data_size_in_words,
+                                 a_timeout_ms);
 }
 
+template class USART_t<USART::Id::_1>;
+template class USART_t<USART::Id::_2>;
+template class USART_t<USART::Id::_3>;
+
 void USART::register_transmit_callback(const TX_callback& a_callback)
 {
     assert(nullptr != this->p_usart);
@@ -605,10 +866,11 @@ void USART::register_transmit_callback(const TX_callback& a_callback)
            nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
     assert(nullptr != a_callback.function);
+    assert(false == this->get_interrupt_context().dma_tx_busy);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->tx_callback = a_callback;
+    this->get_interrupt_context().tx_callback = a_callback;
 
     set_flag(&(this->p_usart->ICR), USART_ICR_TCCF);
     set_flag(&(this->p_usart->CR1), USART_CR1_TXEIE | USART_CR1_TCIE);
@@ -621,10 +883,11 @@ void USART::register_receive_callback(const RX_callback& a_callback)
            nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
     assert(nullptr != a_callback.function);
+    assert(nullptr == this->get_interrupt_context().dma_rx_callback.function);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->rx_callback = a_callback;
+    this->get_interrupt_context().rx_callback = a_callback;
 
     set_flag(&(this->p_usart->ICR), USART_ICR_IDLECF);
     set_flag(&(this->p_usart->CR1), USART_CR1_RXNEIE | USART_CR1_IDLEIE);
@@ -638,12 +901,12 @@ void USART::register_bus_status_callback(const Bus_status_callback& a_callback)
 
     assert(nullptr != a_callback.function);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    this->bus_status_callback = a_callback;
+    this->get_interrupt_context().bus_status_callback = a_callback;
 
-    set_flag(&(USART2->CR1), USART_CR1_PEIE);
-    set_flag(&(USART2->CR3), USART_CR3_EIE);
+    set_flag(&(this->p_usart->CR1), USART_CR1_PEIE);
+    set_flag(&(this->p_usart->CR3), USART_CR3_EIE);
 }
 
 void USART::unregister_transmit_callback()
@@ -652,11 +915,11 @@ void USART::unregister_transmit_callback()
     assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     clear_flag(&(this->p_usart->CR1), USART_CR1_TXEIE | USART_CR1_TCIE);
 
-    this->tx_callback = { nullptr, nullptr };
+    this->get_interrupt_context().tx_callback = { nullptr, nullptr };
 }
 
 void USART::unregister_receive_callback()
@@ -665,11 +928,11 @@ void USART::unregister_receive_callback()
     assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     clear_flag(&(this->p_usart->CR1), USART_CR1_RXNEIE | USART_CR1_IDLEIE);
 
-    this->rx_callback = { nullptr, nullptr };
+    this->get_interrupt_context().rx_callback = { nullptr, nullptr };
 }
 
 void USART::unregister_bus_status_callback()
@@ -678,12 +941,119 @@ void USART::unregister_bus_status_callback()
     assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     clear_flag(&(this->p_usart->CR1), USART_CR1_PEIE);
     clear_flag(&(this->p_usart->CR3), USART_CR3_EIE);
 
-    this->bus_status_callback = { nullptr, nullptr };
+    this->get_interrupt_context().bus_status_callback = { nullptr, nullptr };
+}
+
+bool USART::transmit_bytes_dma(const void* a_p_data, uint32_t a_data_size_in_words, const DMA_TX_callback& a_callback)
+{
+    assert(nullptr != this->p_usart);
+    assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
+           nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
+
+    assert(nullptr != a_p_data);
+    assert(a_data_size_in_words > 0 && a_data_size_in_words <= 0xFFFFu);
+    Interrupt_context& context = this->get_interrupt_context();
+
+    assert(nullptr == context.tx_callback.function);
+
+    if (true == context.dma_tx_busy)
+    {
+        return false;
+    }
+
+    const system::dma_controller::Channel channel = dma_lines[static_cast<uint32_t>(this->id)].tx;
+    DMA_Channel_TypeDef* p_channel                = get_DMA_channel_registers(channel);
+
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
+
+    context.dma_tx_callback = a_callback;
+    context.dma_tx_busy     = true;
+
+    system::dma_controller::enable_channel(system::dma_controller::Id::_1,
+                                           channel,
+                                           dma_usart_request,
+                                           NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]),
+                                           { dma_tx_interrupt_handlers[static_cast<uint32_t>(this->id)], nullptr });
+
+    p_channel->CPAR  = reinterpret_cast<uint32_t>(&(this->p_usart->TDR));
+    p_channel->CMAR  = reinterpret_cast<uint32_t>(a_p_data);
+    p_channel->CNDTR = a_data_size_in_words;
+
+    set_flag(&(this->p_usart->ICR), USART_ICR_TCCF);
+    set_flag(&(this->p_usart->CR3), USART_CR3_DMAT);
+
+    p_channel->CCR = get_DMA_CCR_size_flags(this->frame_format) |
+                     DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_TEIE | DMA_CCR_EN;
+
+    return true;
+}
+
+void USART::register_receive_dma_callback(void* a_p_buffer, uint32_t a_buffer_size_in_words, const DMA_RX_callback& a_callback)
+{
+    assert(nullptr != this->p_usart);
+    assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
+           nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
+
+    assert(nullptr != a_p_buffer);
+    assert(a_buffer_size_in_words > 1 && a_buffer_size_in_words <= 0xFFFFu);
+    assert(nullptr != a_callback.function);
+
+    Interrupt_context& context = this->get_interrupt_context();
+
+    assert(nullptr == context.rx_callback.function);
+
+    const system::dma_controller::Channel channel = dma_lines[static_cast<uint32_t>(this->id)].rx;
+    DMA_Channel_TypeDef* p_channel                = get_DMA_channel_registers(channel);
+
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
+
+    context.dma_rx_callback             = a_callback;
+    context.p_dma_rx_buffer             = a_p_buffer;
+    context.dma_rx_buffer_size_in_words = a_buffer_size_in_words;
+    context.dma_rx_position             = 0;
+
+    system::dma_controller::enable_channel(system::dma_controller::Id::_1,
+                                           channel,
+                                           dma_usart_request,
+                                           NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]),
+                                           { dma_rx_interrupt_handlers[static_cast<uint32_t>(this->id)], nullptr });
+
+    p_channel->CPAR  = reinterpret_cast<uint32_t>(&(this->p_usart->RDR));
+    p_channel->CMAR  = reinterpret_cast<uint32_t>(a_p_buffer);
+    p_channel->CNDTR = a_buffer_size_in_words;
+
+    p_channel->CCR = get_DMA_CCR_size_flags(this->frame_format) |
+                     DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_TEIE | DMA_CCR_EN;
+
+    set_flag(&(this->p_usart->ICR), USART_ICR_IDLECF);
+    set_flag(&(this->p_usart->CR3), USART_CR3_DMAR);
+    set_flag(&(this->p_usart->CR1), USART_CR1_IDLEIE);
+}
+
+void USART::unregister_receive_dma_callback()
+{
+    assert(nullptr != this->p_usart);
+    assert(nullptr == controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
+           nullptr != controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
+
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
+
+    clear_flag(&(this->p_usart->CR1), USART_CR1_IDLEIE);
+    clear_flag(&(this->p_usart->CR3), USART_CR3_DMAR);
+
+    system::dma_controller::disable_channel(system::dma_controller::Id::_1, dma_lines[static_cast<uint32_t>(this->id)].rx);
+
+    Interrupt_context& context = this->get_interrupt_context();
+
+    context.dma_rx_callback             = { nullptr, nullptr };
+    context.p_dma_rx_buffer             = nullptr;
+    context.dma_rx_buffer_size_in_words = 0;
+    context.dma_rx_position             = 0;
 }
 
 void USART::set_baud_rate(uint32_t a_baud_rate)
@@ -801,12 +1171,12 @@ bool USART::set_mode(Mode_flag a_mode, time::tick a_timeout_ms)
 
     time::tick start = counter::get();
 
-    set_flag(&(USART2->CR1), USART_CR1_TE | USART_CR1_RE, static_cast<uint32_t>(a_mode));
+    set_flag(&(this->p_usart->CR1), USART_CR1_TE | USART_CR1_RE, static_cast<uint32_t>(a_mode));
 
-    uint32_t wait_flag = (true == is_flag(USART2->CR1, USART_CR1_RE) ? USART_ISR_REACK : 0) |
-                         (true == is_flag(USART2->CR1, USART_CR1_TE) ? USART_ISR_TEACK : 0);
+    uint32_t wait_flag = (true == is_flag(this->p_usart->CR1, USART_CR1_RE) ? USART_ISR_REACK : 0) |
+                         (true == is_flag(this->p_usart->CR1, USART_CR1_TE) ? USART_ISR_TEACK : 0);
 
-    return wait::until(&(USART2->ISR), wait_flag, false, start, a_timeout_ms);
+    return wait::until(&(this->p_usart->ISR), wait_flag, false, start, a_timeout_ms);
 }
 
 
@@ -848,7 +1218,7 @@ USART::Sampling_method USART::get_sampling_method() const
 
 USART::Mode_flag USART::get_mode() const
 {
-    return static_cast<Mode_flag>(get_flag(USART2->CR1, USART_CR1_TE | USART_CR1_RE));
+    return static_cast<Mode_flag>(get_flag(this->p_usart->CR1, USART_CR1_TE | USART_CR1_RE));
 }
 
 bool USART::is_enabled() const
@@ -1172,7 +1542,7 @@ void RS485::register_transmit_callback(const TX_callback& a_callback)
 
     assert(nullptr != a_callback.function);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     this->tx_callback = a_callback;
 
@@ -1188,7 +1558,7 @@ void RS485::register_receive_callback(const RX_callback& a_callback)
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr == controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     this->rx_callback = a_callback;
 
@@ -1202,7 +1572,7 @@ void RS485::register_bus_status_callback(const Bus_status_callback& a_callback)
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr == controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     this->bus_status_callback = a_callback;
 
@@ -1218,7 +1588,7 @@ void RS485::unregister_transmit_callback()
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr == controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     this->p_flow_control_pin->set_level(pin::Level::low);
 
@@ -1233,7 +1603,7 @@ void RS485::unregister_receive_callback()
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr == controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
     set_flag(&(this->p_usart->ICR), USART_ICR_CMCF);
     clear_flag(&(this->p_usart->CR1), USART_CR1_RXNEIE);
@@ -1247,10 +1617,10 @@ void RS485::unregister_bus_status_callback()
     assert(nullptr != controllers[static_cast<uint32_t>(this->id)].p_rs485_handle &&
            nullptr == controllers[static_cast<uint32_t>(this->id)].p_usart_handle);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(usart_irqn_lut[static_cast<uint32_t>(this->id)]));
 
-    clear_flag(&(USART2->CR1), USART_CR1_PEIE);
-    clear_flag(&(USART2->CR3), USART_CR3_EIE);
+    clear_flag(&(this->p_usart->CR1), USART_CR1_PEIE);
+    clear_flag(&(this->p_usart->CR3), USART_CR3_EIE);
 
     this->bus_status_callback = { nullptr, nullptr };
 }
@@ -8,6 +8,7 @@
 */
 
 //std
+#include <cstddef>
 #include <cstdint>
 
 //externals
@@ -166,6 +167,22 @@ public:
         void* p_user_data = nullptr;
     };
 
+    struct DMA_TX_callback
+    {
+        using Function = void(*)(bool a_transfer_error, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+    struct DMA_RX_callback
+    {
+        using Function = void(*)(const void* a_p_data, uint32_t a_data_length_in_words, bool a_idle, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
 public:
 
     USART(Id a_id)
@@ -228,6 +245,32 @@ public:
     void unregister_receive_callback();
     void unregister_bus_status_callback();
 
+    //
+    // One-shot DMA transmission of a caller owned buffer, the buffer has to stay valid until the callback is
+    // called from the DMA channel interrupt (the callback is optional).
+    //
+    bool transmit_bytes_dma(const void* a_p_data, uint32_t a_data_size_in_words, const DMA_TX_callback& a_callback);
+
+    //
+    // Continuous reception into a caller owned circular buffer. The callback gets every newly arrived,
+    // not yet reported, range of the buffer on the half-transfer, transfer-complete and IDLE line events.
+    // Ranges never wrap, nothing is copied - data has to be consumed before the DMA comes back to it.
+    // A DMA transfer error stops the reception: the callback is called once more with no data ('a_p_data'
+    // nullptr, length 0), then it is unregistered.
+    //
+    void register_receive_dma_callback(void* a_p_buffer, uint32_t a_buffer_size_in_words, const DMA_RX_callback& a_callback);
+    void unregister_receive_dma_callback();
+
+    bool is_transmit_dma_busy() const
+    {
+        return true == this->get_interrupt_context().dma_tx_busy;
+    }
+
+    bool is_receive_dma_callback_registered() const
+    {
+        return nullptr != this->get_interrupt_context().dma_rx_callback.function;
+    }
+
     void set_baud_rate(uint32_t a_baud_rate);
     void set_oversampling(Oversampling a_oversampling);
     void set_stop_bits(Stop_bits a_stop_bits);
@@ -238,17 +281,17 @@ public:
 
     bool is_transmit_callback_registered() const
     {
-        return nullptr != this->tx_callback.function;
+        return nullptr != this->get_interrupt_context().tx_callback.function;
     }
 
     bool is_receive_callback_registered() const
     {
-        return nullptr != this->rx_callback.function;
+        return nullptr != this->get_interrupt_context().rx_callback.function;
     }
 
     bool is_bus_status_callback_registered() const
     {
-        return nullptr != this->tx_callback.function;
+        return nullptr != this->get_interrupt_context().bus_status_callback.function;
     }
 
     Oversampling      get_oversampling()    const;
@@ -279,23 +322,52 @@ public:
         return this->id;
     }
 
+private:
+
+    //
+    // Everything the interrupts of an instance touch. There is one per instance, not per handle, so the
+    // handlers of a vector find it at a constant address instead of through the handle.
+    //
+    struct Interrupt_context
+    {
+        TX_callback tx_callback;
+        RX_callback rx_callback;
+        Bus_status_callback bus_status_callback;
+
+        DMA_TX_callback dma_tx_callback;
+        DMA_RX_callback dma_rx_callback;
+
+        volatile bool dma_tx_busy = false;
+
+        void* p_dma_rx_buffer                = nullptr;
+        uint32_t dma_rx_buffer_size_in_words = 0;
+        uint32_t dma_rx_position             = 0;
+    };
+
+    Interrupt_context& get_interrupt_context() const
+    {
+        return interrupt_contexts[static_cast<uint32_t>(this->id)];
+    }
+
 private:
 
     Id id;
     USART_TypeDef* p_usart;
 
-    TX_callback tx_callback;
-    RX_callback rx_callback;
-    Bus_status_callback bus_status_callback;
-
     uint32_t baud_rate;
 
     Clock clock;
     Frame_format frame_format;
 
+    static Interrupt_context interrupt_contexts[3];
+
 private:
 
-    friend void usart_interrupt_handler(USART* a_p_this);
+    template<Id id_t> friend class USART_t;
+    template<Id id_t> friend void usart_interrupt_handler();
+    template<Id id_t> friend void usart_dma_tx_interrupt_handler(bool a_transfer_error);
+    template<Id id_t> friend void usart_dma_rx_interrupt_handler(bool a_idle);
+    template<Id id_t> friend void usart_dma_rx_error_handler();
 };
 
 constexpr USART::Bus_status_flag operator | (USART::Bus_status_flag a_f1, USART::Bus_status_flag a_f2)
@@ -346,6 +418,94 @@ constexpr USART::Mode_flag operator |= (USART::Mode_flag& a_f1, USART::Mode_flag
     return a_f1;
 }
 
+//
+// USART with the instance fixed at compile time: registers, IRQ number and clock enable bits are constants.
+// Interrupts of the instance and the polling transfers below address the registers and the interrupt context
+// directly, not through the handle. The run-time-Id USART stays for code that picks the instance at run time.
+//
+template<USART::Id id_t>
+class USART_t : public USART
+{
+public:
+
+    static constexpr uintptr_t registers_address = USART::Id::_1 == id_t ? USART1_BASE :
+                                                   USART::Id::_2 == id_t ? USART2_BASE :
+                                                                           USART3_BASE;
+
+    static constexpr IRQn_Type irqn = USART::Id::_1 == id_t ? USART1_IRQn :
+                                      USART::Id::_2 == id_t ? USART2_IRQn :
+                                                              USART3_IRQn;
+
+    static constexpr uintptr_t rcc_enable_register_address =
+        USART::Id::_1 == id_t ? RCC_BASE + offsetof(RCC_TypeDef, APB2ENR) :
+                                RCC_BASE + offsetof(RCC_TypeDef, APB1ENR1);
+
+    static constexpr uint32_t rcc_enable_flag = USART::Id::_1 == id_t ? RCC_APB2ENR_USART1EN   :
+                                                USART::Id::_2 == id_t ? RCC_APB1ENR1_USART2EN :
+                                                                        RCC_APB1ENR1_USART3EN;
+
+    static constexpr uint32_t rcc_clock_select_position = USART::Id::_1 == id_t ? RCC_CCIPR_USART1SEL_Pos :
+                                                          USART::Id::_2 == id_t ? RCC_CCIPR_USART2SEL_Pos :
+                                                                                  RCC_CCIPR_USART3SEL_Pos;
+
+public:
+
+    USART_t()
+        : USART(id_t)
+    {}
+
+    template<typename Data_t>
+    Result transmit_polling(const Data_t& a_data)
+    {
+        static_assert(true == cml::is_pod<Data_t>());
+        return this->transmit_bytes_polling(&a_data, sizeof(a_data));
+    }
+
+    template<typename Data_t>
+    Result transmit_polling(const Data_t& a_data, cml::time::tick a_timeout)
+    {
+        static_assert(true == cml::is_pod<Data_t>());
+        return this->transmit_bytes_polling(&a_data, sizeof(a_data), a_timeout);
+    }
+
+    template<typename Data_t>
+    Result receive_polling(Data_t* a_p_data)
+    {
+        static_assert(true == cml::is_pod<Data_t>());
+        return this->receive_bytes_polling(a_p_data, sizeof(Data_t));
+    }
+
+    template<typename Data_t>
+    Result receive_polling(Data_t* a_p_data, cml::time::tick a_timeout)
+    {
+        static_assert(true == cml::is_pod<Data_t>());
+        return this->receive_bytes_polling(a_p_data, sizeof(Data_t), a_timeout);
+    }
+
+    Result transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_words);
+    Result transmit_bytes_polling(const void* a_p_data, uint32_t a_data_size_in_words, cml::time::tick a_timeout_ms);
+    Result receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words);
+    Result receive_bytes_polling(void* a_p_data, uint32_t a_data_size_in_words, cml::time::tick a_timeout_ms);
+
+    static USART_TypeDef* get_registers()
+    {
+        return reinterpret_cast<USART_TypeDef*>(registers_address);
+    }
+
+private:
+
+    static Interrupt_context& get_interrupt_context()
+    {
+        return interrupt_contexts[static_cast<uint32_t>(id_t)];
+    }
+
+private:
+
+    template<Id id> friend void usart_interrupt_handler();
+    template<Id id> friend void usart_dma_tx_interrupt_handler(bool a_transfer_error);
+    template<Id id> friend void usart_dma_rx_interrupt_handler(bool a_idle);
+    template<Id id> friend void usart_dma_rx_error_handler();
+};
 
 } // namespace peripherals
 } // namespace stm32l452xx
@@ -0,0 +1,207 @@
+/*
+    Name: dma_controller.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+#ifdef STM32L452xx
+
+//this
+#include <soc/stm32l452xx/system/dma_controller.hpp>
+
+//cml
+#include <cml/bit.hpp>
+#include <cml/debug/assert.hpp>
+
+namespace {
+
+using namespace cml;
+using namespace soc::stm32l452xx::system;
+
+struct Controller
+{
+    DMA_TypeDef* p_registers                 = nullptr;
+    DMA_Request_TypeDef* p_request_registers = nullptr;
+    DMA_Channel_TypeDef* p_channels[7]       = { nullptr };
+    IRQn_Type irqns[7]                       = { };
+};
+
+const Controller controllers[] =
+{
+    { DMA1,
+      DMA1_CSELR,
+      { DMA1_Channel1, DMA1_Channel2, DMA1_Channel3, DMA1_Channel4, DMA1_Channel5, DMA1_Channel6, DMA1_Channel7 },
+      { DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+        DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn } },
+
+    { DMA2,
+      DMA2_CSELR,
+      { DMA2_Channel1, DMA2_Channel2, DMA2_Channel3, DMA2_Channel4, DMA2_Channel5, DMA2_Channel6, DMA2_Channel7 },
+      { DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_IRQn,
+        DMA2_Channel5_IRQn, DMA2_Channel6_IRQn, DMA2_Channel7_IRQn } }
+};
+
+dma_controller::Callback callbacks[2][7];
+
+constexpr uint32_t rcc_enable_flags[] = { RCC_AHB1ENR_DMA1EN, RCC_AHB1ENR_DMA2EN };
+
+} // namespace ::
+
+extern "C"
+{
+
+using namespace cml;
+
+static void interrupt_handler(uint32_t a_id, uint32_t a_channel)
+{
+    const Controller& controller = controllers[a_id];
+
+    const uint32_t flags = (controller.p_registers->ISR >> (a_channel * 4u)) &
+                           (DMA_ISR_TCIF1 | DMA_ISR_HTIF1 | DMA_ISR_TEIF1);
+
+    controller.p_registers->IFCR = DMA_IFCR_CGIF1 << (a_channel * 4u);
+
+    assert(nullptr != callbacks[a_id][a_channel].function);
+
+    if (0 != flags)
+    {
+        callbacks[a_id][a_channel].function(flags, callbacks[a_id][a_channel].p_user_data);
+    }
+}
+
+void DMA1_Channel1_IRQHandler()
+{
+    interrupt_handler(0, 0);
+}
+
+void DMA1_Channel2_IRQHandler()
+{
+    interrupt_handler(0, 1);
+}
+
+void DMA1_Channel3_IRQHandler()
+{
+    interrupt_handler(0, 2);
+}
+
+void DMA1_Channel4_IRQHandler()
+{
+    interrupt_handler(0, 3);
+}
+
+void DMA1_Channel5_IRQHandler()
+{
+    interrupt_handler(0, 4);
+}
+
+void DMA1_Channel6_IRQHandler()
+{
+    interrupt_handler(0, 5);
+}
+
+void DMA1_Channel7_IRQHandler()
+{
+    interrupt_handler(0, 6);
+}
+
+void DMA2_Channel1_IRQHandler()
+{
+    interrupt_handler(1, 0);
+}
+
+void DMA2_Channel2_IRQHandler()
+{
+    interrupt_handler(1, 1);
+}
+
+void DMA2_Channel3_IRQHandler()
+{
+    interrupt_handler(1, 2);
+}
+
+void DMA2_Channel4_IRQHandler()
+{
+    interrupt_handler(1, 3);
+}
+
+void DMA2_Channel5_IRQHandler()
+{
+    interrupt_handler(1, 4);
+}
+
+void DMA2_Channel6_IRQHandler()
+{
+    interrupt_handler(1, 5);
+}
+
+void DMA2_Channel7_IRQHandler()
+{
+    interrupt_handler(1, 6);
+}
+
+} // extern "C"
+
+namespace soc {
+namespace stm32l452xx {
+namespace system {
+
+using namespace cml;
+
+void dma_controller::enable_channel(Id a_id,
+                                    Channel a_channel,
+                                    uint32_t a_request,
+                                    uint32_t a_irq_priority,
+                                    const Callback& a_callback)
+{
+    assert(a_request <= 0xFu);
+    assert(nullptr != a_callback.function);
+    assert(false == is_channel_enabled(a_id, a_channel));
+
+    const uint32_t id            = static_cast<uint32_t>(a_id);
+    const uint32_t channel       = static_cast<uint32_t>(a_channel);
+    const Controller& controller = controllers[id];
+
+    // the clock is shared by all the channels - never switched off here
+    set_flag(&(RCC->AHB1ENR), rcc_enable_flags[id]);
+
+    set_flag(&(controller.p_request_registers->CSELR), DMA_CSELR_C1S << (channel * 4u), a_request << (channel * 4u));
+
+    controller.p_channels[channel]->CCR = 0;
+    controller.p_registers->IFCR        = DMA_IFCR_CGIF1 << (channel * 4u);
+
+    callbacks[id][channel] = a_callback;
+
+    NVIC_SetPriority(controller.irqns[channel], a_irq_priority);
+    NVIC_EnableIRQ(controller.irqns[channel]);
+}
+
+void dma_controller::disable_channel(Id a_id, Channel a_channel)
+{
+    const uint32_t id            = static_cast<uint32_t>(a_id);
+    const uint32_t channel       = static_cast<uint32_t>(a_channel);
+    const Controller& controller = controllers[id];
+
+    NVIC_DisableIRQ(controller.irqns[channel]);
+
+    controller.p_channels[channel]->CCR = 0;
+    controller.p_registers->IFCR        = DMA_IFCR_CGIF1 << (channel * 4u);
+
+    callbacks[id][channel] = { nullptr, nullptr };
+}
+
+bool dma_controller::is_channel_enabled(Id a_id, Channel a_channel)
+{
+    return nullptr != callbacks[static_cast<uint32_t>(a_id)][static_cast<uint32_t>(a_channel)].function;
+}
+
+DMA_Channel_TypeDef* dma_controller::get_channel_registers(Id a_id, Channel a_channel)
+{
+    return controllers[static_cast<uint32_t>(a_id)].p_channels[static_cast<uint32_t>(a_channel)];
+}
+
+} // namespace system
+} // namespace stm32l452xx
+} // namespace soc
+
+#endif // STM32L452xx
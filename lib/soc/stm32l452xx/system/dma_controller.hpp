@@ -0,0 +1,83 @@
+#pragma once
+
+/*
+    Name: dma_controller.hpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstdint>
+
+//externals
+#include <stm32l4xx.h>
+
+namespace soc {
+namespace stm32l452xx {
+namespace system {
+
+//
+// Owner of the DMA1 / DMA2 channel interrupt vectors. Peripheral drivers take a channel with its request
+// ('CxS' value, see RM0394 "DMA1 / DMA2 requests for each channel") and get its interrupts in the callback.
+// A channel has one user at a time - two drivers configured on the same channel assert.
+//
+class dma_controller
+{
+public:
+
+    enum class Id : uint32_t
+    {
+        _1,
+        _2
+    };
+
+    enum class Channel : uint32_t
+    {
+        _1,
+        _2,
+        _3,
+        _4,
+        _5,
+        _6,
+        _7
+    };
+
+    struct Callback
+    {
+        // 'a_flags' - DMA_ISR_TCIF1, DMA_ISR_HTIF1 and DMA_ISR_TEIF1 of the channel, already cleared
+        using Function = void(*)(uint32_t a_flags, void* a_p_user_data);
+
+        Function function = nullptr;
+        void* p_user_data = nullptr;
+    };
+
+public:
+
+    dma_controller()                      = delete;
+    dma_controller(dma_controller&&)      = delete;
+    dma_controller(const dma_controller&) = delete;
+
+    dma_controller& operator = (dma_controller&&)      = delete;
+    dma_controller& operator = (const dma_controller&) = delete;
+
+    //
+    // Selects the request, resets the channel (CCR = 0, flags cleared) and enables its interrupt. The transfer
+    // itself is set up by the caller in the channel registers.
+    //
+    static void enable_channel(Id a_id,
+                               Channel a_channel,
+                               uint32_t a_request,
+                               uint32_t a_irq_priority,
+                               const Callback& a_callback);
+
+    static void disable_channel(Id a_id, Channel a_channel);
+
+    static bool is_channel_enabled(Id a_id, Channel a_channel);
+
+    static DMA_Channel_TypeDef* get_channel_registers(Id a_id, Channel a_channel);
+};
+
+} // namespace system
+} // namespace stm32l452xx
+} // namespace soc
@@ -16,6 +16,12 @@
 
 //cml
 #include <cml/debug/assert.hpp>
+#ifdef CML_PROFILE_IRQ
+#include <cml/debug/profiler.hpp>
+#endif // CML_PROFILE_IRQ
+#ifdef CML_TRACE_LATENCY
+#include <cml/debug/latency.hpp>
+#endif // CML_TRACE_LATENCY
 
 namespace {
 
@@ -30,6 +36,45 @@ struct Handler
 
 Handler handlers[16];
 
+#ifdef CML_PROFILE_IRQ
+cml::debug::profiler::Zone exti0_irq_zone("EXTI0_IRQHandler");
+cml::debug::profiler::Zone exti1_irq_zone("EXTI1_IRQHandler");
+cml::debug::profiler::Zone exti2_irq_zone("EXTI2_IRQHandler");
+cml::debug::profiler::Zone exti3_irq_zone("EXTI3_IRQHandler");
+cml::debug::profiler::Zone exti4_irq_zone("EXTI4_IRQHandler");
+cml::debug::profiler::Zone exti9_5_irq_zone("EXTI9_5_IRQHandler");
+cml::debug::profiler::Zone exti15_10_irq_zone("EXTI15_10_IRQHandler");
+#endif // CML_PROFILE_IRQ
+
+#ifdef CML_TRACE_LATENCY
+#ifndef CML_TRACE_LATENCY_EXTI
+#define CML_TRACE_LATENCY_EXTI 1
+#endif // CML_TRACE_LATENCY_EXTI
+
+static_assert(CML_TRACE_LATENCY_EXTI >= 0 && CML_TRACE_LATENCY_EXTI <= 15);
+
+// the only line stamping latency::Path::exti - other lines, sharing a vector or not, would overwrite the stamps of
+// the edge measured
+constexpr uint32_t latency_traced_line = CML_TRACE_LATENCY_EXTI;
+
+// 'a_cycles' taken at the handler entry, stored as the 'vector' stage when the traced line is pending
+template<uint32_t first_line_t, uint32_t last_line_t>
+void latency_mark_vector(uint32_t a_cycles)
+{
+    if constexpr (latency_traced_line >= first_line_t && latency_traced_line <= last_line_t)
+    {
+        if (true == cml::is_bit(EXTI->PR1, latency_traced_line))
+        {
+            cml::debug::latency::mark(cml::debug::latency::Path::exti, cml::debug::latency::Stage::vector, a_cycles);
+        }
+    }
+    else
+    {
+        (void)a_cycles;
+    }
+}
+#endif // CML_TRACE_LATENCY
+
 } // namespace ::
 
 extern "C"
@@ -43,6 +88,13 @@ static bool interrupt_handler(uint32_t a_pr1, uint32_t a_index)
 
     if (true == is_bit(a_pr1, a_index))
     {
+#ifdef CML_TRACE_LATENCY
+        if (latency_traced_line == a_index)
+        {
+            cml::debug::latency::mark(cml::debug::latency::Path::exti, cml::debug::latency::Stage::dispatch);
+        }
+#endif // CML_TRACE_LATENCY
+
         return handlers[a_index].callback.function(handlers[a_index].p_pin->get_level(),
                                                    handlers[a_index].callback.p_user_data);
     }
@@ -52,6 +104,14 @@ static bool interrupt_handler(uint32_t a_pr1, uint32_t a_index)
 
 void EXTI0_IRQHandler()
 {
+#ifdef CML_TRACE_LATENCY
+    latency_mark_vector<0u, 0u>(cml::hal::core::get_cycle_counter());
+#endif // CML_TRACE_LATENCY
+
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti0_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     if (true == interrupt_handler(EXTI->PR1, 0))
     {
         set_bit(&(EXTI->PR1), 0);
@@ -60,6 +120,14 @@ void EXTI0_IRQHandler()
 
 void EXTI1_IRQHandler()
 {
+#ifdef CML_TRACE_LATENCY
+    latency_mark_vector<1u, 1u>(cml::hal::core::get_cycle_counter());
+#endif // CML_TRACE_LATENCY
+
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti1_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     if (true == interrupt_handler(EXTI->PR1, 1))
     {
         set_bit(&(EXTI->PR1), 1);
@@ -68,6 +136,14 @@ void EXTI1_IRQHandler()
 
 void EXTI2_IRQHandler()
 {
+#ifdef CML_TRACE_LATENCY
+    latency_mark_vector<2u, 2u>(cml::hal::core::get_cycle_counter());
+#endif // CML_TRACE_LATENCY
+
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti2_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     if (true == interrupt_handler(EXTI->PR1, 2))
     {
         set_bit(&(EXTI->PR1), 2);
@@ -76,6 +152,14 @@ void EXTI2_IRQHandler()
 
 void EXTI3_IRQHandler()
 {
+#ifdef CML_TRACE_LATENCY
+    latency_mark_vector<3u, 3u>(cml::hal::core::get_cycle_counter());
+#endif // CML_TRACE_LATENCY
+
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti3_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     if (true == interrupt_handler(EXTI->PR1, 3))
     {
         set_bit(&(EXTI->PR1), 3);
@@ -84,6 +168,14 @@ void EXTI3_IRQHandler()
 
 void EXTI4_IRQHandler()
 {
+#ifdef CML_TRACE_LATENCY
+    latency_mark_vector<4u, 4u>(cml::hal::core::get_cycle_counter());
+#endif // CML_TRACE_LATENCY
+
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti4_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     if (true == interrupt_handler(EXTI->PR1, 4))
     {
         set_bit(&(EXTI->PR1), 4);
@@ -92,6 +184,14 @@ void EXTI4_IRQHandler()
 
 void EXTI9_5_IRQHandler()
 {
+#ifdef CML_TRACE_LATENCY
+    latency_mark_vector<5u, 9u>(cml::hal::core::get_cycle_counter());
+#endif // CML_TRACE_LATENCY
+
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti9_5_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     for (uint32_t i = 5u; i <= 9u; i++)
     {
         if (true == interrupt_handler(EXTI->PR1, i))
@@ -103,6 +203,14 @@ void EXTI9_5_IRQHandler()
 
 void EXTI15_10_IRQHandler()
 {
+#ifdef CML_TRACE_LATENCY
+    latency_mark_vector<10u, 15u>(cml::hal::core::get_cycle_counter());
+#endif // CML_TRACE_LATENCY
+
+#ifdef CML_PROFILE_IRQ
+    cml::debug::profiler::Scope profiler_scope(&exti15_10_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     for (uint32_t i = 10u; i <= 15u; i++)
     {
         if (true == interrupt_handler(EXTI->PR1, i))
@@ -10,7 +10,7 @@
 
 //soc
 #include <soc/counter.hpp>
-#include <soc/Interrupt_guard.hpp>
+#include <soc/Priority_guard.hpp>
 #include <soc/stm32l452xx/mcu.hpp>
 
 //cml
@@ -119,7 +119,7 @@ void rng::register_new_value_callback(const New_value_callback& a_callback)
 {
     assert(nullptr != a_callback.function);
 
-    Interrupt_guard guard;
+    Priority_guard guard(NVIC_GetPriority(RNG_IRQn));
 
     new_value_callback = a_callback;
     set_flag(&(RNG->CR), RNG_CR_IE);
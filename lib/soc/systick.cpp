@@ -18,10 +18,18 @@
 #include <stm32l0xx.h>
 #endif
 
+#ifdef CML_HOST
+#include <soc/host/simulation.hpp>
+#endif
+
 //cml
 #include <cml/bit.hpp>
+#ifdef CML_PROFILE_IRQ
+#include <cml/debug/profiler.hpp>
+#endif // CML_PROFILE_IRQ
 
 //soc
+#include <soc/Edge_clock.hpp>
 #include <soc/Interrupt_guard.hpp>
 
 namespace
@@ -31,6 +39,29 @@ using namespace soc;
 
 systick::Tick_callback callback;
 
+// cycles counted up to the last reload and the reload value the counter is running from
+uint64_t cycles_base = 0;
+uint32_t running_load = 0;
+
+// reload value of one tick
+uint32_t tick_load = 0;
+
+#ifdef CML_HOST
+bool enabled = false;
+#else
+void call_tick_callback(uint32_t a_count)
+{
+    for (uint32_t i = 0; i < a_count && nullptr != callback.function; i++)
+    {
+        callback.function(callback.p_user_data);
+    }
+}
+#endif // CML_HOST
+
+#ifdef CML_PROFILE_IRQ
+cml::debug::profiler::Zone systick_irq_zone("SysTick_Handler");
+#endif // CML_PROFILE_IRQ
+
 } // namespace ::
 
 extern "C"
@@ -38,6 +69,17 @@ extern "C"
 
 void SysTick_Handler()
 {
+    cycles_base += running_load + 1u;
+
+#ifndef CML_HOST
+    running_load = SysTick->LOAD;
+#endif // !CML_HOST
+
+#ifdef CML_PROFILE_IRQ
+    // started after the period is counted - without a DWT the cycle counter is based on it
+    cml::debug::profiler::Scope profiler_scope(&systick_irq_zone);
+#endif // CML_PROFILE_IRQ
+
     if (nullptr != callback.function)
     {
         callback.function(callback.p_user_data);
@@ -54,17 +96,34 @@ void systick::enable(uint32_t a_start_value, uint32_t a_priority)
 {
     assert(a_start_value > 0);
 
+    cycles_base  = 0;
+    running_load = a_start_value;
+    tick_load    = a_start_value;
+
+#ifdef CML_HOST
+    // ticks come from host::simulation::advance
+    enabled = true;
+    (void)a_priority;
+#else
     NVIC_SetPriority(SysTick_IRQn, a_priority);
 
     SysTick->CTRL = 0;
     SysTick->LOAD = a_start_value;
     SysTick->VAL  = 0;
     SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif // CML_HOST
+
+    // the first point the busy waits can be measured at
+    Edge_clock::calibrate();
 }
 
 void systick::disable()
 {
+#ifdef CML_HOST
+    enabled = false;
+#else
     SysTick->CTRL = 0;
+#endif // CML_HOST
 }
 
 void systick::register_tick_callback(const Tick_callback& a_callback)
@@ -82,7 +141,123 @@ void systick::unregister_tick_callback()
 
 bool systick::is_enabled()
 {
+#ifdef CML_HOST
+    return enabled;
+#else
     return is_flag(SysTick->CTRL, SysTick_CTRL_ENABLE_Msk);
+#endif // CML_HOST
+}
+
+uint64_t systick::get_cycles()
+{
+#ifdef CML_HOST
+    // the simulated counter only moves in whole ticks
+    return cycles_base;
+#else
+    Interrupt_guard guard;
+
+    uint32_t value = SysTick->VAL;
+
+    // reload already happened but the handler did not run yet - the pending flag tells which side of it VAL was read
+    if (true == is_flag(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk))
+    {
+        value = SysTick->VAL;
+
+        return 0 == value ? cycles_base + running_load : cycles_base + running_load + 1u + (SysTick->LOAD - value);
+    }
+
+    return cycles_base + (running_load - value);
+#endif // CML_HOST
+}
+
+uint32_t systick::get_tick_period()
+{
+    return tick_load + 1u;
+}
+
+uint32_t systick::sleep(uint32_t a_max_ticks)
+{
+    assert(a_max_ticks > 0);
+    assert(true == is_enabled());
+
+#ifdef CML_HOST
+    // nothing to wait for on the host - the deadline is reached at once, the ticks run even from under
+    // an Interrupt_guard (as the target calls the tick callback for them itself)
+    const uint32_t primask = host::simulation::get_primask();
+
+    host::simulation::set_primask(0);
+    host::simulation::advance(a_max_ticks);
+    host::simulation::set_primask(primask);
+
+    return a_max_ticks;
+#else
+    const uint32_t period = tick_load + 1u;
+
+    Interrupt_guard guard;
+
+    clear_flag(&(SysTick->CTRL), SysTick_CTRL_ENABLE_Msk);
+
+    // a tick is pending or just about to be - the handler has to run first
+    if (true == is_flag(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk) || SysTick->VAL < 2u)
+    {
+        set_flag(&(SysTick->CTRL), SysTick_CTRL_ENABLE_Msk);
+        return 0;
+    }
+
+    // cycles left to the next tick boundary
+    const uint32_t remaining = SysTick->VAL;
+    const uint32_t max_ticks = (SysTick_LOAD_RELOAD_Msk - remaining) / period + 1u;
+    const uint32_t ticks     = a_max_ticks < max_ticks ? a_max_ticks : max_ticks;
+
+    cycles_base += running_load - remaining;
+    running_load = remaining - 1u + (ticks - 1u) * period;
+
+    // one long period up to the deadline, then back to regular ticks (LOAD is only taken at the next reload)
+    SysTick->LOAD = running_load;
+    SysTick->VAL  = 0;
+    set_flag(&(SysTick->CTRL), SysTick_CTRL_ENABLE_Msk);
+    SysTick->LOAD = tick_load;
+
+    // wakes on any pending interrupt, masked or not - they are serviced when the guard is released
+    __DSB();
+    __WFI();
+    __ISB();
+
+    clear_flag(&(SysTick->CTRL), SysTick_CTRL_ENABLE_Msk);
+
+    if (true == is_flag(SCB->ICSR, SCB_ICSR_PENDSTSET_Msk))
+    {
+        // deadline reached, the pending handler accounts for the long period and calls the last tick
+        set_flag(&(SysTick->CTRL), SysTick_CTRL_ENABLE_Msk);
+        call_tick_callback(ticks - 1u);
+
+        return ticks;
+    }
+
+    // woken up early by another interrupt - step the ticks that passed and restore the tick phase
+    const uint32_t slept  = running_load - SysTick->VAL;
+    uint32_t ticks_passed = slept >= remaining ? 1u + (slept - remaining) / period : 0;
+    uint32_t to_next_tick = slept >= remaining ? period - (slept - remaining) % period : remaining - slept;
+
+    // LOAD of 0 would stop the counter - take the tick now instead
+    if (to_next_tick < 2u)
+    {
+        ticks_passed++;
+        to_next_tick += period;
+    }
+
+    cycles_base += slept;
+    running_load = to_next_tick - 1u;
+
+    SysTick->LOAD = running_load;
+    SysTick->VAL  = 0;
+    set_flag(&(SysTick->CTRL), SysTick_CTRL_ENABLE_Msk);
+    SysTick->LOAD = tick_load;
+
+    call_tick_callback(ticks_passed);
+
+    return ticks_passed;
+#endif // CML_HOST
 }
 
 } // namespace soc
@@ -36,6 +36,26 @@ public:
 
     static bool is_enabled();
 
+    //
+    // Core clock cycles since 'enable': counted periods plus the live counter value. 64-bit, so it does
+    // not wrap in the lifetime of a device.
+    //
+    static uint64_t get_cycles();
+
+    //
+    // Cycles per tick ('a_start_value' + 1).
+    //
+    static uint32_t get_tick_period();
+
+    //
+    // Tickless idle: stops the periodic interrupt, reloads systick to fire at the tick boundary
+    // 'a_max_ticks' ahead (capped by the 24-bit counter) and sleeps (WFI) until then or until any other
+    // interrupt wakes the core. The tick callback is then called once for every tick that passed, so
+    // counters based on it stay right, and regular ticks resume in phase. Returns the number of ticks slept.
+    // Costs a few cycles of drift per call.
+    //
+    static uint32_t sleep(uint32_t a_max_ticks);
+
 private:
 
     systick()               = delete;
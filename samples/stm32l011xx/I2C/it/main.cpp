@@ -74,6 +74,12 @@ void print_status(Console* a_p_console, const char* a_p_tag, I2C_base::Bus_statu
             a_p_console->write("unknown ");
         }
         break;
+
+        case I2C_base::Bus_status_flag::timeout:
+        {
+            a_p_console->write("timeout ");
+        }
+        break;
     }
 
     a_p_console->write_line("-> bytes: %u", a_bytes);
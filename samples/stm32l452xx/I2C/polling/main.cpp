@@ -75,6 +75,12 @@ void print_status(Console* a_p_console,
             a_p_console->write("unknown ");
         }
         break;
+
+        case I2C_base::Bus_status_flag::timeout:
+        {
+            a_p_console->write("timeout ");
+        }
+        break;
     }
 
     a_p_console->write_line("-> bytes: %u", a_bytes);
@@ -179,6 +185,10 @@ int main()
             I2C_master i2c_master_bus(I2C_master::Id::_1);
             i2c_master_bus.enable({ false, true, false, 0x00200205 }, I2C_master::Clock_source::sysclk, 0x1u);
 
+            // a slave stuck in the middle of a byte is clocked out instead of timing every later transfer out
+            mcu::enable_dwt();
+            i2c_master_bus.enable_bus_recovery({ &gpio_port_b, 8u, &gpio_port_b, 9u, i2c_pin_config, 25000u });
+
             delay::ms(500);
 
             const uint8_t data_to_send[] = { 0x1u, 0x2u };
@@ -216,6 +226,9 @@ int main()
 
 
                     print_status(&console, "capcom", result.bus_status, bytes);
+                    console.write_line("recoveries: %u nacks: %u",
+                                       i2c_master_bus.get_bus_recovery_count(),
+                                       i2c_master_bus.get_nack_count());
                     delay::ms(1000);
                 }
             }
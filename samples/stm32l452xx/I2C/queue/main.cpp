@@ -0,0 +1,204 @@
+/*
+    Name: main.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//
+// Two TMP102 temperature sensors (0x48, 0x49) on I2C1 (PB8/PB9) read back-to-back through the I2C_master
+// transaction queue. Each read is a register read (pointer write, repeated START, 2 byte read); the
+// completion callback puts the transaction back into the queue. Results go to USART2 (PA2, 115200 8N1).
+//
+
+//cml
+#include <cml/frequency.hpp>
+#include <cml/hal/counter.hpp>
+#include <cml/hal/mcu.hpp>
+#include <cml/hal/systick.hpp>
+#include <cml/hal/peripherals/GPIO.hpp>
+#include <cml/hal/peripherals/I2C.hpp>
+#include <cml/hal/peripherals/USART.hpp>
+#include <cml/utils/delay.hpp>
+#include <cml/utils/Console.hpp>
+
+namespace
+{
+
+using namespace cml;
+using namespace cml::hal;
+using namespace cml::hal::peripherals;
+using namespace cml::utils;
+
+struct Sensor
+{
+    I2C_master* p_bus = nullptr;
+    I2C_master::Transaction transaction;
+
+    uint8_t raw[2] = { 0x0u, 0x0u };
+
+    volatile uint32_t reads  = 0;
+    volatile uint32_t errors = 0;
+};
+
+Sensor sensors[2];
+
+void read_completed(I2C_master::Transaction* a_p_transaction, void* a_p_user_data)
+{
+    Sensor* p_sensor = static_cast<Sensor*>(a_p_user_data);
+
+    if (I2C_master::Bus_status_flag::ok == a_p_transaction->bus_status)
+    {
+        p_sensor->reads = p_sensor->reads + 1u;
+    }
+    else
+    {
+        p_sensor->errors = p_sensor->errors + 1u;
+    }
+
+    p_sensor->p_bus->enqueue(a_p_transaction);
+}
+
+void tick(void* a_p_user_data)
+{
+    counter::update(nullptr);
+    static_cast<I2C_master*>(a_p_user_data)->update();
+}
+
+uint32_t write_character(char a_character, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->transmit_bytes_polling(&a_character, 1).data_length_in_words;
+}
+
+uint32_t write_string(const char* a_p_string, uint32_t a_length, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->transmit_bytes_polling(a_p_string, a_length).data_length_in_words;
+}
+
+uint32_t read_key(char* a_p_out, uint32_t a_length, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->receive_bytes_polling(a_p_out, a_length).data_length_in_words;
+}
+
+} // namespace ::
+
+int main()
+{
+    mcu::enable_hsi_clock(mcu::Hsi_frequency::_16_MHz);
+    mcu::set_sysclk(mcu::Sysclk_source::hsi, { mcu::Bus_prescalers::AHB::_1,
+                                               mcu::Bus_prescalers::APB1::_1,
+                                               mcu::Bus_prescalers::APB2::_1 });
+
+    if (mcu::Sysclk_source::hsi == mcu::get_sysclk_source())
+    {
+        mcu::set_nvic({ mcu::NVIC_config::Grouping::_4, 10u << 4u });
+
+        mcu::disable_msi_clock();
+        mcu::enable_syscfg();
+
+        GPIO gpio_port_a(GPIO::Id::a);
+        GPIO gpio_port_b(GPIO::Id::b);
+
+        gpio_port_a.enable();
+        gpio_port_b.enable();
+
+        pin::af::Config usart_pin_config =
+        {
+            pin::Mode::push_pull,
+            pin::Pull::up,
+            pin::Speed::low,
+            0x7u
+        };
+
+        pin::af::Config i2c_pin_config =
+        {
+            pin::Mode::open_drain,
+            pin::Pull::up,
+            pin::Speed::high,
+            0x4u
+        };
+
+        pin::af::enable(&gpio_port_a, 2u, usart_pin_config);
+        pin::af::enable(&gpio_port_a, 3u, usart_pin_config);
+
+        pin::af::enable(&gpio_port_b, 8u, i2c_pin_config);
+        pin::af::enable(&gpio_port_b, 9u, i2c_pin_config);
+
+        I2C_master i2c_master_bus(I2C_master::Id::_1);
+        i2c_master_bus.enable({ true, false, false, 0x0u }, I2C_master::Clock_source::sysclk, 0x1u);
+
+        // 400 kHz solved for the 16 MHz sysclk, short traces with 2.2k pull-ups
+        i2c_master_bus.set_timing({ kHz(400), 30u, 30u, true, 0u });
+
+        // the data moves by DMA, interrupts come at the segment ends and the STOP only
+        i2c_master_bus.enable_dma();
+
+        systick::enable((mcu::get_sysclk_frequency_hz() / kHz(1)) - 1, 0x9u);
+        systick::register_tick_callback({ tick, &i2c_master_bus });
+
+        USART console_usart(USART::Id::_2);
+        bool usart_ready = console_usart.enable({ 115200u,
+                                                  USART::Oversampling::_16,
+                                                  USART::Stop_bits::_1,
+                                                  USART::Flow_control_flag::none,
+                                                  USART::Sampling_method::three_sample_bit,
+                                                  USART::Mode_flag::tx
+                                                },
+
+                                                { USART::Word_length::_8_bit,
+                                                  USART::Parity::none
+                                                },
+
+                                                { USART::Clock::Source::sysclk,
+                                                  mcu::get_sysclk_frequency_hz(),
+                                                },
+                                                0x1u, 10);
+
+        if (true == usart_ready)
+        {
+            Console console({ write_character, &console_usart },
+                            { write_string,    &console_usart },
+                            { read_key,        &console_usart });
+            console.write_line("CML I2C queue sample. CPU speed: %u MHz", mcu::get_sysclk_frequency_hz() / MHz(1));
+
+            for (uint32_t i = 0; i < 2u; i++)
+            {
+                Sensor* p_sensor = &(sensors[i]);
+
+                p_sensor->p_bus = &i2c_master_bus;
+
+                p_sensor->transaction.timeout  = 5u;
+                p_sensor->transaction.callback = { read_completed, p_sensor };
+
+                // temperature register
+                i2c_master_bus.enqueue_read_registers(&(p_sensor->transaction),
+                                                      static_cast<uint16_t>(0x48u + i),
+                                                      0x0u,
+                                                      p_sensor->raw,
+                                                      sizeof(p_sensor->raw));
+            }
+
+            while (true)
+            {
+                delay::ms(1000);
+
+                for (uint32_t i = 0; i < 2u; i++)
+                {
+                    // 12 bit two's complement, 0.0625 C per LSB (Q4) - may mix two reads, good enough for a printout
+                    const int32_t raw = static_cast<int16_t>((sensors[i].raw[0] << 8u) | sensors[i].raw[1]) >> 4;
+
+                    console.write_line("0x%x: %.2q4 C, reads: %u, errors: %u",
+                                       0x48u + i,
+                                       raw,
+                                       sensors[i].reads,
+                                       sensors[i].errors);
+                }
+            }
+        }
+    }
+
+    while (true);
+}
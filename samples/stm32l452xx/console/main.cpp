@@ -103,7 +103,7 @@ int main()
                             { write_string,    &console_usart },
                             { read_key,        &console_usart });
 
-            console.write_line("CML Console sample. CPU speed: %u MHz", mcu::get_sysclk_frequency_hz() / MHz(1));
+            console.write_line(CML_FORMAT("CML Console sample. CPU speed: %u MHz"), mcu::get_sysclk_frequency_hz() / MHz(1));
 
             while (true)
             {
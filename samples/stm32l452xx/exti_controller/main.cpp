@@ -8,16 +8,47 @@
 //cml
 #include <cml/frequency.hpp>
 #include <cml/hal/mcu.hpp>
+#include <cml/hal/systick.hpp>
 #include <cml/hal/peripherals/GPIO.hpp>
 #include <cml/hal/system/exti_controller.hpp>
+#include <cml/utils/Scheduler.hpp>
+#include <cml/utils/Timer_service.hpp>
 
 namespace {
 
 using namespace cml::hal::peripherals;
+using namespace cml::utils;
+
+struct Led_toggle
+{
+    Scheduler* p_scheduler         = nullptr;
+    Timer_service* p_timer_service = nullptr;
+    Timer_service::Timer* p_timer  = nullptr;
+    pin::Out* p_led_pin            = nullptr;
+};
+
+void led_off_callback(void* a_p_user_data)
+{
+    reinterpret_cast<pin::Out*>(a_p_user_data)->set_level(pin::Level::low);
+}
+
+void toggle_task(void* a_p_user_data)
+{
+    Led_toggle* p_led_toggle = reinterpret_cast<Led_toggle*>(a_p_user_data);
+
+    // on for a second after the last press
+    p_led_toggle->p_led_pin->set_level(pin::Level::high);
+    p_led_toggle->p_timer_service->start_one_shot(p_led_toggle->p_timer,
+                                                  1000u,
+                                                  { led_off_callback, p_led_toggle->p_led_pin });
+}
 
 bool exti_callback(pin::Level, void* a_p_user_data)
 {
-    reinterpret_cast<pin::Out*>(a_p_user_data)->toggle_level();
+    Led_toggle* p_led_toggle = reinterpret_cast<Led_toggle*>(a_p_user_data);
+
+    // the interrupt only posts, the work runs in the main loop
+    p_led_toggle->p_scheduler->post({ toggle_task, p_led_toggle }, 0);
     return true;
 }
 
@@ -29,6 +60,7 @@ int main()
     using namespace cml::hal;
     using namespace cml::hal::peripherals;
     using namespace cml::hal::system;
+    using namespace cml::utils;
 
     mcu::enable_hsi_clock(mcu::Hsi_frequency::_16_MHz);
     mcu::set_sysclk(mcu::Sysclk_source::hsi, { mcu::Bus_prescalers::AHB::_1,
@@ -56,12 +88,28 @@ int main()
 
         led_pin.set_level(pin::Level::low);
 
+        Scheduler scheduler;
+        Timer_service timer_service;
+        Timer_service::Timer led_off_timer;
+        Led_toggle led_toggle{ &scheduler, &timer_service, &led_off_timer, &led_pin };
+
+        // the timers are all the systick drives
+        systick::enable((mcu::get_sysclk_frequency_hz() / kHz(1)) - 1, 0x9u);
+        systick::register_tick_callback({ Timer_service::tick_handler, &timer_service });
+
         exti_controller::enable(0x5u);
         exti_controller::register_callback(&button_pin, 
                                            exti_controller::Interrupt_mode::rising,
-                                           { exti_callback, &led_pin });
-
-        while (true) {}
+                                           { exti_callback, &led_toggle });
+
+        while (true)
+        {
+            if (false == scheduler.dispatch())
+            {
+                // tickless - no 1 kHz wake-ups while waiting for the button, the LED timer ends the sleep when armed
+                scheduler.idle(timer_service.get_ticks_to_next_expiry(1000u));
+            }
+        }
     }
 
     while (true);
@@ -0,0 +1,259 @@
+/*
+    Name: main.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//
+// Interrupt latency benchmark. Needs two jumper wires: PB0 -> PB1 (EXTI edge) and PA9 -> PA10 (USART1 loopback).
+// Results are printed on USART2 (PA2/PA3, 115200 8N1) in core cycles. The library is built with
+// CML_TRACE_LATENCY (see makefile), so the drivers stamp the 'vector' and 'dispatch' stages - the USART ones on
+// the RXNE interrupts of USART1 only (CML_TRACE_LATENCY_USART), the console on USART2 does not disturb them, the
+// EXTI ones on line 1 only (CML_TRACE_LATENCY_EXTI).
+//
+
+//cml
+#include <cml/frequency.hpp>
+#include <cml/debug/latency.hpp>
+#include <cml/hal/counter.hpp>
+#include <cml/hal/mcu.hpp>
+#include <cml/hal/systick.hpp>
+#include <cml/hal/peripherals/GPIO.hpp>
+#include <cml/hal/peripherals/USART.hpp>
+#include <cml/hal/system/exti_controller.hpp>
+#include <cml/utils/Console.hpp>
+#include <cml/utils/delay.hpp>
+
+namespace
+{
+
+using namespace cml;
+using namespace cml::debug;
+using namespace cml::hal;
+using namespace cml::hal::peripherals;
+using namespace cml::utils;
+
+constexpr uint32_t samples_count = 256u;
+
+struct Samples
+{
+    uint32_t trigger_to_vector[samples_count];
+    uint32_t vector_to_dispatch[samples_count];
+    uint32_t dispatch_to_callback[samples_count];
+    uint32_t trigger_to_callback[samples_count];
+};
+
+Samples exti_samples;
+Samples usart_samples;
+
+volatile bool done = false;
+
+uint32_t write_character(char a_character, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->transmit_bytes_polling(&a_character, 1).data_length_in_words;
+}
+
+uint32_t write_string(const char* a_p_string, uint32_t a_length, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->transmit_bytes_polling(a_p_string, a_length).data_length_in_words;
+}
+
+uint32_t read_key(char* a_p_out, uint32_t a_length, void* a_p_user_data)
+{
+    USART* p_console_usart = reinterpret_cast<USART*>(a_p_user_data);
+    return p_console_usart->receive_bytes_polling(a_p_out, a_length).data_length_in_words;
+}
+
+bool exti_callback(pin::Level, void*)
+{
+    latency::mark(latency::Path::exti, latency::Stage::callback);
+    done = true;
+
+    return true;
+}
+
+bool usart_rx_callback(uint32_t, bool, void*)
+{
+    latency::mark(latency::Path::usart_rx, latency::Stage::callback);
+    done = true;
+
+    return true;
+}
+
+void store(latency::Path a_path, Samples* a_p_samples, uint32_t a_index)
+{
+    a_p_samples->trigger_to_vector[a_index] =
+        latency::get_cycles(a_path, latency::Stage::trigger, latency::Stage::vector);
+    a_p_samples->vector_to_dispatch[a_index] =
+        latency::get_cycles(a_path, latency::Stage::vector, latency::Stage::dispatch);
+    a_p_samples->dispatch_to_callback[a_index] =
+        latency::get_cycles(a_path, latency::Stage::dispatch, latency::Stage::callback);
+    a_p_samples->trigger_to_callback[a_index] =
+        latency::get_cycles(a_path, latency::Stage::trigger, latency::Stage::callback);
+}
+
+void write_summary(Console* a_p_console, const char* a_p_name, uint32_t* a_p_samples)
+{
+    const latency::Summary summary = latency::summarize(a_p_samples, samples_count);
+
+    a_p_console->write_line(CML_FORMAT("%s: min %u, p50 %u, p90 %u, p99 %u, max %u, jitter %u"),
+                            a_p_name,
+                            summary.min,
+                            summary.p50,
+                            summary.p90,
+                            summary.p99,
+                            summary.max,
+                            summary.jitter);
+}
+
+void write_summaries(Console* a_p_console, const char* a_p_path, Samples* a_p_samples)
+{
+    a_p_console->write_line(a_p_path);
+
+    write_summary(a_p_console, "  trigger -> vector    ", a_p_samples->trigger_to_vector);
+    write_summary(a_p_console, "  vector -> dispatch   ", a_p_samples->vector_to_dispatch);
+    write_summary(a_p_console, "  dispatch -> callback ", a_p_samples->dispatch_to_callback);
+    write_summary(a_p_console, "  trigger -> callback  ", a_p_samples->trigger_to_callback);
+}
+
+} // namespace ::
+
+int main()
+{
+    using namespace cml;
+    using namespace cml::hal;
+    using namespace cml::hal::peripherals;
+    using namespace cml::hal::system;
+    using namespace cml::utils;
+
+    mcu::enable_hsi_clock(mcu::Hsi_frequency::_16_MHz);
+    mcu::set_sysclk(mcu::Sysclk_source::hsi, { mcu::Bus_prescalers::AHB::_1,
+                                               mcu::Bus_prescalers::APB1::_1,
+                                               mcu::Bus_prescalers::APB2::_1 });
+
+    if (mcu::Sysclk_source::hsi == mcu::get_sysclk_source())
+    {
+        mcu::set_nvic({ mcu::NVIC_config::Grouping::_4, 10u << 4u });
+        mcu::enable_syscfg();
+        mcu::enable_dwt();
+
+        mcu::disable_msi_clock();
+        systick::enable((mcu::get_sysclk_frequency_hz() / kHz(1)) - 1, 0x9u);
+        systick::register_tick_callback({ counter::update, nullptr });
+
+        USART::Config usart_config =
+        {
+            115200,
+            USART::Oversampling::_16,
+            USART::Stop_bits::_1,
+            USART::Flow_control_flag::none,
+            USART::Sampling_method::three_sample_bit,
+            USART::Mode_flag::rx | USART::Mode_flag::tx
+        };
+
+        USART::Frame_format usart_frame_format
+        {
+            USART::Word_length::_8_bit,
+            USART::Parity::none
+        };
+
+        USART::Clock usart_clock
+        {
+            USART::Clock::Source::sysclk,
+            mcu::get_sysclk_frequency_hz(),
+        };
+
+        pin::af::Config usart_pin_config =
+        {
+            pin::Mode::push_pull,
+            pin::Pull::up,
+            pin::Speed::high,
+            0x7u
+        };
+
+        GPIO gpio_port_a(GPIO::Id::a);
+        GPIO gpio_port_b(GPIO::Id::b);
+
+        gpio_port_a.enable();
+        gpio_port_b.enable();
+
+        pin::af::enable(&gpio_port_a, 2, usart_pin_config);
+        pin::af::enable(&gpio_port_a, 3, usart_pin_config);
+        pin::af::enable(&gpio_port_a, 9, usart_pin_config);
+        pin::af::enable(&gpio_port_a, 10, usart_pin_config);
+
+        // one BSRR store between the 'trigger' stamp and the edge
+        using trigger_pin = Out_pin_t<GPIO::Id::b, 0u>;
+        pin::In edge_pin;
+
+        pin::out::enable(&gpio_port_b, 0u, { pin::Mode::push_pull, pin::Pull::down, pin::Speed::high });
+        pin::in::enable(&gpio_port_b, 1u, pin::Pull::down, &edge_pin);
+
+        trigger_pin::set_low();
+
+        USART console_usart(USART::Id::_2);
+        USART_t<USART::Id::_1> loopback_usart;
+
+        bool usart_ready = console_usart.enable(usart_config, usart_frame_format, usart_clock, 0x1u, 10) &&
+                           loopback_usart.enable(usart_config, usart_frame_format, usart_clock, 0x1u, 10);
+
+        if (true == usart_ready)
+        {
+            Console console({ write_character, &console_usart },
+                            { write_string,    &console_usart },
+                            { read_key,        &console_usart });
+
+            exti_controller::enable(0x1u);
+            exti_controller::register_callback(&edge_pin,
+                                               exti_controller::Interrupt_mode::rising,
+                                               { exti_callback, nullptr });
+
+            loopback_usart.register_receive_callback({ usart_rx_callback, nullptr });
+
+            // nothing else may preempt the measured paths
+            systick::disable();
+
+            for (uint32_t i = 0; i < samples_count; i++)
+            {
+                done = false;
+
+                latency::mark(latency::Path::exti, latency::Stage::trigger);
+                trigger_pin::set_high();
+
+                while (false == done);
+
+                store(latency::Path::exti, &exti_samples, i);
+
+                trigger_pin::set_low();
+                delay::us(100u);
+            }
+
+            for (uint32_t i = 0; i < samples_count; i++)
+            {
+                const char byte = static_cast<char>(i);
+                done            = false;
+
+                latency::mark(latency::Path::usart_rx, latency::Stage::trigger);
+                loopback_usart.transmit_bytes_polling(&byte, 1);
+
+                while (false == done);
+
+                store(latency::Path::usart_rx, &usart_samples, i);
+            }
+
+            console.write_line(CML_FORMAT("CML latency sample. CPU speed: %u MHz, %u samples, cycles:"),
+                               mcu::get_sysclk_frequency_hz() / MHz(1),
+                               samples_count);
+
+            write_summaries(&console, "EXTI edge -> exti_controller::Callback", &exti_samples);
+
+            // the trigger is the start of the transmission, so it includes the whole frame on the wire
+            write_summaries(&console, "USART1 byte -> USART::RX_callback", &usart_samples);
+        }
+    }
+
+    while (true);
+}
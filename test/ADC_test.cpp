@@ -0,0 +1,74 @@
+/*
+    Name: ADC_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#include <cml/hal/peripherals/ADC.hpp>
+
+//soc
+#include <soc/host/simulation.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml::hal::peripherals;
+using namespace soc::host;
+
+namespace {
+
+struct Conversions
+{
+    uint16_t values[4] = { 0 };
+    uint32_t count     = 0;
+    bool series_end    = false;
+};
+
+bool conversion_handler(uint16_t a_value, bool a_series_end, void* a_p_user_data)
+{
+    Conversions* p_conversions = static_cast<Conversions*>(a_p_user_data);
+
+    p_conversions->values[p_conversions->count++] = a_value;
+    p_conversions->series_end                     = a_series_end;
+
+    return true;
+}
+
+} // namespace ::
+
+TEST_CASE("ADC returns scripted samples", "[ADC]")
+{
+    ADC adc(ADC::Id::_1);
+    REQUIRE(true == adc.enable(ADC::Resolution::_8_bit,
+                               { ADC::Synchronous_clock::Source::pclk, ADC::Synchronous_clock::Divider::_2 },
+                               0x1u,
+                               10u));
+
+    const uint16_t samples[] = { 10u, 300u, 20u };
+    adc.set_samples(samples, 3);
+
+    const ADC::Channel channels[] = { { ADC::Channel::Id::_1, ADC::Channel::Sampling_time::_2_5_clock_cycles },
+                                      { ADC::Channel::Id::_2, ADC::Channel::Sampling_time::_2_5_clock_cycles } };
+    adc.set_active_channels(channels, 2);
+
+    uint16_t values[2];
+    adc.read_polling(values, 2);
+
+    REQUIRE(10u == values[0]);
+    REQUIRE(255u == values[1]);
+
+    Conversions conversions;
+    adc.register_conversion_callback({ conversion_handler, &conversions });
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        simulation::run_interrupts();
+    }
+
+    REQUIRE(2 == conversions.count);
+    REQUIRE(20u == conversions.values[0]);
+    REQUIRE(10u == conversions.values[1]);
+    REQUIRE(true == conversions.series_end);
+}
@@ -0,0 +1,113 @@
+/*
+    Name: GPIO_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#include <cml/hal/peripherals/GPIO.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml;
+using namespace cml::hal::peripherals;
+
+TEST_CASE("Out_pin_t drives a pin of a fixed port", "[GPIO]")
+{
+    using led_pin = Out_pin_t<GPIO::Id::c, 13u>;
+
+    GPIO_t<GPIO::Id::c> port;
+    port.enable();
+
+    pin::out::enable(&port, 13u, { pin::Mode::push_pull, pin::Pull::none, pin::Speed::low });
+
+    led_pin::set_high();
+    REQUIRE(pin::Level::high == led_pin::get_level());
+
+    led_pin::toggle_level();
+    REQUIRE(pin::Level::low == led_pin::get_level());
+
+    led_pin::set_level(pin::Level::high);
+    REQUIRE((0x1u << 13u) == GPIO_t<GPIO::Id::c>::get_registers()->ODR);
+
+    led_pin::set_low();
+    REQUIRE(0u == GPIO_t<GPIO::Id::c>::get_registers()->ODR);
+}
+
+TEST_CASE("Out_pin_group_t updates its pins at once", "[GPIO]")
+{
+    using bus = Out_pin_group_t<GPIO::Id::a, 4u, 2u, 7u>;
+
+    static_assert(0x94u == bus::mask);
+
+    GPIO_t<GPIO::Id::a> port;
+    port.enable();
+
+    GPIO::Registers* p_registers = GPIO_t<GPIO::Id::a>::get_registers();
+    p_registers->ODR = 0x1u;
+
+    bus::set_levels(0x5u);
+    REQUIRE(0x91u == p_registers->ODR);
+
+    bus::set_levels(0x2u);
+    REQUIRE(0x5u == p_registers->ODR);
+
+    bus::toggle_levels();
+    REQUIRE(0x91u == p_registers->ODR);
+
+    bus::set_high();
+    REQUIRE(0x95u == p_registers->ODR);
+
+    bus::set_low();
+    REQUIRE(0x1u == p_registers->ODR);
+}
+
+TEST_CASE("GPIO registers decode BSRR and BRR writes into ODR", "[GPIO]")
+{
+    GPIO_t<GPIO::Id::b> port;
+    port.enable();
+
+    GPIO::Registers* p_registers = GPIO_t<GPIO::Id::b>::get_registers();
+    p_registers->ODR = 0xF0F0u;
+
+    p_registers->BSRR = 0x000Fu;
+    REQUIRE(0xF0FFu == p_registers->ODR);
+
+    p_registers->BSRR = 0x00F0u << 16u;
+    REQUIRE(0xF00Fu == p_registers->ODR);
+
+    // set wins over reset of the same pin
+    p_registers->BSRR = 0x00010001u;
+    REQUIRE(0xF00Fu == p_registers->ODR);
+
+    p_registers->BRR = 0xF001u;
+    REQUIRE(0x000Eu == p_registers->ODR);
+
+    // only pins in output mode read back ODR
+    port.set_input_level(0u, pin::Level::high);
+    pin::out::enable(&port, 1u, { pin::Mode::push_pull, pin::Pull::none, pin::Speed::low });
+
+    REQUIRE(0x3u == (p_registers->IDR & 0x3u));
+}
+
+TEST_CASE("Out_pin_group_t leaves the other pins of the port alone", "[GPIO]")
+{
+    using bus = Out_pin_group_t<GPIO::Id::d, 0u, 15u>;
+
+    GPIO_t<GPIO::Id::d> port;
+    port.enable();
+
+    GPIO::Registers* p_registers = GPIO_t<GPIO::Id::d>::get_registers();
+    p_registers->ODR = 0x7FF0u;
+
+    bus::set_levels(0x2u);
+    REQUIRE(0xFFF0u == p_registers->ODR);
+
+    bus::toggle_levels();
+    REQUIRE(0x7FF1u == p_registers->ODR);
+
+    bus::set_levels(0x0u);
+    REQUIRE(0x7FF0u == p_registers->ODR);
+}
@@ -0,0 +1,316 @@
+/*
+    Name: I2C_timing_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#include <cml/frequency.hpp>
+
+//soc
+#include <soc/I2C_timing.hpp>
+
+//externals
+#include "catch.hpp"
+
+//
+// The only I2C code covered on the host: the host port has no I2C model (see soc/host/simulation.hpp), the
+// drivers - transaction queue, register access, DMA, bus recovery - run on the target only.
+//
+
+using namespace cml;
+using namespace soc;
+
+namespace {
+
+struct Spec
+{
+    frequency scl_frequency_hz = 0;
+
+    int64_t low_min_ns        = 0;
+    int64_t high_min_ns       = 0;
+    int64_t data_setup_min_ns = 0;
+    int64_t data_valid_max_ns = 0;
+    int64_t rise_time_max_ns  = 0;
+    int64_t fall_time_max_ns  = 0;
+};
+
+// UM10204, table 10
+constexpr Spec specs[] =
+{
+    { kHz(100), 4700, 4000, 250, 3450, 1000, 300 },
+    { kHz(400), 1300, 600,  100, 900,  300,  300 },
+    { MHz(1),   500,  260,  50,  450,  120,  120 }
+};
+
+struct Reference
+{
+    frequency clock_frequency_hz = 0;
+    frequency scl_frequency_hz   = 0;
+    uint32_t timingr             = 0;
+};
+
+// CubeMX, rise and fall times 0, analog filter on
+constexpr Reference cubemx[] =
+{
+    { MHz(16), kHz(100), 0x00303D5Bu },
+    { MHz(16), kHz(400), 0x0010061Au },
+    { MHz(32), kHz(100), 0x00707CBBu },
+    { MHz(32), kHz(400), 0x00300F38u },
+    { MHz(80), kHz(100), 0x10909CECu },
+    { MHz(80), kHz(400), 0x00702991u }
+};
+
+int64_t get_clock_ps(frequency a_clock_frequency_hz)
+{
+    return 1000000000000ll / a_clock_frequency_hz;
+}
+
+int64_t get_sync_ps(frequency a_clock_frequency_hz, const I2C_timing::Bus& a_bus)
+{
+    return (true == a_bus.analog_filter ? 50000 : 0) + a_bus.digital_filter * get_clock_ps(a_clock_frequency_hz) +
+           2 * get_clock_ps(a_clock_frequency_hz);
+}
+
+int64_t get_period_ps(frequency a_clock_frequency_hz, const I2C_timing::Bus& a_bus, uint32_t a_timingr)
+{
+    const int64_t tpresc = ((a_timingr >> 28u) + 1) * get_clock_ps(a_clock_frequency_hz);
+
+    return (((a_timingr >> 8u) & 0xFFu) + 1) * tpresc + ((a_timingr & 0xFFu) + 1) * tpresc +
+           2 * get_sync_ps(a_clock_frequency_hz, a_bus) + (a_bus.rise_time_ns + a_bus.fall_time_ns) * 1000ll;
+}
+
+// SCLDEL and SDADEL of 'a_timingr' against the mode limits, in picoseconds, after RM0394 "I2C timings"
+bool is_data_in_spec(frequency a_clock_frequency_hz,
+                     const I2C_timing::Bus& a_bus,
+                     const Spec& a_spec,
+                     uint32_t a_timingr)
+{
+    const int64_t clock  = get_clock_ps(a_clock_frequency_hz);
+    const int64_t tpresc = ((a_timingr >> 28u) + 1) * clock;
+    const int64_t af_min = true == a_bus.analog_filter ? 50000 : 0;
+    const int64_t af_max = true == a_bus.analog_filter ? 260000 : 0;
+    const int64_t dnf    = a_bus.digital_filter * clock;
+    const int64_t rise   = a_bus.rise_time_ns * 1000ll;
+    const int64_t fall   = a_bus.fall_time_ns * 1000ll;
+
+    const int64_t scldel = (((a_timingr >> 20u) & 0xFu) + 1) * tpresc;
+    const int64_t sdadel = ((a_timingr >> 16u) & 0xFu) * tpresc + clock;
+
+    return scldel >= rise + a_spec.data_setup_min_ns * 1000 &&
+           sdadel + af_min + dnf + 3 * clock >= fall &&
+           sdadel + af_max + dnf + 4 * clock <= a_spec.data_valid_max_ns * 1000 - rise;
+}
+
+// SCLH and SCLL of 'a_timingr' against the mode limits and the requested frequency (at most 20% below it)
+bool is_scl_in_spec(frequency a_clock_frequency_hz,
+                    const I2C_timing::Bus& a_bus,
+                    const Spec& a_spec,
+                    uint32_t a_timingr)
+{
+    const int64_t clock  = get_clock_ps(a_clock_frequency_hz);
+    const int64_t tpresc = ((a_timingr >> 28u) + 1) * clock;
+    const int64_t sync   = get_sync_ps(a_clock_frequency_hz, a_bus);
+    const int64_t period = get_period_ps(a_clock_frequency_hz, a_bus, a_timingr);
+
+    const int64_t high = (((a_timingr >> 8u) & 0xFFu) + 1) * tpresc + sync;
+    const int64_t low  = ((a_timingr & 0xFFu) + 1) * tpresc + sync;
+
+    return low >= a_spec.low_min_ns * 1000 && low - sync > 2 * clock &&
+           high >= a_spec.high_min_ns * 1000 && high > clock &&
+           period * a_bus.scl_frequency_hz >= 1000000000000ll &&
+           period * a_bus.scl_frequency_hz * 4 <= 1000000000000ll * 5;
+}
+
+void require_in_spec(frequency a_clock_frequency_hz,
+                     const I2C_timing::Bus& a_bus,
+                     const Spec& a_spec,
+                     uint32_t a_timingr)
+{
+    REQUIRE(true == is_data_in_spec(a_clock_frequency_hz, a_bus, a_spec, a_timingr));
+    REQUIRE(true == is_scl_in_spec(a_clock_frequency_hz, a_bus, a_spec, a_timingr));
+}
+
+// the only limit the formulas cannot meet in the tested range: the data valid time has to hold the shortest
+// SDA delay (SDADEL 0 - one kernel clock), the filters and the 4 kernel clocks of the synchronization
+bool is_data_valid_time_enough(frequency a_clock_frequency_hz, const I2C_timing::Bus& a_bus, const Spec& a_spec)
+{
+    const int64_t clock = get_clock_ps(a_clock_frequency_hz);
+
+    return 5 * clock + (true == a_bus.analog_filter ? 260000 : 0) + a_bus.digital_filter * clock +
+           a_bus.rise_time_ns * 1000ll <= a_spec.data_valid_max_ns * 1000;
+}
+
+//
+// Every waveform in the specification, the registers searched through: none may be closer to the requested
+// frequency than 'a_timingr' - and out of the equally close ones none may have a lower prescaler, or the same
+// prescaler and a longer low period.
+//
+void require_best(frequency a_clock_frequency_hz,
+                  const I2C_timing::Bus& a_bus,
+                  const Spec& a_spec,
+                  uint32_t a_timingr)
+{
+    const int64_t period = get_period_ps(a_clock_frequency_hz, a_bus, a_timingr);
+    const uint32_t presc = a_timingr >> 28u;
+    const uint32_t scll  = a_timingr & 0xFFu;
+
+    uint32_t better = 0;
+
+    for (uint32_t p = 0; p < 16u; p++)
+    {
+        // SCLDEL and SDADEL do not change the SCL period, any in range will do
+        bool data = false;
+
+        for (uint32_t delays = 0; delays < 256u && false == data; delays++)
+        {
+            data = is_data_in_spec(a_clock_frequency_hz, a_bus, a_spec, (p << 28u) | (delays << 16u));
+        }
+
+        for (uint32_t h = 0; h < 256u && true == data; h++)
+        {
+            for (uint32_t l = 0; l < 256u; l++)
+            {
+                const uint32_t timingr = (p << 28u) | (h << 8u) | l;
+
+                if (true == is_scl_in_spec(a_clock_frequency_hz, a_bus, a_spec, timingr))
+                {
+                    const int64_t candidate = get_period_ps(a_clock_frequency_hz, a_bus, timingr);
+
+                    if (candidate < period || (candidate == period && (p < presc || (p == presc && l > scll))))
+                    {
+                        better++;
+                    }
+                }
+            }
+        }
+    }
+
+    REQUIRE(0 == better);
+}
+
+} // namespace ::
+
+TEST_CASE("I2C_timing matches CubeMX", "[I2C_timing]")
+{
+    // CubeMX: 0x00303D5B (~100.3 kHz), 0x0010061A (~404 kHz) - one SCLL step above the request
+    static_assert(0x00303D5Cu == I2C_timing::calculate(MHz(16), { kHz(100), 0, 0, true, 0 }).get_timingr());
+    static_assert(0x0010061Bu == I2C_timing::calculate(MHz(16), { kHz(400), 0, 0, true, 0 }).get_timingr());
+    static_assert(0x00707CBBu == I2C_timing::calculate(MHz(32), { kHz(100), 0, 0, true, 0 }).get_timingr());
+    static_assert(0x00300F38u == I2C_timing::calculate(MHz(32), { kHz(400), 0, 0, true, 0 }).get_timingr());
+    static_assert(0x10909CECu == I2C_timing::calculate(MHz(80), { kHz(100), 0, 0, true, 0 }).get_timingr());
+    static_assert(0x00702991u == I2C_timing::calculate(MHz(80), { kHz(400), 0, 0, true, 0 }).get_timingr());
+
+    for (const Reference& reference : cubemx)
+    {
+        const I2C_timing::Bus bus           = { reference.scl_frequency_hz, 0, 0, true, 0 };
+        const I2C_timing::Result result     = I2C_timing::calculate(reference.clock_frequency_hz, bus);
+        const frequency cubemx_frequency_hz = I2C_timing::get_scl_frequency_hz(reference.clock_frequency_hz,
+                                                                                bus,
+                                                                                reference.timingr);
+
+        REQUIRE(true == result.valid);
+
+        // CubeMX rounds to the nearest, so may go above the requested frequency - this one never does, it takes
+        // the next SCLL then
+        const frequency frequency_hz = I2C_timing::get_scl_frequency_hz(reference.clock_frequency_hz,
+                                                                         bus,
+                                                                         result.get_timingr());
+
+        REQUIRE(frequency_hz <= reference.scl_frequency_hz);
+
+        if (cubemx_frequency_hz > reference.scl_frequency_hz)
+        {
+            REQUIRE(reference.timingr + 1u == result.get_timingr());
+        }
+        else
+        {
+            REQUIRE(reference.timingr == result.get_timingr());
+        }
+    }
+}
+
+TEST_CASE("I2C_timing picks the closest, then the lowest prescaler, then the longest low period", "[I2C_timing]")
+{
+    for (const Reference& reference : cubemx)
+    {
+        const I2C_timing::Bus bus = { reference.scl_frequency_hz, 0, 0, true, 0 };
+
+        require_best(reference.clock_frequency_hz,
+                     bus,
+                     reference.scl_frequency_hz <= kHz(100) ? specs[0] : specs[1],
+                     I2C_timing::calculate(reference.clock_frequency_hz, bus).get_timingr());
+    }
+
+    for (const Spec& spec : specs)
+    {
+        const I2C_timing::Bus buses[] =
+        {
+            { spec.scl_frequency_hz, 0, 0, false, 0 },
+            { spec.scl_frequency_hz, static_cast<uint32_t>(spec.rise_time_max_ns / 2),
+              static_cast<uint32_t>(spec.fall_time_max_ns / 2), true, 2 }
+        };
+
+        for (const I2C_timing::Bus& bus : buses)
+        {
+            for (frequency clock_frequency_hz = MHz(8); clock_frequency_hz <= MHz(80); clock_frequency_hz += MHz(24))
+            {
+                const I2C_timing::Result result = I2C_timing::calculate(clock_frequency_hz, bus);
+
+                if (true == result.valid)
+                {
+                    require_best(clock_frequency_hz, bus, spec, result.get_timingr());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("I2C_timing meets the bus specification", "[I2C_timing]")
+{
+    for (const Spec& spec : specs)
+    {
+        const I2C_timing::Bus buses[] =
+        {
+            { spec.scl_frequency_hz, 0, 0, true, 0 },
+            { spec.scl_frequency_hz, 0, 0, false, 0 },
+            { spec.scl_frequency_hz, static_cast<uint32_t>(spec.rise_time_max_ns), 0, true, 0 },
+            { spec.scl_frequency_hz, 0, static_cast<uint32_t>(spec.fall_time_max_ns), true, 0 },
+            { spec.scl_frequency_hz, static_cast<uint32_t>(spec.rise_time_max_ns / 2),
+              static_cast<uint32_t>(spec.fall_time_max_ns / 2), true, 2 },
+            { spec.scl_frequency_hz * 3 / 4, 0, 0, true, 0 }
+        };
+
+        for (const I2C_timing::Bus& bus : buses)
+        {
+            for (frequency clock_frequency_hz = MHz(8); clock_frequency_hz <= MHz(80); clock_frequency_hz += MHz(4))
+            {
+                const I2C_timing::Result result = I2C_timing::calculate(clock_frequency_hz, bus);
+
+                // standard mode from 8 MHz, fast mode from 16 MHz, fast mode plus with the analog filter from 27 MHz
+                REQUIRE(is_data_valid_time_enough(clock_frequency_hz, bus, spec) == result.valid);
+
+                if (true == result.valid)
+                {
+                    require_in_spec(clock_frequency_hz, bus, spec, result.get_timingr());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("I2C_timing rejects what the peripheral cannot do", "[I2C_timing]")
+{
+    // RM0394: 2 MHz is the slowest kernel clock for standard mode
+    REQUIRE(true == I2C_timing::calculate(MHz(2), { kHz(100), 0, 0, true, 0 }).valid);
+    REQUIRE(false == I2C_timing::calculate(MHz(1), { kHz(100), 0, 0, true, 0 }).valid);
+
+    REQUIRE(false == I2C_timing::calculate(0, { kHz(100), 0, 0, true, 0 }).valid);
+    REQUIRE(false == I2C_timing::calculate(MHz(4), { kHz(400), 0, 0, true, 0 }).valid);
+
+    REQUIRE(false == I2C_timing::calculate(MHz(16), { 0, 0, 0, true, 0 }).valid);
+    REQUIRE(false == I2C_timing::calculate(MHz(16), { MHz(2), 0, 0, true, 0 }).valid);
+    REQUIRE(false == I2C_timing::calculate(MHz(16), { kHz(400), 400, 0, true, 0 }).valid);
+    REQUIRE(false == I2C_timing::calculate(MHz(16), { kHz(100), 0, 0, true, 16 }).valid);
+}
@@ -0,0 +1,54 @@
+/*
+    Name: Logger_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <string>
+
+//cml
+#include <cml/hal/counter.hpp>
+#include <cml/utils/Logger.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml;
+using namespace cml::utils;
+
+namespace {
+
+uint32_t append(const char* a_p_string, uint32_t a_length, void* a_p_user_data)
+{
+    static_cast<std::string*>(a_p_user_data)->append(a_p_string, a_length);
+    return a_length;
+}
+
+} // namespace ::
+
+TEST_CASE("Logger writes immediately or defers records until flush", "[Logger]")
+{
+    std::string output;
+    Logger logger({ append, &output }, true, true, true, true);
+
+    logger.inf("x=%u\n", 5u);
+    REQUIRE(std::string("[inf] x=5\n") == output);
+
+    Logger::Record_word records[16];
+    Logger::Record_ring ring(records, 16);
+
+    output.clear();
+    hal::counter::set(7);
+    logger.enable_deferred_mode(&ring);
+
+    REQUIRE(1 == logger.wrn("%s %d\n", "deferred", -3));
+    REQUIRE(1 == logger.err("plain\n"));
+    REQUIRE(0 == logger.omg("%u %u %u %u %u %u\n", 1u, 2u, 3u, 4u, 5u, 6u));
+    REQUIRE(1 == logger.get_dropped_records());
+    REQUIRE(output.empty());
+
+    REQUIRE(2 == logger.flush());
+    REQUIRE(std::string("[wrn] [7] deferred -3\n[err] [7] plain\n") == output);
+}
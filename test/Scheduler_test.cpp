@@ -0,0 +1,207 @@
+/*
+    Name: Scheduler_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <string>
+#include <thread>
+#include <vector>
+
+//cml
+#include <cml/hal/systick.hpp>
+#include <cml/utils/Scheduler.hpp>
+#include <cml/utils/Timer_service.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml::hal;
+using namespace cml::utils;
+
+namespace {
+
+struct Trace
+{
+    std::string* p_order = nullptr;
+    char id              = 0;
+};
+
+void trace_task(void* a_p_user_data)
+{
+    Trace* p_trace = static_cast<Trace*>(a_p_user_data);
+    p_trace->p_order->push_back(p_trace->id);
+}
+
+struct Tick_post
+{
+    Scheduler* p_scheduler = nullptr;
+    Trace* p_trace         = nullptr;
+};
+
+void tick_handler(void* a_p_user_data)
+{
+    Tick_post* p_post = static_cast<Tick_post*>(a_p_user_data);
+    p_post->p_scheduler->post({ trace_task, p_post->p_trace }, 0);
+}
+
+struct Timer_post
+{
+    Scheduler* p_scheduler = nullptr;
+    Trace* p_trace         = nullptr;
+};
+
+void timer_post_handler(void* a_p_user_data)
+{
+    Timer_post* p_post = static_cast<Timer_post*>(a_p_user_data);
+    p_post->p_scheduler->post({ trace_task, p_post->p_trace }, 0);
+}
+
+// producer in the top byte, its sequence number below
+uint32_t next_expected[4] = { 0 };
+uint32_t out_of_order     = 0;
+
+void sequence_task(void* a_p_user_data)
+{
+    const uint32_t value    = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(a_p_user_data));
+    const uint32_t producer = value >> 24u;
+
+    out_of_order += next_expected[producer] != (value & 0xFFFFFFu) ? 1u : 0u;
+    next_expected[producer] = (value & 0xFFFFFFu) + 1u;
+}
+
+} // namespace ::
+
+TEST_CASE("Scheduler dispatches by priority, then in posting order", "[Scheduler]")
+{
+    Scheduler scheduler;
+    std::string order;
+
+    Trace low_1{ &order, 'a' };
+    Trace low_2{ &order, 'b' };
+    Trace high{ &order, 'c' };
+
+    REQUIRE(true == scheduler.post({ trace_task, &low_1 }, Scheduler::priorities - 1u));
+    REQUIRE(true == scheduler.post({ trace_task, &low_2 }, Scheduler::priorities - 1u));
+    REQUIRE(true == scheduler.post({ trace_task, &high }, 0));
+
+    REQUIRE(true == scheduler.is_pending());
+
+    while (true == scheduler.dispatch());
+
+    REQUIRE(std::string("cab") == order);
+    REQUIRE(false == scheduler.is_pending());
+
+    for (uint32_t i = 0; i < cml::utils::config::scheduler::queue_capacity; i++)
+    {
+        REQUIRE(true == scheduler.post({ trace_task, &low_1 }, 1));
+    }
+
+    REQUIRE(false == scheduler.post({ trace_task, &low_1 }, 1));
+    REQUIRE(1u == scheduler.get_dropped_tasks());
+}
+
+TEST_CASE("Scheduler idles until an interrupt posts a task", "[Scheduler]")
+{
+    Scheduler scheduler;
+    std::string order;
+    Trace trace{ &order, 't' };
+    Tick_post post{ &scheduler, &trace };
+
+    systick::enable(1000u - 1u, 0x9u);
+    systick::register_tick_callback({ tick_handler, &post });
+
+    scheduler.idle();
+
+    REQUIRE(true == scheduler.dispatch());
+    REQUIRE(std::string("t") == order);
+
+    systick::unregister_tick_callback();
+    systick::disable();
+}
+
+TEST_CASE("Scheduler tickless idle sleeps up to the next timer expiry", "[Scheduler]")
+{
+    Scheduler scheduler;
+    Timer_service timer_service;
+    Timer_service::Timer timer;
+
+    std::string order;
+    Trace trace{ &order, 'x' };
+    Timer_post post{ &scheduler, &trace };
+
+    systick::enable(1000u - 1u, 0x9u);
+    systick::register_tick_callback({ Timer_service::tick_handler, &timer_service });
+
+    timer_service.start_one_shot(&timer, 10u, { timer_post_handler, &post });
+
+    // one sleep of 11 ticks - the timer fires at the last one and its task is pending on the wake-up
+    scheduler.idle(timer_service.get_ticks_to_next_expiry(1000u));
+
+    REQUIRE(11u == timer_service.get_ticks());
+    REQUIRE(true == scheduler.dispatch());
+    REQUIRE(std::string("x") == order);
+
+    // nothing armed - sleeps the whole limit
+    scheduler.idle(timer_service.get_ticks_to_next_expiry(50u));
+
+    REQUIRE(61u == timer_service.get_ticks());
+    REQUIRE(false == scheduler.is_pending());
+
+    systick::unregister_tick_callback();
+    systick::disable();
+}
+
+TEST_CASE("Scheduler keeps every task of concurrent producers", "[Scheduler]")
+{
+    constexpr uint32_t producers_count = 4u;
+    constexpr uint32_t tasks_count     = 20000u;
+
+    Scheduler scheduler;
+    std::vector<std::thread> producers;
+
+    for (uint32_t producer = 0; producer < producers_count; producer++)
+    {
+        producers.emplace_back([&scheduler, producer]() {
+            for (uint32_t i = 0; i < tasks_count; i++)
+            {
+                void* p_value = reinterpret_cast<void*>(static_cast<uintptr_t>((producer << 24u) | i));
+
+                // full - retried until the consumer makes room
+                while (false == scheduler.post({ sequence_task, p_value }, 1))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    uint32_t dispatched = 0;
+
+    while (dispatched < producers_count * tasks_count)
+    {
+        if (true == scheduler.dispatch())
+        {
+            dispatched++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    REQUIRE(0u == out_of_order);
+    REQUIRE(false == scheduler.is_pending());
+
+    for (uint32_t producer = 0; producer < producers_count; producer++)
+    {
+        REQUIRE(tasks_count == next_expected[producer]);
+    }
+}
@@ -0,0 +1,185 @@
+/*
+    Name: Spsc_ring_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <thread>
+
+//cml
+#include <cml/collection/Spsc_ring.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml::collection;
+
+TEST_CASE("Spsc_ring empty and full boundaries", "[Spsc_ring]")
+{
+    uint32_t buffer[4];
+    Spsc_ring<uint32_t> ring(buffer, 4u);
+
+    uint32_t value = 0xFFu;
+
+    REQUIRE(true == ring.is_empty());
+    REQUIRE(false == ring.is_full());
+    REQUIRE(4u == ring.get_free_space());
+    REQUIRE(false == ring.pop(&value));
+    REQUIRE(0xFFu == value);
+
+    for (uint32_t i = 0; i < 4u; i++)
+    {
+        REQUIRE(true == ring.push(i));
+        REQUIRE(i + 1u == ring.get_length());
+    }
+
+    // the whole buffer is usable, no slot is kept free
+    REQUIRE(true == ring.is_full());
+    REQUIRE(0u == ring.get_free_space());
+    REQUIRE(false == ring.push(4u));
+    REQUIRE(4u == ring.get_length());
+
+    for (uint32_t i = 0; i < 4u; i++)
+    {
+        REQUIRE(true == ring.pop(&value));
+        REQUIRE(i == value);
+    }
+
+    REQUIRE(true == ring.is_empty());
+    REQUIRE(false == ring.pop(&value));
+
+    ring.push(7u);
+    ring.clear();
+
+    REQUIRE(true == ring.is_empty());
+    REQUIRE(4u == ring.get_free_space());
+}
+
+TEST_CASE("Spsc_ring bulk push and pop stop at the boundaries", "[Spsc_ring]")
+{
+    uint32_t buffer[8];
+    Spsc_ring<uint32_t> ring(buffer, 8u);
+
+    const uint32_t in[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    uint32_t out[10]      = { 0 };
+
+    REQUIRE(0u == ring.pop(out, 10u));
+
+    REQUIRE(5u == ring.push(in, 5u));
+    REQUIRE(3u == ring.push(in + 5, 10u));
+    REQUIRE(true == ring.is_full());
+    REQUIRE(0u == ring.push(in, 1u));
+
+    REQUIRE(8u == ring.pop(out, 10u));
+    REQUIRE(true == ring.is_empty());
+
+    for (uint32_t i = 0; i < 8u; i++)
+    {
+        REQUIRE(i == out[i]);
+    }
+}
+
+TEST_CASE("Spsc_ring keeps the order across the end of the buffer", "[Spsc_ring]")
+{
+    uint32_t buffer[4];
+    Spsc_ring<uint32_t> ring(buffer, 4u);
+
+    uint32_t next_in  = 0;
+    uint32_t next_out = 0;
+
+    // 3 in, 2 out a round - the indices pass the end of the buffer at every offset, single and bulk
+    for (uint32_t round = 0; round < 64u; round++)
+    {
+        ring.clear();
+        next_out = next_in;
+
+        for (uint32_t i = 0; i < 3u; i++)
+        {
+            REQUIRE(true == ring.push(next_in++));
+        }
+
+        uint32_t value = 0;
+
+        REQUIRE(true == ring.pop(&value));
+        REQUIRE(next_out++ == value);
+
+        uint32_t values[2]   = { 0 };
+        const uint32_t in[2] = { next_in, next_in + 1u };
+
+        REQUIRE(2u == ring.push(in, 2u));
+        next_in += 2u;
+
+        REQUIRE(true == ring.is_full());
+
+        REQUIRE(2u == ring.pop(values, 2u));
+        REQUIRE(next_out++ == values[0]);
+        REQUIRE(next_out++ == values[1]);
+
+        REQUIRE(2u == ring.get_length());
+    }
+}
+
+TEST_CASE("Spsc_ring moves every element between a producer and a consumer thread", "[Spsc_ring]")
+{
+    constexpr uint32_t count = 1000000u;
+
+    uint32_t buffer[64];
+    Spsc_ring<uint32_t> ring(buffer, 64u);
+
+    std::thread producer([&]() {
+        uint32_t next = 0;
+        uint32_t chunk[5];
+
+        while (next < count)
+        {
+            // single and bulk pushes in turn
+            if (0 == (next & 0x1u))
+            {
+                if (true == ring.push(next))
+                {
+                    next++;
+                }
+            }
+            else
+            {
+                const uint32_t size = count - next < 5u ? count - next : 5u;
+
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    chunk[i] = next + i;
+                }
+
+                next += ring.push(chunk, size);
+            }
+        }
+    });
+
+    uint32_t expected   = 0;
+    uint32_t mismatches = 0;
+    uint32_t chunk[7];
+
+    while (expected < count)
+    {
+        uint32_t value = 0;
+
+        if (true == ring.pop(&value))
+        {
+            mismatches += expected++ != value ? 1u : 0u;
+        }
+
+        const uint32_t popped = ring.pop(chunk, 7u);
+
+        for (uint32_t i = 0; i < popped; i++)
+        {
+            mismatches += expected++ != chunk[i] ? 1u : 0u;
+        }
+    }
+
+    producer.join();
+
+    REQUIRE(0u == mismatches);
+    REQUIRE(count == expected);
+    REQUIRE(true == ring.is_empty());
+}
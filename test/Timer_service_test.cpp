@@ -0,0 +1,213 @@
+/*
+    Name: Timer_service_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <random>
+#include <vector>
+
+//cml
+#include <cml/utils/Timer_service.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml;
+using namespace cml::utils;
+
+namespace {
+
+struct Expiry
+{
+    Timer_service* p_service = nullptr;
+    uint32_t count           = 0;
+    time::tick last          = 0;
+};
+
+void expiry_handler(void* a_p_user_data)
+{
+    Expiry* p_expiry = static_cast<Expiry*>(a_p_user_data);
+
+    p_expiry->count++;
+    p_expiry->last = p_expiry->p_service->get_ticks() - 1u;
+}
+
+struct Linear_timer
+{
+    time::tick expires = 0;
+    time::tick period  = 0;
+};
+
+} // namespace ::
+
+TEST_CASE("Timer_service fires one-shot and periodic timers on time", "[Timer_service]")
+{
+    Timer_service service;
+
+    Timer_service::Timer one_shot;
+    Timer_service::Timer periodic;
+    Timer_service::Timer stopped;
+
+    Expiry one_shot_expiry{ &service };
+    Expiry periodic_expiry{ &service };
+    Expiry stopped_expiry{ &service };
+
+    service.start_one_shot(&one_shot, 100000u, { expiry_handler, &one_shot_expiry });
+    service.start_periodic(&periodic, 7u, { expiry_handler, &periodic_expiry });
+    service.start_one_shot(&stopped, 5u, { expiry_handler, &stopped_expiry });
+    service.stop(&stopped);
+
+    for (uint32_t i = 0; i <= 100000u; i++)
+    {
+        service.update();
+    }
+
+    REQUIRE(1u == one_shot_expiry.count);
+    REQUIRE(100000u == one_shot_expiry.last);
+    REQUIRE(false == one_shot.is_armed());
+
+    REQUIRE(100000u / 7u == periodic_expiry.count);
+    REQUIRE(100000u / 7u * 7u == periodic_expiry.last);
+    REQUIRE(true == periodic.is_armed());
+
+    REQUIRE(0u == stopped_expiry.count);
+}
+
+TEST_CASE("Timer_service matches exact expiry times across wheel levels", "[Timer_service]")
+{
+    constexpr uint32_t timers_count = 1000u;
+
+    Timer_service service;
+    std::vector<Timer_service::Timer> timers(timers_count);
+    std::vector<Expiry> expiries(timers_count, Expiry{ &service });
+    std::vector<time::tick> delays(timers_count);
+
+    std::mt19937 generator(12345u);
+    std::uniform_int_distribution<uint32_t> exponent(0u, 19u);
+
+    // a few ticks in so the wheel is not aligned to the start
+    for (uint32_t i = 0; i < 4321u; i++)
+    {
+        service.update();
+    }
+
+    const time::tick start = service.get_ticks();
+
+    for (uint32_t i = 0; i < timers_count; i++)
+    {
+        delays[i] = generator() % (1u << exponent(generator));
+        service.start_one_shot(&(timers[i]), delays[i], { expiry_handler, &(expiries[i]) });
+    }
+
+    for (uint32_t i = 0; i < (1u << 19u); i++)
+    {
+        service.update();
+    }
+
+    for (uint32_t i = 0; i < timers_count; i++)
+    {
+        REQUIRE(1u == expiries[i].count);
+        REQUIRE(start + delays[i] == expiries[i].last);
+    }
+}
+
+TEST_CASE("Timer_service update with thousands of armed timers", "[.][benchmark][Timer_service]")
+{
+    constexpr uint32_t timers_count = 4096u;
+
+    std::mt19937 generator(12345u);
+    std::vector<time::tick> periods(timers_count);
+
+    for (uint32_t i = 0; i < timers_count; i++)
+    {
+        periods[i] = 10u + generator() % 10000u;
+    }
+
+    Timer_service service;
+    std::vector<Timer_service::Timer> timers(timers_count);
+    std::vector<Expiry> expiries(timers_count, Expiry{ &service });
+
+    for (uint32_t i = 0; i < timers_count; i++)
+    {
+        service.start_periodic(&(timers[i]), periods[i], { expiry_handler, &(expiries[i]) });
+    }
+
+    std::vector<Linear_timer> linear_timers(timers_count);
+    std::vector<Expiry> linear_expiries(timers_count, Expiry{ &service });
+    time::tick linear_now = 0;
+
+    for (uint32_t i = 0; i < timers_count; i++)
+    {
+        linear_timers[i] = { periods[i], periods[i] };
+    }
+
+    BENCHMARK("Timer_service::update")
+    {
+        service.update();
+    };
+
+    // the hand-rolled alternative: compare every armed timer on each tick
+    BENCHMARK("linear scan")
+    {
+        for (uint32_t i = 0; i < timers_count; i++)
+        {
+            if (linear_now == linear_timers[i].expires)
+            {
+                linear_timers[i].expires += linear_timers[i].period;
+                expiry_handler(&(linear_expiries[i]));
+            }
+        }
+
+        linear_now++;
+    };
+}
+
+TEST_CASE("Timer_service reports the ticks to the next expiry", "[Timer_service]")
+{
+    Timer_service service;
+    Timer_service::Timer near;
+    Timer_service::Timer far;
+
+    Expiry near_expiry{ &service };
+    Expiry far_expiry{ &service };
+
+    REQUIRE(1000u == service.get_ticks_to_next_expiry(1000u));
+
+    for (uint32_t i = 0; i < 10u; i++)
+    {
+        service.update();
+    }
+
+    // exact within the lowest level: fires at the 6th update from here
+    service.start_one_shot(&near, 5u, { expiry_handler, &near_expiry });
+
+    REQUIRE(6u == service.get_ticks_to_next_expiry(1000u));
+    REQUIRE(3u == service.get_ticks_to_next_expiry(3u));
+
+    // further up - bounded by the refill of the lowest level at tick 64, 55 updates from here
+    service.start_one_shot(&far, 300u, { expiry_handler, &far_expiry });
+    service.stop(&near);
+
+    REQUIRE(55u == service.get_ticks_to_next_expiry(1000u));
+
+    // the bound never skips an expiry
+    while (0 == far_expiry.count)
+    {
+        const time::tick ticks = service.get_ticks_to_next_expiry(1000u);
+
+        for (time::tick i = 0; i + 1u < ticks; i++)
+        {
+            service.update();
+            REQUIRE(0 == far_expiry.count);
+        }
+
+        service.update();
+    }
+
+    REQUIRE(310u == far_expiry.last);
+    REQUIRE(0 == near_expiry.count);
+    REQUIRE(1000u == service.get_ticks_to_next_expiry(1000u));
+}
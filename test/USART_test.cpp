@@ -0,0 +1,140 @@
+/*
+    Name: USART_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <string>
+#include <unistd.h>
+
+//cml
+#include <cml/hal/counter.hpp>
+#include <cml/hal/systick.hpp>
+#include <cml/hal/peripherals/USART.hpp>
+#include <cml/utils/Buffered_USART.hpp>
+
+//soc
+#include <soc/host/simulation.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml;
+using namespace cml::hal;
+using namespace cml::hal::peripherals;
+using namespace cml::utils;
+using namespace soc::host;
+
+namespace {
+
+bool enable(USART* a_p_usart)
+{
+    return a_p_usart->enable({ 115200u,
+                               USART::Oversampling::_16,
+                               USART::Stop_bits::_1,
+                               USART::Flow_control_flag::none,
+                               USART::Sampling_method::three_sample_bit,
+                               USART::Mode_flag::tx | USART::Mode_flag::rx },
+                             { USART::Word_length::_8_bit, USART::Parity::none },
+                             { USART::Clock::Source::sysclk, MHz(80) },
+                             0x1u,
+                             10u);
+}
+
+std::string read_output(const USART& a_usart)
+{
+    std::string ret;
+    char buffer[64];
+    ssize_t length = 0;
+
+    while ((length = read(a_usart.get_host_output_fd(), buffer, sizeof(buffer))) > 0)
+    {
+        ret.append(buffer, static_cast<size_t>(length));
+    }
+
+    return ret;
+}
+
+} // namespace ::
+
+TEST_CASE("USART polling over the host pipes", "[USART]")
+{
+    // receive timeouts run on simulated time
+    systick::enable((80000000u / 1000u) - 1, 0x9u);
+    systick::register_tick_callback({ counter::update, nullptr });
+
+    USART usart(USART::Id::_2);
+    REQUIRE(true == enable(&usart));
+
+    const char message[] = "ping";
+    USART::Result result = usart.transmit_bytes_polling(message, 4);
+
+    REQUIRE(USART::Bus_status_flag::ok == result.bus_status);
+    REQUIRE(4 == result.data_length_in_words);
+    REQUIRE(std::string("ping") == read_output(usart));
+
+    REQUIRE(4 == write(usart.get_host_input_fd(), "pong", 4));
+
+    char received[4];
+    result = usart.receive_bytes_polling(received, sizeof(received), 10u);
+
+    REQUIRE(4 == result.data_length_in_words);
+    REQUIRE(std::string("pong") == std::string(received, sizeof(received)));
+
+    result = usart.receive_bytes_polling(received, sizeof(received), 10u);
+    REQUIRE(0 == result.data_length_in_words);
+
+    usart.inject_bus_status(USART::Bus_status_flag::framing_error);
+    result = usart.transmit_bytes_polling(message, 4);
+    REQUIRE(USART::Bus_status_flag::framing_error == result.bus_status);
+
+    systick::unregister_tick_callback();
+    systick::disable();
+}
+
+TEST_CASE("Buffered_USART moves data in the simulated interrupts", "[USART][Buffered_USART]")
+{
+    USART usart(USART::Id::_1);
+    REQUIRE(true == enable(&usart));
+
+    Buffered_USART buffered(&usart);
+    buffered.enable();
+
+    const std::string line(300, 'x');
+
+    // longer than the TX ring - the handler has to let the interrupts drain it
+    REQUIRE(line.length() == Buffered_USART::write_string_handler(line.c_str(), line.length(), &buffered));
+
+    while (true == buffered.is_transmit_pending())
+    {
+        simulation::run_interrupts();
+    }
+
+    REQUIRE(line == read_output(usart));
+
+    REQUIRE(5 == write(usart.get_host_input_fd(), "hello", 5));
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        simulation::run_interrupts();
+    }
+
+    char received[8];
+    REQUIRE(5 == buffered.read(received, sizeof(received)));
+    REQUIRE(std::string("hello") == std::string(received, 5));
+    REQUIRE(false == buffered.is_rx_overflow());
+}
+
+TEST_CASE("USART_t is a USART of a fixed instance", "[USART]")
+{
+    USART_t<USART::Id::_3> usart;
+
+    REQUIRE(USART::Id::_3 == usart.get_id());
+    REQUIRE(true == enable(&usart));
+
+    const char message[] = "fixed";
+    REQUIRE(5 == usart.transmit_bytes_polling(message, 5).data_length_in_words);
+    REQUIRE(std::string("fixed") == read_output(usart));
+}
@@ -0,0 +1,79 @@
+/*
+    Name: atomic_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <thread>
+#include <vector>
+
+//cml
+#include <cml/atomic.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml;
+
+TEST_CASE("atomic read-modify-write operations return the previous value", "[atomic]")
+{
+    atomic<uint32_t> value(10u);
+
+    REQUIRE(10u == value.load(Memory_order::relaxed));
+    REQUIRE(10u == value.fetch_add(5u));
+    REQUIRE(15u == value.fetch_sub(3u, Memory_order::acq_rel));
+    REQUIRE(12u == value.fetch_or(0x100u, Memory_order::release));
+    REQUIRE(0x10Cu == value.fetch_and(0xFu, Memory_order::acquire));
+    REQUIRE(0xCu == value.exchange(7u));
+
+    value.store(0u, Memory_order::release);
+    REQUIRE(0u == value.load(Memory_order::acquire));
+}
+
+TEST_CASE("atomic compare_exchange stores only on a match", "[atomic]")
+{
+    int32_t items[2] = { 0, 0 };
+    atomic<int32_t*> p_item(&(items[0]));
+
+    int32_t* p_expected = &(items[1]);
+
+    REQUIRE(false == p_item.compare_exchange(&p_expected, nullptr));
+    REQUIRE(&(items[0]) == p_expected);
+    REQUIRE(&(items[0]) == p_item.load());
+
+    REQUIRE(true == p_item.compare_exchange(&p_expected, &(items[1]), Memory_order::acq_rel));
+    REQUIRE(&(items[1]) == p_item.load());
+}
+
+TEST_CASE("atomic fetch_add and compare_exchange loops do not lose updates", "[atomic]")
+{
+    constexpr uint32_t threads_count = 4u;
+    constexpr uint32_t iterations    = 100000u;
+
+    atomic<uint32_t> added;
+    atomic<uint32_t> exchanged;
+    std::vector<std::thread> threads;
+
+    for (uint32_t i = 0; i < threads_count; i++)
+    {
+        threads.emplace_back([&]() {
+            for (uint32_t j = 0; j < iterations; j++)
+            {
+                added.fetch_add(1u, Memory_order::relaxed);
+
+                uint32_t expected = exchanged.load(Memory_order::relaxed);
+                while (false == exchanged.compare_exchange(&expected, expected + 1u, Memory_order::acq_rel));
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(threads_count * iterations == added.load());
+    REQUIRE(threads_count * iterations == exchanged.load());
+}
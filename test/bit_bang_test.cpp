@@ -0,0 +1,218 @@
+/*
+    Name: bit_bang_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <vector>
+
+//cml
+#include <cml/hal/bit_bang.hpp>
+
+//soc
+#include <soc/host/simulation.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml;
+using namespace cml::hal;
+using namespace cml::hal::bit_bang;
+using namespace cml::hal::peripherals;
+using namespace soc::host;
+
+namespace {
+
+struct Edge
+{
+    uint32_t pin   = 0;
+    uint64_t cycle = 0;
+    bool high      = false;
+    bool masked    = false;
+};
+
+std::vector<Edge> edges;
+
+// levels the next 'get_level' calls return, the line idles high once they run out
+std::vector<bool> input_levels;
+
+template<uint32_t pin_t> struct Probe_pin
+{
+    static void set_high()
+    {
+        edges.push_back({ pin_t, simulation::get_cycles(), true, 0 != simulation::get_primask() });
+    }
+
+    static void set_low()
+    {
+        edges.push_back({ pin_t, simulation::get_cycles(), false, 0 != simulation::get_primask() });
+    }
+
+    static pin::Level get_level()
+    {
+        if (true == input_levels.empty())
+        {
+            return pin::Level::high;
+        }
+
+        const bool high = input_levels.front();
+        input_levels.erase(input_levels.begin());
+
+        return true == high ? pin::Level::high : pin::Level::low;
+    }
+};
+
+void start()
+{
+    edges.clear();
+    input_levels.clear();
+}
+
+void script_input(uint8_t a_byte, bool a_msb_first)
+{
+    for (uint32_t i = 0; i < 8u; i++)
+    {
+        input_levels.push_back(0 != (a_byte & (true == a_msb_first ? 0x80u >> i : 0x1u << i)));
+    }
+}
+
+} // namespace ::
+
+TEST_CASE("Nrz_led pulse widths follow the bits", "[bit_bang]")
+{
+    using Led = Nrz_led<Probe_pin<0>>;
+
+    constexpr Led::Timing timing = Led::ws2812(80000000u);
+
+    static_assert(32u == timing.t0h && 68u == timing.t0l && 64u == timing.t1h && 36u == timing.t1l);
+
+    start();
+
+    const uint8_t data[] = { 0xA0u };
+    Led(timing).write(data, 1u);
+
+    REQUIRE(16u == edges.size());
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        const bool one = i == 0 || i == 2;
+
+        REQUIRE(true == edges[i * 2].high);
+        REQUIRE(true == edges[i * 2].masked);
+        REQUIRE((true == one ? timing.t1h : timing.t0h) == edges[i * 2 + 1].cycle - edges[i * 2].cycle);
+
+        if (i < 7)
+        {
+            REQUIRE((true == one ? timing.t1l : timing.t0l) == edges[i * 2 + 2].cycle - edges[i * 2 + 1].cycle);
+        }
+    }
+
+    const uint64_t frame_end = simulation::get_cycles();
+    REQUIRE(timing.t0l + timing.reset == frame_end - edges.back().cycle);
+    REQUIRE(0u == simulation::get_primask());
+}
+
+TEST_CASE("One_wire reset, write and read slots", "[bit_bang]")
+{
+    using Bus = One_wire<Probe_pin<0>>;
+
+    const Bus::Timing timing = Bus::standard_speed(1000000u);
+    const Bus bus(timing);
+
+    start();
+
+    input_levels.push_back(false);
+    REQUIRE(true == bus.reset());
+
+    REQUIRE(2u == edges.size());
+    REQUIRE(480u == edges[1].cycle - edges[0].cycle);
+    REQUIRE(false == edges[0].masked);
+    REQUIRE(true == edges[1].masked);
+
+    start();
+    REQUIRE(false == bus.reset());
+
+    start();
+
+    const uint8_t command = 0x01u;
+    bus.write(&command, 1u);
+
+    REQUIRE(16u == edges.size());
+    REQUIRE(6u == edges[1].cycle - edges[0].cycle);
+    REQUIRE(64u == edges[2].cycle - edges[1].cycle);
+    REQUIRE(60u == edges[3].cycle - edges[2].cycle);
+    REQUIRE(10u == edges[4].cycle - edges[3].cycle);
+
+    start();
+
+    script_input(0x5Au, false);
+
+    uint8_t byte = 0;
+    bus.read(&byte, 1u);
+
+    REQUIRE(0x5Au == byte);
+    REQUIRE(6u == edges[1].cycle - edges[0].cycle);
+    REQUIRE(70u == edges[2].cycle - edges[0].cycle);
+}
+
+TEST_CASE("Spi shifts MSB first on the edges of its mode", "[bit_bang]")
+{
+    using Sck  = Probe_pin<0>;
+    using Mosi = Probe_pin<1>;
+    using Miso = Probe_pin<2>;
+
+    start();
+    script_input(0x3Cu, true);
+
+    const uint8_t tx = 0xA5u;
+    uint8_t rx       = 0;
+
+    Spi<Sck, Mosi, Miso>(Spi<Sck, Mosi, Miso>::Mode::_0, 10u).transfer(&tx, &rx, 1u);
+
+    REQUIRE(0x3Cu == rx);
+
+    bool mosi          = false;
+    uint8_t sampled    = 0;
+    uint32_t sck_edges = 0;
+    uint64_t last_sck  = 0;
+
+    for (const Edge& edge : edges)
+    {
+        REQUIRE(false == edge.masked);
+
+        if (1u == edge.pin)
+        {
+            mosi = edge.high;
+        }
+        else if (0u == edge.pin)
+        {
+            if (sck_edges > 1)
+            {
+                REQUIRE(10u == edge.cycle - last_sck);
+            }
+
+            // idle level first, then rising (sampling) and falling edges
+            if (true == edge.high)
+            {
+                sampled = static_cast<uint8_t>((sampled << 1u) | (true == mosi ? 1u : 0u));
+            }
+
+            last_sck = edge.cycle;
+            sck_edges++;
+        }
+    }
+
+    REQUIRE(17u == sck_edges);
+    REQUIRE(0xA5u == sampled);
+
+    start();
+
+    Spi<Sck, Mosi>(Spi<Sck, Mosi>::Mode::_3, 10u).transfer(&tx, nullptr, 1u);
+
+    // idles high, the data goes out on the falling edge
+    REQUIRE(true == edges[0].high);
+    REQUIRE(false == edges[1].high);
+    REQUIRE(1u == edges[2].pin);
+}
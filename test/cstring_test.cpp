@@ -0,0 +1,285 @@
+/*
+    Name: cstring_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+//cml
+#include <cml/common/cstring.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml::common;
+
+namespace {
+
+uint32_t append(const char* a_p_data, uint32_t a_length, void* a_p_user_data)
+{
+    static_cast<std::string*>(a_p_user_data)->append(a_p_data, a_length);
+    return a_length;
+}
+
+std::string printf_fixed(double a_value, uint32_t a_precision)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", static_cast<int>(a_precision), a_value);
+
+    return buffer;
+}
+
+std::string format_fixed(float a_value, uint32_t a_precision)
+{
+    char format[] = "%.0f";
+    char buffer[64];
+
+    format[2] = static_cast<char>('0' + a_precision);
+    cstring::format(buffer, sizeof(buffer), format, a_value);
+
+    return buffer;
+}
+
+// CML_FORMAT needs a literal, one per precision
+std::string format_fixed_static(float a_value, uint32_t a_precision)
+{
+    char buffer[64];
+
+    switch (a_precision)
+    {
+        case 0: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.0f"), a_value); break;
+        case 1: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.1f"), a_value); break;
+        case 2: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.2f"), a_value); break;
+        case 3: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.3f"), a_value); break;
+        case 4: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.4f"), a_value); break;
+        case 5: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.5f"), a_value); break;
+        case 6: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.6f"), a_value); break;
+        case 7: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.7f"), a_value); break;
+        case 8: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.8f"), a_value); break;
+        case 9: cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.9f"), a_value); break;
+    }
+
+    return buffer;
+}
+
+void require_fixed_as_printf(float a_value)
+{
+    for (uint32_t precision = 0; precision <= cstring::format_max_precision; precision++)
+    {
+        INFO(std::hexfloat << a_value << " precision " << precision);
+
+        const std::string expected = printf_fixed(a_value, precision);
+
+        REQUIRE(expected == format_fixed(a_value, precision));
+        REQUIRE(expected == format_fixed_static(a_value, precision));
+    }
+}
+
+} // namespace ::
+
+TEST_CASE("cstring::format runtime and compile time format strings", "[cstring]")
+{
+    char buffer[64];
+
+    REQUIRE(20 == cstring::format(buffer, sizeof(buffer), "a=%u b=%d c=%c s=%s", 12u, -34, 'x', "str"));
+    REQUIRE(std::string("a=12 b=-34 c=x s=str") == buffer);
+
+    REQUIRE(20 == cstring::format(buffer, sizeof(buffer), CML_FORMAT("a=%u b=%d c=%c s=%s"), 12u, -34, 'x', "str"));
+    REQUIRE(std::string("a=12 b=-34 c=x s=str") == buffer);
+
+    REQUIRE(7 == cstring::format(buffer, 8, CML_FORMAT("truncate %u"), 123456u));
+    REQUIRE(std::string("truncat") == buffer);
+}
+
+TEST_CASE("cstring::format integers match printf", "[cstring]")
+{
+    std::vector<uint32_t> values = { 0u, 1u, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu };
+
+    // both sides of every decimal and hex digit count
+    for (uint64_t power = 10u; power <= 0xFFFFFFFFu; power *= 10u)
+    {
+        values.push_back(static_cast<uint32_t>(power - 1u));
+        values.push_back(static_cast<uint32_t>(power));
+    }
+
+    for (uint32_t shift = 4u; shift < 32u; shift += 4u)
+    {
+        values.push_back((0x1u << shift) - 1u);
+        values.push_back(0x1u << shift);
+    }
+
+    for (uint32_t value : values)
+    {
+        const int32_t signed_values[] = { static_cast<int32_t>(value), static_cast<int32_t>(0u - value) };
+
+        char expected[64];
+        char buffer[64];
+
+        INFO(value);
+
+        std::snprintf(expected, sizeof(expected), "%u %x", value, value);
+
+        cstring::format(buffer, sizeof(buffer), "%u %x", value, value);
+        REQUIRE(std::string(expected) == buffer);
+
+        cstring::format(buffer, sizeof(buffer), CML_FORMAT("%u %x"), value, value);
+        REQUIRE(std::string(expected) == buffer);
+
+        std::snprintf(expected, sizeof(expected), "%o", value);
+        cstring::from_unsigned_integer(value, buffer, sizeof(buffer), cstring::Radix::oct);
+        REQUIRE(std::string(expected) == buffer);
+
+        for (int32_t signed_value : signed_values)
+        {
+            std::snprintf(expected, sizeof(expected), "%d %i", signed_value, signed_value);
+
+            cstring::format(buffer, sizeof(buffer), "%d %i", signed_value, signed_value);
+            REQUIRE(std::string(expected) == buffer);
+
+            cstring::format(buffer, sizeof(buffer), CML_FORMAT("%d %i"), signed_value, signed_value);
+            REQUIRE(std::string(expected) == buffer);
+        }
+    }
+
+    // 64-bit values go through from_unsigned_integer_dec directly
+    const uint64_t wide_values[] = { 0x100000000ull, 9999999999999999999ull, 10000000000000000000ull,
+                                     0xFFFFFFFFFFFFFFFFull };
+
+    for (uint64_t value : wide_values)
+    {
+        char expected[64];
+        char buffer[64];
+
+        std::snprintf(expected, sizeof(expected), "%llu", static_cast<unsigned long long>(value));
+        cstring::from_unsigned_integer_dec(value, buffer, sizeof(buffer));
+
+        REQUIRE(std::string(expected) == buffer);
+    }
+}
+
+TEST_CASE("cstring::format fixed point conversions", "[cstring]")
+{
+    char buffer[64];
+
+    cstring::format(buffer, sizeof(buffer), "%.3f %f %.0f", 3.14159f, -0.5f, 2.5f);
+    REQUIRE(std::string("3.142 -0.500000 2") == buffer);
+
+    cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.2q16"), 0x18000);
+    REQUIRE(std::string("1.50") == buffer);
+
+    // a precision on another conversion does not carry over to the next %f
+    cstring::format(buffer, sizeof(buffer), "%.3d %f", 7, 0.5f);
+    REQUIRE(std::string("7 0.500000") == buffer);
+
+    cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.3d %f"), 7, 0.5f);
+    REQUIRE(std::string("7 0.500000") == buffer);
+}
+
+TEST_CASE("cstring::format %f matches printf", "[cstring]")
+{
+    const float values[] =
+    {
+        0.0f, -0.0f, 1.0f, -1.0f, 3.14159f, -123.456f, 0.1f, 2.675f,
+
+        // exact halves at every precision - round half to even
+        0.5f, 1.5f, 2.5f, -0.5f, -2.5f, 0.125f, 0.375f, -0.625f, 0.0625f, 1.0f / 1024.0f, 5e-10f,
+
+        // tiny and denormal
+        1e-10f, -1e-10f, std::numeric_limits<float>::min(), std::numeric_limits<float>::denorm_min(), 1e-39f,
+
+        // large, up to the last float below 2^64
+        16777216.0f, 4294967295.0f, 4294967296.0f, 1e10f, -1e18f, std::nextafter(18446744073709551616.0f, 0.0f),
+
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+
+    for (float value : values)
+    {
+        require_fixed_as_printf(value);
+    }
+
+    // every exponent below 2^64
+    std::mt19937 generator(12345u);
+
+    for (uint32_t i = 0; i < 2000u; i++)
+    {
+        const uint32_t bits = generator();
+
+        if (((bits >> 23u) & 0xFFu) < 127u + 64u)
+        {
+            float value = 0.0f;
+            memory::copy(&value, sizeof(value), &bits, sizeof(bits));
+
+            require_fixed_as_printf(value);
+        }
+    }
+}
+
+TEST_CASE("cstring::format %q matches printf of the value as double", "[cstring]")
+{
+    const int32_t values[] =
+    {
+        0, 1, -1, 2, -2, 3, 0x18000, -0x18000, 0x7FFFFFFF, INT32_MIN, 0x40000000, -0x40000000, 0x12345678, -0x12345678
+    };
+
+    std::mt19937 generator(54321u);
+
+    for (uint32_t fraction_bits = 1; fraction_bits < 32u; fraction_bits++)
+    {
+        std::vector<int32_t> samples(std::begin(values), std::end(values));
+
+        // +-0.5 and +-1.5 (wrapped for q31) - ties at precision 0, then random values
+        for (uint32_t half : { 0x1u << (fraction_bits - 1u), 0x3u << (fraction_bits - 1u) })
+        {
+            samples.push_back(static_cast<int32_t>(half));
+            samples.push_back(static_cast<int32_t>(0u - half));
+        }
+
+        for (uint32_t i = 0; i < 64u; i++)
+        {
+            samples.push_back(static_cast<int32_t>(generator()));
+        }
+
+        for (int32_t value : samples)
+        {
+            const double reference = std::ldexp(static_cast<double>(value), -static_cast<int32_t>(fraction_bits));
+
+            for (uint32_t precision = 0; precision <= cstring::format_max_precision; precision++)
+            {
+                INFO(value << " q" << fraction_bits << " precision " << precision);
+
+                char buffer[cstring::format_number_buffer_capacity];
+                cstring::from_fixed_point(value, fraction_bits, buffer, sizeof(buffer), precision);
+
+                REQUIRE(printf_fixed(reference, precision) == buffer);
+            }
+        }
+    }
+
+    char buffer[64];
+
+    cstring::format(buffer, sizeof(buffer), "%.3q16 %q15 %.0q", -0x18000, 0x4000, 0x40000000);
+    REQUIRE(printf_fixed(-1.5, 3) + " " + printf_fixed(0.5, 6) + " " + printf_fixed(0.5, 0) == buffer);
+
+    cstring::format(buffer, sizeof(buffer), CML_FORMAT("%.3q16 %q15 %.9q31"), -0x18000, 0x4000, INT32_MIN);
+    REQUIRE(printf_fixed(-1.5, 3) + " " + printf_fixed(0.5, 6) + " " + printf_fixed(-1.0, 9) == buffer);
+}
+
+TEST_CASE("cstring::format_to streams to a sink", "[cstring]")
+{
+    std::string output;
+
+    const uint32_t length = cstring::format_to({ append, &output }, CML_FORMAT("%s: %u%%"), "load", 42u);
+
+    REQUIRE(std::string("load: 42%") == output);
+    REQUIRE(output.length() == length);
+}
@@ -0,0 +1,68 @@
+/*
+    Name: latency_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#include <cml/debug/latency.hpp>
+#include <cml/hal/systick.hpp>
+
+//soc
+#include <soc/host/simulation.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml::debug;
+using namespace cml::hal;
+
+TEST_CASE("latency summarize reports nearest-rank percentiles and jitter", "[latency]")
+{
+    uint32_t samples[200];
+
+    // 200, 199, ..., 1
+    for (uint32_t i = 0; i < 200u; i++)
+    {
+        samples[i] = 200u - i;
+    }
+
+    const latency::Summary summary = latency::summarize(samples, 200u);
+
+    REQUIRE(200u == summary.samples);
+    REQUIRE(1u == summary.min);
+    REQUIRE(100u == summary.p50);
+    REQUIRE(180u == summary.p90);
+    REQUIRE(198u == summary.p99);
+    REQUIRE(200u == summary.max);
+    REQUIRE(199u == summary.jitter);
+
+    for (uint32_t i = 0; i < 200u; i++)
+    {
+        REQUIRE(i + 1u == samples[i]);
+    }
+
+    uint32_t single = 42u;
+    const latency::Summary single_summary = latency::summarize(&single, 1u);
+
+    REQUIRE(42u == single_summary.p50);
+    REQUIRE(42u == single_summary.p99);
+    REQUIRE(0u == single_summary.jitter);
+}
+
+TEST_CASE("latency marks measure cycles between stages", "[latency]")
+{
+    systick::enable(1000u - 1u, 0x9u);
+
+    latency::mark(latency::Path::exti, latency::Stage::trigger);
+    soc::host::simulation::advance(2u);
+    latency::mark(latency::Path::exti, latency::Stage::vector);
+    soc::host::simulation::advance(1u);
+    latency::mark(latency::Path::exti, latency::Stage::callback);
+
+    REQUIRE(2000u == latency::get_cycles(latency::Path::exti, latency::Stage::trigger, latency::Stage::vector));
+    REQUIRE(3000u == latency::get_cycles(latency::Path::exti, latency::Stage::trigger, latency::Stage::callback));
+
+    systick::disable();
+}
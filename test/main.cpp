@@ -1,6 +1,5 @@
 
 //externals
-#include <gtest.h>
-
-
-
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_NO_POSIX_SIGNALS // Catch 2.12 alternate signal stack does not build with glibc >= 2.34
+#include "catch.hpp"
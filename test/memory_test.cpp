@@ -0,0 +1,214 @@
+/*
+    Name: memory_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <cstring>
+#include <string>
+
+//cml
+#include <cml/common/memory.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml::common;
+
+namespace {
+
+// offsets 0 - 7 from a word boundary on both sides, every length up to 64 (0 is asserted against)
+constexpr uint32_t max_offset      = 8u;
+constexpr uint32_t max_size        = 64u;
+constexpr uint32_t buffer_capacity = 2u * max_offset + max_size + 16u;
+
+struct alignas(4) Buffer
+{
+    uint8_t data[buffer_capacity];
+};
+
+void fill_pattern(Buffer* a_p_buffer, uint8_t a_seed)
+{
+    for (uint32_t i = 0; i < buffer_capacity; i++)
+    {
+        a_p_buffer->data[i] = static_cast<uint8_t>(a_seed + i * 7u);
+    }
+}
+
+// the byte-by-byte routine the word paths replaced, kept from being turned into a memcpy call
+__attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+void copy_bytes(uint8_t* a_p_destination, const uint8_t* a_p_source, uint32_t a_size_in_bytes)
+{
+    while (0 != (a_size_in_bytes--))
+    {
+        *(a_p_destination++) = *(a_p_source++);
+    }
+}
+
+} // namespace ::
+
+TEST_CASE("memory::copy matches memcpy", "[memory]")
+{
+    for (uint32_t source_offset = 0; source_offset < max_offset; source_offset++)
+    {
+        for (uint32_t destination_offset = 0; destination_offset < max_offset; destination_offset++)
+        {
+            for (uint32_t size = 1; size <= max_size; size++)
+            {
+                Buffer source;
+                Buffer destination;
+                Buffer expected;
+
+                fill_pattern(&source, 0x11u);
+                std::memset(destination.data, 0xAA, buffer_capacity);
+                std::memset(expected.data, 0xAA, buffer_capacity);
+
+                std::memcpy(expected.data + destination_offset, source.data + source_offset, size);
+
+                REQUIRE(size == memory::copy(destination.data + destination_offset,
+                                             size,
+                                             source.data + source_offset,
+                                             size));
+                REQUIRE(0 == std::memcmp(destination.data, expected.data, buffer_capacity));
+            }
+        }
+    }
+}
+
+TEST_CASE("memory::copy stops at the destination capacity", "[memory]")
+{
+    Buffer source;
+    Buffer destination;
+
+    fill_pattern(&source, 0x22u);
+    std::memset(destination.data, 0xAA, buffer_capacity);
+
+    REQUIRE(21u == memory::copy(destination.data + 1, 21u, source.data + 1, 40u));
+    REQUIRE(0 == std::memcmp(destination.data + 1, source.data + 1, 21u));
+    REQUIRE(0xAAu == destination.data[22]);
+}
+
+TEST_CASE("memory::move matches memmove on overlapping ranges", "[memory]")
+{
+    // both ranges in one buffer, the source before and after the destination, up to two words apart
+    for (uint32_t source_offset = 0; source_offset < 2u * max_offset; source_offset++)
+    {
+        for (uint32_t destination_offset = 0; destination_offset < 2u * max_offset; destination_offset++)
+        {
+            for (uint32_t size = 1; size <= max_size; size++)
+            {
+                Buffer buffer;
+                Buffer expected;
+
+                fill_pattern(&buffer, 0x33u);
+                fill_pattern(&expected, 0x33u);
+
+                std::memmove(expected.data + destination_offset, expected.data + source_offset, size);
+                memory::move(buffer.data + destination_offset, buffer.data + source_offset, size);
+
+                REQUIRE(0 == std::memcmp(buffer.data, expected.data, buffer_capacity));
+            }
+        }
+    }
+}
+
+TEST_CASE("memory::set and memory::clear match memset", "[memory]")
+{
+    for (uint32_t offset = 0; offset < max_offset; offset++)
+    {
+        for (uint32_t size = 1; size <= max_size; size++)
+        {
+            Buffer buffer;
+            Buffer expected;
+
+            fill_pattern(&buffer, 0x44u);
+            fill_pattern(&expected, 0x44u);
+
+            std::memset(expected.data + offset, 0x5C, size);
+            memory::set(buffer.data + offset, 0x5Cu, size);
+
+            REQUIRE(0 == std::memcmp(buffer.data, expected.data, buffer_capacity));
+
+            std::memset(expected.data + offset, 0x0, size);
+            memory::clear(buffer.data + offset, size);
+
+            REQUIRE(0 == std::memcmp(buffer.data, expected.data, buffer_capacity));
+        }
+    }
+}
+
+TEST_CASE("memory::equals matches memcmp", "[memory]")
+{
+    for (uint32_t first_offset = 0; first_offset < max_offset; first_offset++)
+    {
+        for (uint32_t second_offset = 0; second_offset < max_offset; second_offset++)
+        {
+            for (uint32_t size = 1; size <= max_size; size++)
+            {
+                Buffer first;
+                Buffer second;
+
+                fill_pattern(&first, 0x55u);
+                std::memset(second.data, 0xAA, buffer_capacity);
+                std::memcpy(second.data + second_offset, first.data + first_offset, size);
+
+                REQUIRE(true == memory::equals(first.data + first_offset, second.data + second_offset, size));
+
+                // one differing byte in the head, the words and the tail in turn
+                for (uint32_t i = 0; i < size; i++)
+                {
+                    second.data[second_offset + i] ^= 0x80u;
+
+                    REQUIRE(false == memory::equals(first.data + first_offset, second.data + second_offset, size));
+                    REQUIRE(0 != std::memcmp(first.data + first_offset, second.data + second_offset, size));
+
+                    second.data[second_offset + i] ^= 0x80u;
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("memory byte and word paths", "[.][benchmark][memory]")
+{
+    // host numbers only - the LDM / STM bursts are built for the Cortex-M4 alone
+    constexpr uint32_t sizes[] = { 16u, 256u, 4096u };
+
+    alignas(4) static uint8_t source[4096u + 8u];
+    alignas(4) static uint8_t destination[4096u + 8u];
+
+    for (uint32_t size : sizes)
+    {
+        const std::string suffix = " " + std::to_string(size) + " B";
+
+        BENCHMARK("bytes" + suffix)
+        {
+            copy_bytes(destination, source, size);
+            return destination[0];
+        };
+
+        BENCHMARK("memory::copy aligned" + suffix)
+        {
+            return memory::copy(destination, size, source, size);
+        };
+
+        BENCHMARK("memory::copy same head" + suffix)
+        {
+            return memory::copy(destination + 3, size, source + 3, size);
+        };
+
+        // source and destination apart by a byte - no word path exists
+        BENCHMARK("memory::copy misaligned" + suffix)
+        {
+            return memory::copy(destination + 1, size, source, size);
+        };
+
+        BENCHMARK("memory::set aligned" + suffix)
+        {
+            memory::set(destination, 0x5Cu, size);
+            return destination[0];
+        };
+    }
+}
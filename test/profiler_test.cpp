@@ -0,0 +1,126 @@
+/*
+    Name: profiler_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//std
+#include <string>
+
+//cml
+#include <cml/debug/profiler.hpp>
+#include <cml/hal/systick.hpp>
+
+//soc
+#include <soc/host/simulation.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml;
+using namespace cml::debug;
+using namespace cml::hal;
+using namespace cml::utils;
+
+namespace {
+
+uint32_t write_character(char a_character, void* a_p_user_data)
+{
+    static_cast<std::string*>(a_p_user_data)->push_back(a_character);
+    return 1;
+}
+
+uint32_t write_string(const char* a_p_string, uint32_t a_length, void* a_p_user_data)
+{
+    static_cast<std::string*>(a_p_user_data)->append(a_p_string, a_length);
+    return a_length;
+}
+
+uint32_t read_character(char*, uint32_t, void*)
+{
+    return 0;
+}
+
+const profiler::Zone* find_zone(const profiler::Zone* a_p_zone)
+{
+    for (uint32_t i = 0; i < profiler::get_zones_count(); i++)
+    {
+        if (a_p_zone == profiler::get_zone(i))
+        {
+            return a_p_zone;
+        }
+    }
+
+    return nullptr;
+}
+
+profiler::Zone record_zone("record");
+profiler::Zone scope_zone("scope");
+
+} // namespace ::
+
+TEST_CASE("profiler collects min, max, mean and a log2 histogram", "[profiler]")
+{
+    profiler::reset();
+
+    REQUIRE(nullptr == find_zone(&record_zone));
+
+    profiler::record(&record_zone, 0u);
+    profiler::record(&record_zone, 5u);
+    profiler::record(&record_zone, 7u);
+    profiler::record(&record_zone, 1000u);
+
+    REQUIRE(&record_zone == find_zone(&record_zone));
+    REQUIRE(4u == record_zone.count);
+    REQUIRE(0u == record_zone.min);
+    REQUIRE(1000u == record_zone.max);
+    REQUIRE(253u == record_zone.get_mean());
+    REQUIRE(1u == record_zone.histogram[0]);
+    REQUIRE(2u == record_zone.histogram[2]);
+    REQUIRE(1u == record_zone.histogram[9]);
+
+    std::string output;
+    Console console({ write_character, &output }, { write_string, &output }, { read_character, nullptr });
+
+    profiler::dump(&console);
+
+    REQUIRE(std::string::npos != output.find("record: 4 samples, cycles min 0, max 1000, mean 253\n"
+                                             "    2^0: 1\n"
+                                             "    2^2: 2\n"
+                                             "    2^9: 1\n"));
+
+    profiler::reset();
+
+    REQUIRE(0u == record_zone.count);
+    REQUIRE(0u == record_zone.histogram[2]);
+    REQUIRE(&record_zone == find_zone(&record_zone));
+}
+
+TEST_CASE("profiler scope measures core cycles", "[profiler]")
+{
+    systick::enable(1000u - 1u, 0x9u);
+
+    {
+        profiler::Scope scope(&scope_zone);
+        soc::host::simulation::advance(3u);
+    }
+
+    REQUIRE(1u == scope_zone.count);
+    REQUIRE(3000u == scope_zone.min);
+
+    std::string output;
+    Console console({ write_character, &output }, { write_string, &output }, { read_character, nullptr });
+
+    Command_line::Callback::Parameter params_buffer[2];
+    collection::Vector<Command_line::Callback::Parameter> params(params_buffer, 2u);
+
+    params.push_back({ "profiler", 8u });
+    params.push_back({ "reset", 5u });
+
+    profiler::command_line_callback(params, &console);
+
+    REQUIRE(0u == scope_zone.count);
+
+    systick::disable();
+}
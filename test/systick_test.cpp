@@ -0,0 +1,41 @@
+/*
+    Name: systick_test.cpp
+
+    Copyright(c) 2020 Mateusz Semegen
+    This code is licensed under MIT license (see LICENSE file for details)
+*/
+
+//cml
+#include <cml/hal/counter.hpp>
+#include <cml/hal/monotonic.hpp>
+#include <cml/hal/systick.hpp>
+
+//soc
+#include <soc/host/simulation.hpp>
+
+//externals
+#include "catch.hpp"
+
+using namespace cml::hal;
+using namespace soc::host;
+
+TEST_CASE("monotonic time follows systick and tickless sleep", "[systick][monotonic]")
+{
+    systick::enable(80000u - 1u, 0x9u);
+    systick::register_tick_callback({ counter::update, nullptr });
+    counter::reset();
+
+    simulation::advance(5);
+
+    REQUIRE(80000u == systick::get_tick_period());
+    REQUIRE(5u * 80000u == systick::get_cycles());
+    REQUIRE(5u == monotonic::get_ms());
+    REQUIRE(5000u == monotonic::get_us());
+
+    REQUIRE(10u == systick::sleep(10));
+    REQUIRE(15u == counter::get());
+    REQUIRE(15u == monotonic::get_ms());
+
+    systick::unregister_tick_callback();
+    systick::disable();
+}